@@ -0,0 +1,365 @@
+#include "allanVariance.hpp"
+#include "logStats.hpp"
+#include "workStealingPool.hpp"
+#include "dataProfile.hpp"
+#include "llaFromEcefSimd.hpp"
+#include <cmath>
+
+namespace {
+
+namespace portable {
+#include "allanVariance.inl"
+} // namespace portable
+
+} // namespace
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define ALLAN_SIMD_X86 1
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace {
+
+namespace avx2 {
+#include "allanVariance.inl"
+} // namespace avx2
+
+} // namespace
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+#endif
+
+namespace {
+
+// Tamanhos fixos de bloco: o resultado não depende do número de threads
+const size_t prefixBlock = 1 << 16;
+const size_t clusterBlock = 1 << 14;
+
+// Executa work(begin, end) para blocos de [0, count) no pool e espera todos
+template <typename Work>
+void forEachBlock(WorkStealingPool& pool, size_t count, size_t block, const Work& work) {
+    for (size_t begin = 0; begin < count; begin += block) {
+        size_t end = std::min(count, begin + block);
+        pool.submit([&work, begin, end]() { work(begin, end); });
+    }
+    pool.wait();
+}
+
+// Tamanhos de cluster avaliados sobre a soma acumulada dizimada por stride
+struct ClusterLevel {
+    size_t stride = 1;
+    std::vector<size_t> sizes; ///< Cluster sizes in decimated samples, ascending
+    std::vector<size_t> curveIndex; ///< Index of each size in the curve
+};
+
+// Mesma sequência de operações nos dois caminhos: resultados idênticos
+void clusterSums(const double* a, size_t m, size_t begin, size_t endHadamard, size_t endAllan,
+                 double& allanSum, double& hadamardSum) {
+#ifdef ALLAN_SIMD_X86
+    static const bool useAvx2 = detectSimdLevel() == SimdLevel::Avx2;
+    if (useAvx2) {
+        avx2::clusterSums(a, m, begin, endHadamard, endAllan, allanSum, hadamardSum);
+        return;
+    }
+#endif
+    portable::clusterSums(a, m, begin, endHadamard, endAllan, allanSum, hadamardSum);
+}
+
+// Tamanhos de cluster espaçados em log até numSamples / 2, agrupados por dizimação
+std::vector<ClusterLevel> clusterLevels(size_t numSamples, const AllanOptions& options, AllanCurve& curve) {
+    size_t maxSize = numSamples / 2;
+    double pointsPerDecade = std::max(1u, options.pointsPerDecade);
+    size_t overlaps = options.overlapsPerCluster;
+
+    std::vector<ClusterLevel> levels;
+    for (unsigned j = 0;; ++j) {
+        double size = std::pow(10.0, j / pointsPerDecade);
+        if (size > maxSize + 0.5) {
+            break;
+        }
+        size_t m = static_cast<size_t>(std::llround(size));
+        size_t stride = 1;
+        if (overlaps != 0) {
+            while (2 * stride * overlaps <= m) {
+                stride *= 2;
+            }
+        }
+        size_t decimated = (m + stride / 2) / stride;
+        if (decimated * stride > maxSize) {
+            --decimated;
+        }
+        if (overlaps != 0 && stride > 1 && decimated == 2 * overlaps) {
+            // Arredondado para o início do próximo nível
+            stride *= 2;
+            decimated = overlaps;
+        }
+        m = decimated * stride;
+        if (m == 0 || (!curve.clusterSize.empty() && m <= curve.clusterSize.back())) {
+            continue;
+        }
+
+        if (levels.empty() || levels.back().stride != stride) {
+            levels.emplace_back();
+            levels.back().stride = stride;
+        }
+        levels.back().sizes.push_back(decimated);
+        levels.back().curveIndex.push_back(curve.clusterSize.size());
+        curve.clusterSize.push_back(m);
+    }
+    return levels;
+}
+
+// Soma acumulada centrada: theta[k] = tau0 * sum_{i<k} (values[i] - mean)
+std::vector<double> centredPrefixSum(const double* values, size_t numSamples, double sampleInterval,
+                                     WorkStealingPool& pool) {
+    size_t numBlocks = (numSamples + prefixBlock - 1) / prefixBlock;
+    std::vector<double> blockSums(numBlocks);
+    forEachBlock(pool, numSamples, prefixBlock, [&](size_t begin, size_t end) {
+        double sum = 0.0;
+        for (size_t i = begin; i < end; ++i) {
+            sum += values[i];
+        }
+        blockSums[begin / prefixBlock] = sum;
+    });
+    double total = 0.0;
+    for (double sum : blockSums) {
+        total += sum;
+    }
+    double mean = total / numSamples;
+
+    // O deslocamento de cada bloco sai das somas já calculadas, então cada
+    // bloco escreve sua parte da soma acumulada independentemente
+    std::vector<double> offsets(numBlocks, 0.0);
+    for (size_t b = 1; b < numBlocks; ++b) {
+        offsets[b] = offsets[b - 1] + (blockSums[b - 1] - mean * prefixBlock) * sampleInterval;
+    }
+    std::vector<double> theta(numSamples + 1);
+    theta[0] = 0.0;
+    forEachBlock(pool, numSamples, prefixBlock, [&](size_t begin, size_t end) {
+        double sum = offsets[begin / prefixBlock];
+        for (size_t i = begin; i < end; ++i) {
+            sum += (values[i] - mean) * sampleInterval;
+            theta[i + 1] = sum;
+        }
+    });
+    return theta;
+}
+
+// Coeficiente ajustado como média geométrica de value(sigma, tau) nos pontos de inclinação próxima de slope
+NoiseFit fitSlope(const std::vector<double>& tau, const std::vector<double>& sigma, const std::vector<double>& slopes,
+                  size_t first, size_t last, double slope, double (*value)(double, double)) {
+    NoiseFit fit;
+    double sumValue = 0.0, sumTau = 0.0;
+    for (size_t i = first; i < last; ++i) {
+        if (std::abs(slopes[i] - slope) < 0.1) {
+            sumValue += std::log(value(sigma[i], tau[i]));
+            sumTau += std::log(tau[i]);
+            ++fit.numPoints;
+        }
+    }
+    if (fit.numPoints > 0) {
+        fit.value = std::exp(sumValue / fit.numPoints);
+        fit.tau = std::exp(sumTau / fit.numPoints);
+    }
+    return fit;
+}
+
+} // namespace
+
+AllanCurve computeAllanVariance(const double* values, size_t numSamples, double sampleInterval,
+                                const AllanOptions& options) {
+    if (numSamples < 3) {
+        throw std::invalid_argument("Allan variance needs at least 3 samples.");
+    }
+    if (!(sampleInterval > 0.0)) {
+        throw std::invalid_argument("Allan variance needs a positive sampling interval.");
+    }
+
+    AllanCurve curve;
+    curve.numSamples = numSamples;
+    curve.sampleInterval = sampleInterval;
+    std::vector<ClusterLevel> levels = clusterLevels(numSamples, options, curve);
+    size_t numPoints = curve.clusterSize.size();
+    curve.tau.resize(numPoints);
+    curve.allan.resize(numPoints);
+    curve.overlappingAllan.resize(numPoints);
+    curve.hadamard.resize(numPoints);
+    for (size_t p = 0; p < numPoints; ++p) {
+        curve.tau[p] = curve.clusterSize[p] * sampleInterval;
+    }
+
+    WorkStealingPool pool(options.numThreads);
+    DATA_PROFILE_SCOPE(prefix, "allan.prefix");
+    std::vector<double> theta = centredPrefixSum(values, numSamples, sampleInterval, pool);
+    DATA_PROFILE_ADD(prefix, numSamples, numSamples * sizeof(double));
+    DATA_PROFILE_STOP(prefix);
+
+    // Cada nível percorre sua soma dizimada uma vez por bloco, com todos os
+    // seus tamanhos de cluster enquanto o bloco está no cache
+    DATA_PROFILE_SCOPE(clusters, "allan.clusters");
+    std::vector<double> decimated;
+    size_t decimatedStride = 1;
+    for (const ClusterLevel& level : levels) {
+        if (level.stride != 1) {
+            const std::vector<double>& source = decimatedStride == 1 ? theta : decimated;
+            size_t step = level.stride / decimatedStride;
+            std::vector<double> next(numSamples / level.stride + 1);
+            forEachBlock(pool, next.size(), prefixBlock, [&](size_t begin, size_t end) {
+                for (size_t j = begin; j < end; ++j) {
+                    next[j] = source[j * step];
+                }
+            });
+            decimated.swap(next);
+            decimatedStride = level.stride;
+        }
+        const std::vector<double>& a = level.stride == 1 ? theta : decimated;
+        size_t length = a.size() - 1;
+        size_t numSizes = level.sizes.size();
+
+        size_t numStarts = length - 2 * level.sizes.front() + 1;
+        DATA_PROFILE_ADD(clusters, numStarts * numSizes, 0);
+        size_t numBlocks = (numStarts + clusterBlock - 1) / clusterBlock;
+        std::vector<double> sums(numBlocks * 3 * numSizes, 0.0);
+        forEachBlock(pool, numStarts, clusterBlock, [&](size_t begin, size_t end) {
+            double* out = &sums[begin / clusterBlock * 3 * numSizes];
+            for (size_t c = 0; c < numSizes; ++c) {
+                size_t m = level.sizes[c];
+                // Os clusters mais longos têm menos inícios que o bloco
+                size_t endAllan = std::max(begin, std::min(end, length - 2 * m + 1));
+                size_t endHadamard = 3 * m <= length ? std::max(begin, std::min(end, length - 3 * m + 1)) : begin;
+                clusterSums(a.data(), m, begin, endHadamard, endAllan, out[3 * c], out[3 * c + 1]);
+
+                // Sem sobreposição: os inícios múltiplos de m
+                double sum = 0.0;
+                for (size_t k = (begin + m - 1) / m * m; k < endAllan; k += m) {
+                    double d = a[k + 2 * m] - 2.0 * a[k + m] + a[k];
+                    sum += d * d;
+                }
+                out[3 * c + 2] = sum;
+            }
+        });
+
+        for (size_t c = 0; c < numSizes; ++c) {
+            size_t m = level.sizes[c];
+            double overlappingSum = 0.0, hadamardSum = 0.0, allanSum = 0.0;
+            for (size_t b = 0; b < numBlocks; ++b) {
+                overlappingSum += sums[(b * numSizes + c) * 3];
+                hadamardSum += sums[(b * numSizes + c) * 3 + 1];
+                allanSum += sums[(b * numSizes + c) * 3 + 2];
+            }
+            size_t p = level.curveIndex[c];
+            double tau2 = curve.tau[p] * curve.tau[p];
+            curve.allan[p] = allanSum / (2.0 * tau2 * (length / m - 1));
+            curve.overlappingAllan[p] = overlappingSum / (2.0 * tau2 * (length - 2 * m + 1));
+            curve.hadamard[p] = 3 * m <= length ? hadamardSum / (6.0 * tau2 * (length - 3 * m + 1))
+                                                : std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+    return curve;
+}
+
+AllanNoise fitAllanNoise(const AllanCurve& curve) {
+    AllanNoise noise;
+
+    // Pontos com pelo menos 10 clusters independentes
+    std::vector<double> tau, sigma;
+    for (size_t p = 0; p < curve.tau.size(); ++p) {
+        if (curve.clusterSize[p] * 10 <= curve.numSamples && curve.overlappingAllan[p] > 0.0) {
+            tau.push_back(curve.tau[p]);
+            sigma.push_back(std::sqrt(curve.overlappingAllan[p]));
+        }
+    }
+    size_t numPoints = tau.size();
+    if (numPoints == 0) {
+        return noise;
+    }
+
+    size_t minimum = std::min_element(sigma.begin(), sigma.end()) - sigma.begin();
+    noise.biasInstability.value = sigma[minimum] / std::sqrt(2.0 * std::log(2.0) / std::acos(-1.0));
+    noise.biasInstability.tau = tau[minimum];
+    noise.biasInstability.numPoints = 1;
+    if (numPoints < 2) {
+        return noise;
+    }
+
+    // Inclinação local em log-log (diferença centrada nos pontos internos)
+    std::vector<double> slopes(numPoints);
+    for (size_t i = 0; i < numPoints; ++i) {
+        size_t lo = i > 0 ? i - 1 : 0;
+        size_t hi = std::min(i + 1, numPoints - 1);
+        slopes[i] = std::log(sigma[hi] / sigma[lo]) / std::log(tau[hi] / tau[lo]);
+    }
+
+    noise.angleRandomWalk = fitSlope(tau, sigma, slopes, 0, minimum + 1, -0.5,
+                                     [](double s, double t) { return s * std::sqrt(t); });
+    noise.rateRandomWalk = fitSlope(tau, sigma, slopes, minimum, numPoints, 0.5,
+                                    [](double s, double t) { return s * std::sqrt(3.0 / t); });
+    return noise;
+}
+
+ImuAllanResult imuAllanVariance(const ImuData& imuData, const AllanOptions& options) {
+    ImuAllanResult result;
+    result.sampleInterval = options.sampleInterval > 0.0 ? options.sampleInterval
+                                                         : medianSampleInterval(imuData.timeStamp);
+    if (!(result.sampleInterval > 0.0)) {
+        throw std::invalid_argument("IMU data has no valid sampling interval.");
+    }
+
+    // Mesma ordem de ImuChannel
+    const std::vector<double>* columns[] = {&imuData.accx, &imuData.accy, &imuData.accz,
+                                            &imuData.gx, &imuData.gy, &imuData.gz};
+    for (size_t c = 0; c < 6; ++c) {
+        result.curves[c] = computeAllanVariance(columns[c]->data(), columns[c]->size(), result.sampleInterval, options);
+        result.noise[c] = fitAllanNoise(result.curves[c]);
+    }
+    return result;
+}
+
+std::string getLogStream(const ImuAllanResult& result) {
+    const double gravity = 9.80665;
+    const char* names[] = {"AccX", "AccY", "AccZ", "Gx", "Gy", "Gz"};
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(4);
+    oss << "Allan sampling interval: " << result.sampleInterval * 1e3 << " ms\n";
+    for (size_t c = 0; c < 6; ++c) {
+        const AllanNoise& noise = result.noise[c];
+        bool gyro = c >= 3;
+        // deg/s -> deg/sqrt(h), deg/h, deg/h/sqrt(h); g -> m/s/sqrt(h), mg, m/s^2/sqrt(h)
+        double randomWalkScale = gyro ? 60.0 : gravity * 60.0;
+        double biasScale = gyro ? 3600.0 : 1000.0;
+        double rateScale = gyro ? 3600.0 * 60.0 : gravity * 60.0;
+
+        oss << names[c] << ": ";
+        oss << (gyro ? "ARW " : "VRW ");
+        if (noise.angleRandomWalk.ok()) {
+            oss << noise.angleRandomWalk.value * randomWalkScale << (gyro ? " deg/sqrt(h)" : " m/s/sqrt(h)");
+        } else {
+            oss << "n/a";
+        }
+        oss << ", bias instability ";
+        if (noise.biasInstability.ok()) {
+            oss << noise.biasInstability.value * biasScale << (gyro ? " deg/h" : " mg") << " at "
+                << noise.biasInstability.tau << " s";
+        } else {
+            oss << "n/a";
+        }
+        oss << ", RRW ";
+        if (noise.rateRandomWalk.ok()) {
+            oss << noise.rateRandomWalk.value * rateScale << (gyro ? " deg/h/sqrt(h)" : " m/s^2/sqrt(h)");
+        } else {
+            oss << "n/a";
+        }
+        oss << "\n";
+    }
+    oss << "\n";
+    return oss.str();
+}
@@ -0,0 +1,127 @@
+#ifndef ALLAN_VARIANCE_HPP
+#define ALLAN_VARIANCE_HPP
+
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <limits>
+#include "imuData.hpp"
+#include "imuRawData.hpp"
+
+/**
+ * @brief Options of the Allan variance computation.
+ */
+struct AllanOptions {
+    double sampleInterval = 0.0; ///< Sampling interval tau0 in seconds (0 = median interval of the timestamps)
+    unsigned pointsPerDecade = 10; ///< Log-spaced cluster times per decade
+    size_t overlapsPerCluster = 64; ///< Start offsets per cluster for long clusters (0 = every sample)
+    unsigned numThreads = 0; ///< Worker threads (0 = all hardware threads)
+};
+
+/**
+ * @brief Allan, overlapping Allan and overlapping Hadamard variances of one channel.
+ *
+ * The variances are in squared channel units (e.g. (deg/s)^2). The Hadamard
+ * variance is NaN for clusters longer than a third of the data.
+ */
+struct AllanCurve {
+    size_t numSamples = 0; ///< Number of values analysed
+    double sampleInterval = 0.0; ///< Sampling interval tau0 in seconds
+    std::vector<size_t> clusterSize; ///< Samples per cluster m
+    std::vector<double> tau; ///< Cluster times m * tau0 in seconds
+    std::vector<double> allan; ///< Allan variance (non-overlapping clusters)
+    std::vector<double> overlappingAllan; ///< Overlapping Allan variance
+    std::vector<double> hadamard; ///< Overlapping Hadamard variance
+};
+
+/**
+ * @brief Noise coefficient read from an Allan deviation curve.
+ */
+struct NoiseFit {
+    double value = std::numeric_limits<double>::quiet_NaN(); ///< Coefficient (NaN if the curve has no such region)
+    double tau = std::numeric_limits<double>::quiet_NaN(); ///< Cluster time where it was read (geometric centre of the points)
+    size_t numPoints = 0; ///< Points of the curve used
+
+    bool ok() const { return numPoints > 0; } ///< True if the coefficient was found
+};
+
+/**
+ * @brief Noise coefficients of one channel, in channel units and seconds.
+ *
+ * For an accelerometer the random walk is the velocity random walk (g * sqrt(s))
+ * and the rate random walk is the acceleration random walk (g / sqrt(s)).
+ */
+struct AllanNoise {
+    NoiseFit angleRandomWalk; ///< N: Allan deviation N / sqrt(tau) (unit * sqrt(s))
+    NoiseFit biasInstability; ///< B: minimum of the Allan deviation / 0.664 (unit)
+    NoiseFit rateRandomWalk; ///< K: Allan deviation K * sqrt(tau / 3) (unit / sqrt(s))
+};
+
+/**
+ * @brief Allan analysis of the six channels of IMU data.
+ */
+struct ImuAllanResult {
+    double sampleInterval = 0.0; ///< Sampling interval tau0 in seconds
+    std::vector<AllanCurve> curves = std::vector<AllanCurve>(6); ///< Curves indexed by ImuChannel
+    std::vector<AllanNoise> noise = std::vector<AllanNoise>(6); ///< Noise coefficients indexed by ImuChannel
+
+    const AllanCurve& curve(ImuChannel channel) const { return curves[static_cast<size_t>(channel)]; }
+    const AllanNoise& noiseOf(ImuChannel channel) const { return noise[static_cast<size_t>(channel)]; }
+};
+
+/**
+ * @brief Computes the Allan variances of evenly sampled values.
+ *
+ * The values are integrated once into a prefix sum (after removing their mean,
+ * which the variances ignore), so each cluster term costs a few additions.
+ * A cluster of m samples starts at every sample if m < 2 * overlapsPerCluster;
+ * longer clusters start every s samples, with s the power of two that keeps
+ * m / s in [overlapsPerCluster, 2 * overlapsPerCluster), and m is rounded to a
+ * multiple of s. Those clusters are evaluated on the prefix sum decimated by s,
+ * so every cluster length reads contiguous memory and a full day at 2 kHz takes
+ * about 25 passes over the data in total. Blocks of the data and cluster times
+ * are spread over the threads; the result does not depend on their number.
+ *
+ * @param values The values (e.g. a gyroscope column).
+ * @param numSamples The number of values (at least 3).
+ * @param sampleInterval The sampling interval tau0 in seconds.
+ * @param options The computation options (options.sampleInterval is ignored).
+ * @return AllanCurve The variances for log-spaced cluster sizes up to numSamples / 2.
+ * @throws std::invalid_argument If there are fewer than 3 values or sampleInterval is not positive.
+ */
+AllanCurve computeAllanVariance(const double* values, size_t numSamples, double sampleInterval,
+                                const AllanOptions& options = AllanOptions());
+
+/**
+ * @brief Reads the angle random walk, bias instability and rate random walk from a curve.
+ *
+ * Uses the overlapping Allan deviation at cluster times with at least 10
+ * independent clusters. N and K are the geometric means of sigma * sqrt(tau)
+ * and sigma * sqrt(3 / tau) over the points whose local log-log slope is within
+ * 0.1 of -1/2 (before the minimum) and +1/2 (after it).
+ *
+ * @param curve The Allan curve.
+ * @return AllanNoise The coefficients.
+ */
+AllanNoise fitAllanNoise(const AllanCurve& curve);
+
+/**
+ * @brief Computes the Allan analysis of the six channels of IMU data.
+ *
+ * The channels are processed one after another, so the extra memory is that of
+ * one channel (about two doubles per sample); each uses all threads.
+ *
+ * @param imuData The IMU data, ideally a static recording.
+ * @param options The computation options.
+ * @return ImuAllanResult The curves and noise coefficients.
+ * @throws std::invalid_argument If there are fewer than 3 samples or no valid sampling interval.
+ */
+ImuAllanResult imuAllanVariance(const ImuData& imuData, const AllanOptions& options = AllanOptions());
+
+/**
+ * @brief Formats the noise coefficients of every channel in the usual units
+ *        (deg/sqrt(h), deg/h, deg/h/sqrt(h); m/s/sqrt(h), mg, m/s^2/sqrt(h)).
+ */
+std::string getLogStream(const ImuAllanResult& result);
+
+#endif // ALLAN_VARIANCE_HPP
@@ -0,0 +1,42 @@
+// Kernel de allanVariance. Este arquivo é incluído uma vez para cada conjunto
+// de instruções em allanVariance.cpp (código portável e AVX2).
+
+// Somas dos quadrados das segundas (Allan) e terceiras (Hadamard) diferenças
+// de a para os inícios k em [begin, endHadamard) e [begin, endAllan)
+void clusterSums(const double* a, size_t m, size_t begin, size_t endHadamard, size_t endAllan,
+                 double& allanSum, double& hadamardSum) {
+    // Acumuladores independentes por faixa: o compilador vetoriza sem reordenar somas
+    const size_t lanes = 4;
+    double sa[lanes] = {0.0, 0.0, 0.0, 0.0};
+    double sh[lanes] = {0.0, 0.0, 0.0, 0.0};
+    const double* a1 = a + m;
+    const double* a2 = a + 2 * m;
+    const double* a3 = a + 3 * m;
+    size_t k = begin;
+    for (; k + lanes <= endHadamard; k += lanes) {
+        for (size_t j = 0; j < lanes; ++j) {
+            double d = a2[k + j] - 2.0 * a1[k + j] + a[k + j];
+            double h = a3[k + j] - 3.0 * (a2[k + j] - a1[k + j]) - a[k + j];
+            sa[j] += d * d;
+            sh[j] += h * h;
+        }
+    }
+    for (; k < endHadamard; ++k) {
+        double d = a2[k] - 2.0 * a1[k] + a[k];
+        double h = a3[k] - 3.0 * (a2[k] - a1[k]) - a[k];
+        sa[0] += d * d;
+        sh[0] += h * h;
+    }
+    for (; k + lanes <= endAllan; k += lanes) {
+        for (size_t j = 0; j < lanes; ++j) {
+            double d = a2[k + j] - 2.0 * a1[k + j] + a[k + j];
+            sa[j] += d * d;
+        }
+    }
+    for (; k < endAllan; ++k) {
+        double d = a2[k] - 2.0 * a1[k] + a[k];
+        sa[0] += d * d;
+    }
+    allanSum += (sa[0] + sa[1]) + (sa[2] + sa[3]);
+    hadamardSum += (sh[0] + sh[1]) + (sh[2] + sh[3]);
+}
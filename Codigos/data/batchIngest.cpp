@@ -0,0 +1,132 @@
+#include "batchIngest.hpp"
+#include "imuArchive.hpp"
+#include "workStealingPool.hpp"
+#include <mutex>
+#include <condition_variable>
+
+namespace {
+
+struct IngestTask {
+    size_t session;
+    bool imu;
+    uint64_t bytes;
+};
+
+// Limita a memória estimada das cargas em andamento
+class MemoryBudget {
+public:
+    explicit MemoryBudget(uint64_t capacity) : capacity_(capacity) {}
+
+    // Reserva a primeira das cargas pendentes que cabe e devolve seu índice; bloqueia até alguma caber.
+    // Uma carga maior que o limite roda sozinha
+    size_t acquireFirstFitting(const std::vector<IngestTask>& pending) {
+        if (capacity_ == 0) {
+            return 0;
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        size_t next = pending.size();
+        released_.wait(lock, [&]() {
+            for (next = 0; next < pending.size(); ++next) {
+                if (used_ == 0 || used_ + pending[next].bytes <= capacity_) {
+                    return true;
+                }
+            }
+            return false;
+        });
+        used_ += pending[next].bytes;
+        return next;
+    }
+
+    void release(uint64_t bytes) {
+        if (capacity_ == 0) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            used_ -= bytes;
+        }
+        released_.notify_all();
+    }
+
+private:
+    uint64_t capacity_;
+    uint64_t used_ = 0;
+    std::mutex mutex_;
+    std::condition_variable released_;
+};
+
+} // namespace
+
+uint64_t estimateLoadBytes(const std::string& fileName, bool imu) {
+    try {
+        MappedFile file(fileName);
+        if (!imu) {
+            return 2 * static_cast<uint64_t>(file.size());
+        }
+        if (isImuArchive(file.data(), file.size())) {
+            return imuArchiveRecords(file.data(), file.size()) * (7 * sizeof(double) + sizeof(ImuRecord));
+        }
+        return file.size() / sizeof(ImuRecord) * (7 * sizeof(double));
+    } catch (const std::exception&) {
+        // A carga vai falhar e registrar o erro
+        return 0;
+    }
+}
+
+std::vector<IngestResult> ingestSessions(const std::vector<IngestSession>& sessions, const IngestOptions& options) {
+    std::vector<IngestResult> results(sessions.size());
+
+    std::vector<IngestTask> tasks;
+    for (size_t s = 0; s < sessions.size(); ++s) {
+        results[s].imuModel = sessions[s].imuModel;
+        if (!sessions[s].imuFile.empty()) {
+            tasks.push_back({s, true, estimateLoadBytes(sessions[s].imuFile, true)});
+        }
+        if (!sessions[s].gnssFile.empty()) {
+            tasks.push_back({s, false, estimateLoadBytes(sessions[s].gnssFile, false)});
+        }
+    }
+    // As maiores primeiro, para não deixar uma carga longa para o fim
+    std::stable_sort(tasks.begin(), tasks.end(),
+                     [](const IngestTask& a, const IngestTask& b) { return a.bytes > b.bytes; });
+
+    // O log de IMU e o de GNSS de uma sessão podem ser escritos ao mesmo tempo
+    std::vector<std::ostringstream> imuLogs(sessions.size());
+    std::vector<std::ostringstream> gnssLogs(sessions.size());
+    MemoryBudget budget(options.maxInFlightBytes);
+    {
+        WorkStealingPool pool(options.numThreads);
+        // A reserva é feita aqui, antes de entregar a carga: um worker nunca fica parado esperando memória
+        std::vector<IngestTask> pending = tasks;
+        while (!pending.empty()) {
+            size_t next = budget.acquireFirstFitting(pending);
+            IngestTask task = pending[next];
+            pending.erase(pending.begin() + next);
+            pool.submit([&, task]() {
+                const IngestSession& session = sessions[task.session];
+                IngestResult& result = results[task.session];
+                std::ostringstream& log = task.imu ? imuLogs[task.session] : gnssLogs[task.session];
+                ScopedDataLog scope(log);
+                try {
+                    if (task.imu) {
+                        int imuModel = session.imuModel;
+                        result.imuData = loadImuData(session.imuFile, imuModel, options.logData, options.cache);
+                        result.imuModel = imuModel;
+                    } else {
+                        result.gnssData = loadGnssData(session.gnssFile, options.logData, 1, options.cache);
+                    }
+                } catch (const std::exception& e) {
+                    (task.imu ? result.imuError : result.gnssError) = e.what();
+                    log << "Error: " << e.what() << "\n";
+                }
+                budget.release(task.bytes);
+            });
+        }
+        pool.wait();
+    }
+
+    for (size_t s = 0; s < sessions.size(); ++s) {
+        results[s].log = imuLogs[s].str() + gnssLogs[s].str();
+    }
+    return results;
+}
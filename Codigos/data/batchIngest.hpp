@@ -0,0 +1,73 @@
+#ifndef BATCH_INGEST_HPP
+#define BATCH_INGEST_HPP
+
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include "imuData.hpp"
+#include "gnssData.hpp"
+
+/**
+ * @brief Files of one recording session. An empty name skips that sensor.
+ */
+struct IngestSession {
+    std::string imuFile; ///< IMU binary log or archive
+    std::string gnssFile; ///< RTKLIB .pos file
+    int imuModel = 0; ///< IMU model (0 = detect)
+};
+
+/**
+ * @brief Data, output and errors of one session.
+ */
+struct IngestResult {
+    ImuData imuData; ///< Loaded IMU data
+    GnssData gnssData; ///< Loaded GNSS data
+    int imuModel = 0; ///< Detected or given IMU model
+    std::string log; ///< Everything the loaders wrote for this session (IMU first)
+    std::string imuError; ///< Error of the IMU load, empty on success
+    std::string gnssError; ///< Error of the GNSS load, empty on success
+
+    bool ok() const { return imuError.empty() && gnssError.empty(); } ///< True if nothing failed
+};
+
+/**
+ * @brief Options of ingestSessions.
+ */
+struct IngestOptions {
+    unsigned numThreads = 0; ///< Worker threads (0 = all hardware threads)
+    uint64_t maxInFlightBytes = 0; ///< Cap on the estimated memory of the loads running at once (0 = none)
+    bool logData = false; ///< Append the statistics of each load to its log
+    CacheMode cache = CacheMode::Use; ///< Cache mode of every load
+};
+
+/**
+ * @brief Estimates the memory a load needs, from the size of its file.
+ *
+ * IMU: 56 bytes per record, plus 32 per record to decode an archive.
+ * GNSS: twice the size of the text, which covers the parsed and converted columns.
+ *
+ * @param fileName The name of the file.
+ * @param imu True for an IMU log, false for a GNSS file.
+ * @return uint64_t The estimate in bytes (0 if the file cannot be read).
+ */
+uint64_t estimateLoadBytes(const std::string& fileName, bool imu);
+
+/**
+ * @brief Loads many sessions concurrently.
+ *
+ * Each IMU and each GNSS file is one task of a work-stealing pool; the largest
+ * are started first. A load is only handed to the pool once the estimated memory
+ * of the running loads plus its own fits in options.maxInFlightBytes, so workers
+ * never block on the cap: meanwhile, smaller loads that fit are started ahead of
+ * it. A load larger than the cap runs alone. The output of each load goes to its session's log instead of
+ * std::cout, and its errors are stored in the result instead of being thrown.
+ *
+ * @param sessions The sessions to load.
+ * @param options The ingest options.
+ * @return std::vector<IngestResult> One result per session, in the order of sessions.
+ */
+std::vector<IngestResult> ingestSessions(const std::vector<IngestSession>& sessions,
+                                         const IngestOptions& options = IngestOptions());
+
+#endif // BATCH_INGEST_HPP
@@ -0,0 +1,252 @@
+// Benchmark do pipeline de dados com logs sintéticos de 1e4 até 1e8 amostras.
+// Compilação (a partir de Codigos/data):
+//   g++ -O2 -std=c++17 -pthread -I. bench/bench_data.cpp syntheticData.cpp imuData.cpp gnssData.cpp
+//       dataCache.cpp dataExport.cpp logStats.cpp llaFromEcefSimd.cpp imuArchive.cpp dataProfile.cpp -o bench_data
+// Com -DDATA_PROFILE o JSON inclui também o tempo de cada etapa dos carregadores.
+// Uso: bench_data [--min 1e4] [--max 1e8] [--out results.json] [--dir workdir]
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <cstdio>
+#include <functional>
+#include <iomanip>
+#include "imuData.hpp"
+#include "gnssData.hpp"
+#include "llaFromEcefSimd.hpp"
+#include "syntheticData.hpp"
+#include "dataProfile.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// Contadores de alocação: substituem o operator new global deste executável
+namespace {
+std::atomic<uint64_t> allocationCount{0};
+std::atomic<uint64_t> allocatedBytes{0};
+}
+
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    dataProfileNoteAllocation(size);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+struct BenchResult {
+    std::string name;
+    size_t samples;
+    uint64_t bytes;
+    double seconds;
+    uint64_t peakRss;
+    uint64_t allocations;
+    uint64_t allocatedBytes;
+};
+
+// Pico de memória residente do processo em bytes
+uint64_t peakRss() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return counters.PeakWorkingSetSize;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return static_cast<uint64_t>(usage.ru_maxrss);
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+// No Linux o pico pode ser zerado para medir cada etapa separadamente
+void resetPeakRss() {
+#if defined(__linux__)
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+#endif
+}
+
+uint64_t fileSize(const std::string& fileName) {
+    std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+    return static_cast<uint64_t>(file.tellg());
+}
+
+BenchResult run(const std::string& name, size_t samples, uint64_t bytes, const std::function<void()>& body) {
+    resetPeakRss();
+    uint64_t allocations0 = allocationCount.load();
+    uint64_t bytes0 = allocatedBytes.load();
+    auto start = std::chrono::steady_clock::now();
+    body();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    BenchResult result{name, samples, bytes, seconds, peakRss(), allocationCount.load() - allocations0,
+                       allocatedBytes.load() - bytes0};
+    std::cerr << name << " n=" << samples << ": " << seconds << " s, " << samples / seconds / 1e6 << " M/s\n";
+    return result;
+}
+
+void writeJson(std::ostream& out, const std::vector<BenchResult>& results) {
+    out << "{\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        out << "    {\"name\": \"" << r.name << "\", \"samples\": " << r.samples << ", \"bytes\": " << r.bytes
+            << ", \"seconds\": " << std::setprecision(9) << r.seconds
+            << ", \"samplesPerSecond\": " << std::setprecision(6) << r.samples / r.seconds
+            << ", \"bytesPerSecond\": " << (r.bytes ? r.bytes / r.seconds : 0.0)
+            << ", \"peakRssBytes\": " << r.peakRss << ", \"allocations\": " << r.allocations
+            << ", \"allocatedBytes\": " << r.allocatedBytes << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]";
+    if (dataProfileEnabled) {
+        out << ",\n  \"profile\": " << dataProfileJson(dataProfileReport());
+    }
+    out << "\n}\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t minSamples = 10000;
+    size_t maxSamples = 100000000;
+    std::string outputFileName;
+    std::string workDir = ".";
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--min" && i + 1 < argc) {
+            minSamples = static_cast<size_t>(std::stod(argv[++i]));
+        } else if (arg == "--max" && i + 1 < argc) {
+            maxSamples = static_cast<size_t>(std::stod(argv[++i]));
+        } else if (arg == "--out" && i + 1 < argc) {
+            outputFileName = argv[++i];
+        } else if (arg == "--dir" && i + 1 < argc) {
+            workDir = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--min 1e4] [--max 1e8] [--out results.json] [--dir workdir]"
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<BenchResult> results;
+    try {
+        for (size_t n = minSamples; n <= maxSamples; n *= 10) {
+            std::string imuFile = workDir + "/bench_imu.bin";
+            std::string posFile = workDir + "/bench_gnss.pos";
+            std::string outFile = workDir + "/bench_out.txt";
+            writeSyntheticImuLog(imuFile, n);
+            writeSyntheticPosFile(posFile, n);
+
+            // IMU
+            int model = 0;
+            ImuData imuData;
+            results.push_back(run("loadImuData", n, fileSize(imuFile), [&]() {
+                imuData = loadImuData(imuFile, model, false, CacheMode::Off);
+            }));
+
+            ImuData withDuplicates;
+            {
+                MappedFile file(imuFile);
+                size_t numRecords = 0;
+                const ImuRecord* records = imuRecords(file, imuFile, numRecords);
+                double anglfak, accelfak;
+                imuScaleFactors(model, anglfak, accelfak);
+                for (size_t i = 0; i < numRecords; ++i) {
+                    withDuplicates.timeStamp.push_back(imuRecordTime(records[i]));
+                    withDuplicates.gx.push_back(records[i].gx * anglfak);
+                    withDuplicates.gy.push_back(records[i].gy * anglfak);
+                    withDuplicates.gz.push_back(records[i].gz * anglfak);
+                    withDuplicates.accx.push_back(records[i].accx * accelfak);
+                    withDuplicates.accy.push_back(records[i].accy * accelfak);
+                    withDuplicates.accz.push_back(records[i].accz * accelfak);
+                }
+            }
+            results.push_back(run("removeDuplicateTimestamps", n, 0, [&]() {
+                removeDuplicateTimestamps(withDuplicates);
+            }));
+            withDuplicates = ImuData();
+
+            std::string imuLog;
+            results.push_back(run("getLogStream(ImuData)", imuData.timeStamp.size(), 0, [&]() {
+                imuLog = getLogStream(imuData, model);
+            }));
+            results.push_back(run("outputImuData", imuData.timeStamp.size(), 0, [&]() {
+                outputImuData(imuData, outFile, 0, imuData.timeStamp.size());
+            }));
+            results.back().bytes = fileSize(outFile);
+            imuData = ImuData();
+
+            // GNSS
+            GnssData gnssData;
+            results.push_back(run("loadGnssData", n, fileSize(posFile), [&]() {
+                gnssData = loadGnssData(posFile, false, 1, CacheMode::Off);
+            }));
+            results.push_back(run("loadGnssData(threads)", n, fileSize(posFile), [&]() {
+                gnssData = loadGnssData(posFile, false, 0, CacheMode::Off);
+            }));
+
+            std::vector<double> lat, lon, alt;
+            results.push_back(run("llaFromEcef", gnssData.x.size(), 0, [&]() {
+                llaFromEcef(gnssData.x, gnssData.y, gnssData.z, lat, lon, alt);
+            }));
+            results.push_back(run("llaFromEcefFast", gnssData.x.size(), 0, [&]() {
+                llaFromEcefFast(gnssData.x, gnssData.y, gnssData.z, lat, lon, alt);
+            }));
+
+            std::string gnssLog;
+            results.push_back(run("getLogStream(GnssData)", gnssData.time.size(), 0, [&]() {
+                gnssLog = getLogStream(gnssData);
+            }));
+            results.push_back(run("outputGnss", gnssData.time.size(), 0, [&]() {
+                outputGnss(gnssData, outFile, 0, gnssData.time.size());
+            }));
+            results.back().bytes = fileSize(outFile);
+
+            std::remove(imuFile.c_str());
+            std::remove(posFile.c_str());
+            std::remove(outFile.c_str());
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (outputFileName.empty()) {
+        writeJson(std::cout, results);
+    } else {
+        std::ofstream out(outputFileName);
+        writeJson(out, results);
+    }
+    return 0;
+}
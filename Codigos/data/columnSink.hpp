@@ -0,0 +1,56 @@
+#ifndef COLUMN_SINK_HPP
+#define COLUMN_SINK_HPP
+
+#include <cstddef>
+#include <functional>
+
+/**
+ * @brief Caller-owned destination of one channel: a pointer and the distance between samples.
+ *
+ * Lets the loaders decode straight into memory they do not own, such as a
+ * column-major MATLAB matrix (stride 1) or a row-major buffer (stride equal
+ * to the number of channels).
+ */
+struct ColumnSink {
+    double* data = nullptr; ///< First sample
+    size_t stride = 1; ///< Distance between consecutive samples, in doubles
+
+    double& operator[](size_t i) const { return data[i * stride]; }
+};
+
+/**
+ * @brief Destinations of the IMU channels (same names as ImuData).
+ */
+struct ImuColumns {
+    ColumnSink timeStamp, accx, accy, accz, gx, gy, gz;
+};
+
+/**
+ * @brief Destinations of the GNSS channels (same names as GnssData). The fix status is stored as a double.
+ */
+struct GnssColumns {
+    ColumnSink time, x, y, z, lat, lon, alt, fix;
+};
+
+/**
+ * @brief Called once by the loaders with the final number of samples; returns where to write them.
+ */
+using ImuColumnAllocator = std::function<ImuColumns(size_t numSamples)>;
+
+/**
+ * @brief Called once by the loaders with the final number of samples; returns where to write them.
+ */
+using GnssColumnAllocator = std::function<GnssColumns(size_t numSamples)>;
+
+/**
+ * @brief Gets a column of a column-major matrix (the layout of MATLAB arrays).
+ *
+ * @param matrix The first element of the matrix.
+ * @param numRows The number of rows.
+ * @param column The 0-based column index.
+ */
+inline ColumnSink matrixColumn(double* matrix, size_t numRows, size_t column) {
+    return ColumnSink{matrix + column * numRows, 1};
+}
+
+#endif // COLUMN_SINK_HPP
@@ -7,15 +7,15 @@
 % % Compilar ImuData
 % mex('-v', 'CXXFLAGS="$CXXFLAGS -Wall -Wextra"', ipath, '-R2018a', ...
 %     '-output', 'mex/loadImuData_mexbin', ...
-%     'imuData.cpp', 'mex/imuData_mex.cpp')
+%     'imuData.cpp', 'imuArchive.cpp', 'dataCache.cpp', 'dataExport.cpp', 'logStats.cpp', 'dataProfile.cpp', 'mex/imuData_mex.cpp')
 % 
 % % Compilar GnssData
 % mex('-v', 'CXXFLAGS="$CXXFLAGS -Wall -Wextra"', ipath, '-R2018a', ...
 %     '-output', 'mex/loadGnssData_mexbin', ...
-%     'gnssData.cpp', 'mex/gnssData_mex.cpp')
+%     'gnssData.cpp', 'dataCache.cpp', 'dataExport.cpp', 'logStats.cpp', 'dataProfile.cpp', 'mex/gnssData_mex.cpp')
 % 
 % %%
 % 
 
 ipath = ['-I' pwd];
-mex(ipath,'-v','-output', 'mex/loadImuData_mexbin', 'imuData.cpp', 'mex/imuData_mex.cpp')
\ No newline at end of file
+mex(ipath,'-v','-output', 'mex/loadImuData_mexbin', 'imuData.cpp', 'imuArchive.cpp', 'dataCache.cpp', 'dataExport.cpp', 'logStats.cpp', 'dataProfile.cpp', 'mex/imuData_mex.cpp')
\ No newline at end of file
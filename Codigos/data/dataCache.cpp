@@ -0,0 +1,421 @@
+#include "dataCache.hpp"
+#include "imuData.hpp"
+#include "gnssData.hpp"
+#include <cstring>
+#include <cstdio>
+#include <filesystem>
+#include <atomic>
+#include <thread>
+#include <functional>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Formato do cache (little-endian):
+//   CacheHeader
+//   CacheColumn[numColumns]
+//   colunas, cada uma alinhada em 8 bytes
+const char cacheMagic[8] = {'D', 'L', 'N', 'C', 'A', 'C', 'H', 'E'};
+const uint32_t cacheVersion = 1;
+const uint32_t cacheKindImu = 1;
+const uint32_t cacheKindGnss = 2;
+const uint32_t columnDouble = 0;
+const uint32_t columnInt32 = 1;
+const size_t hashBlockBytes = 1 << 20;
+
+struct CacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t kind; ///< 1 = IMU, 2 = GNSS
+    int32_t imuModel; ///< 0 for GNSS
+    uint32_t numColumns;
+    uint64_t numSamples;
+    uint64_t sourceSize;
+    int64_t sourceMtime;
+    uint64_t sourceHash;
+};
+static_assert(sizeof(CacheHeader) == 56, "CacheHeader layout");
+
+struct CacheColumn {
+    uint32_t type; ///< columnDouble or columnInt32
+    uint32_t reserved;
+    uint64_t offset; ///< From the start of the file
+    uint64_t bytes;
+};
+static_assert(sizeof(CacheColumn) == 24, "CacheColumn layout");
+
+// Coluna a gravar: contígua no tipo armazenado ou, se data for nulo, uma
+// coluna de doubles com passo qualquer
+struct ColumnRef {
+    uint32_t type;
+    const void* data;
+    size_t elementSize;
+    ColumnSink strided;
+};
+
+const size_t gatherBlock = 1 << 13;
+
+// Grava uma coluna com passo, convertendo para o tipo armazenado em blocos
+void writeStrided(std::ofstream& out, const ColumnRef& column, size_t numSamples) {
+    std::vector<char> block(gatherBlock * column.elementSize);
+    for (size_t first = 0; first < numSamples; first += gatherBlock) {
+        size_t count = std::min(gatherBlock, numSamples - first);
+        for (size_t i = 0; i < count; ++i) {
+            double value = column.strided[first + i];
+            if (column.type == columnInt32) {
+                int32_t v = static_cast<int32_t>(value);
+                std::memcpy(block.data() + i * sizeof(v), &v, sizeof(v));
+            } else {
+                std::memcpy(block.data() + i * sizeof(value), &value, sizeof(value));
+            }
+        }
+        out.write(block.data(), count * column.elementSize);
+    }
+}
+
+struct SourceInfo {
+    uint64_t size;
+    int64_t mtime;
+    uint64_t hash;
+};
+
+uint64_t fnv1a(const char* data, size_t size, uint64_t hash) {
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+SourceInfo describeSource(const std::string& fileName) {
+    namespace fs = std::filesystem;
+    SourceInfo info;
+    info.size = fs::file_size(fileName);
+    info.mtime = static_cast<int64_t>(fs::last_write_time(fileName).time_since_epoch().count());
+
+    // Hash do tamanho e do primeiro e último MiB: ler o arquivo todo custaria
+    // tanto quanto decodificá-lo
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Error opening file: " + fileName);
+    }
+    std::vector<char> block(std::min<uint64_t>(info.size, hashBlockBytes));
+    uint64_t hash = fnv1a(reinterpret_cast<const char*>(&info.size), sizeof(info.size), 0xcbf29ce484222325ULL);
+    file.read(block.data(), block.size());
+    hash = fnv1a(block.data(), block.size(), hash);
+    if (info.size > hashBlockBytes) {
+        file.seekg(static_cast<std::streamoff>(info.size - block.size()), std::ios::beg);
+        file.read(block.data(), block.size());
+        hash = fnv1a(block.data(), block.size(), hash);
+    }
+    if (!file) {
+        throw std::runtime_error("Error reading file: " + fileName);
+    }
+    info.hash = hash;
+    return info;
+}
+
+// Nome temporário próprio de cada escrita (processo, thread e contador): duas cargas do mesmo arquivo
+// ao mesmo tempo não escrevem no mesmo temporário
+std::string uniqueTempName(const std::string& cacheName) {
+    static std::atomic<uint64_t> counter{0};
+#ifdef _WIN32
+    unsigned long pid = GetCurrentProcessId();
+#else
+    unsigned long pid = static_cast<unsigned long>(getpid());
+#endif
+    size_t thread = std::hash<std::thread::id>()(std::this_thread::get_id());
+    return cacheName + "." + std::to_string(pid) + "." + std::to_string(thread) + "." +
+           std::to_string(counter.fetch_add(1)) + ".tmp";
+}
+
+void writeCache(const std::string& sourceFileName, uint32_t kind, int imuModel, size_t numSamples,
+                const std::vector<ColumnRef>& columns) {
+    CacheHeader header;
+    std::memcpy(header.magic, cacheMagic, sizeof(cacheMagic));
+    SourceInfo source = describeSource(sourceFileName);
+    header.version = cacheVersion;
+    header.kind = kind;
+    header.imuModel = imuModel;
+    header.numColumns = static_cast<uint32_t>(columns.size());
+    header.numSamples = numSamples;
+    header.sourceSize = source.size;
+    header.sourceMtime = source.mtime;
+    header.sourceHash = source.hash;
+
+    std::vector<CacheColumn> table(columns.size());
+    uint64_t offset = sizeof(CacheHeader) + columns.size() * sizeof(CacheColumn);
+    for (size_t c = 0; c < columns.size(); ++c) {
+        offset = (offset + 7) & ~uint64_t(7);
+        table[c].type = columns[c].type;
+        table[c].reserved = 0;
+        table[c].offset = offset;
+        table[c].bytes = numSamples * columns[c].elementSize;
+        offset += table[c].bytes;
+    }
+
+    // Escreve num arquivo temporário para não deixar um cache incompleto
+    std::string cacheName = cacheFileName(sourceFileName);
+    std::string tempName = uniqueTempName(cacheName);
+    {
+        std::ofstream out(tempName, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Error opening cache file: " + tempName);
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(CacheColumn));
+        uint64_t position = sizeof(CacheHeader) + table.size() * sizeof(CacheColumn);
+        const char padding[8] = {};
+        for (size_t c = 0; c < columns.size(); ++c) {
+            out.write(padding, table[c].offset - position);
+            if (columns[c].data) {
+                out.write(static_cast<const char*>(columns[c].data), table[c].bytes);
+            } else {
+                writeStrided(out, columns[c], numSamples);
+            }
+            position = table[c].offset + table[c].bytes;
+        }
+        if (!out) {
+            throw std::runtime_error("Error writing cache file: " + tempName);
+        }
+    }
+    std::remove(cacheName.c_str());
+    if (std::rename(tempName.c_str(), cacheName.c_str()) != 0) {
+        std::remove(tempName.c_str());
+        throw std::runtime_error("Error writing cache file: " + cacheName);
+    }
+}
+
+// Abre e valida o cache; retorna false se não existir ou estiver desatualizado
+bool openCache(const std::string& sourceFileName, uint32_t kind, const std::vector<uint32_t>& columnTypes,
+               MappedFile& file, const CacheHeader*& header, const CacheColumn*& table) {
+    std::string cacheName = cacheFileName(sourceFileName);
+    std::error_code ec;
+    if (!std::filesystem::exists(cacheName, ec)) {
+        return false;
+    }
+    try {
+        file.open(cacheName);
+    } catch (const std::runtime_error&) {
+        return false;
+    }
+
+    size_t tableEnd = sizeof(CacheHeader) + columnTypes.size() * sizeof(CacheColumn);
+    if (file.size() < tableEnd) {
+        return false;
+    }
+    header = reinterpret_cast<const CacheHeader*>(file.data());
+    table = reinterpret_cast<const CacheColumn*>(file.data() + sizeof(CacheHeader));
+    if (std::memcmp(header->magic, cacheMagic, sizeof(cacheMagic)) != 0 || header->version != cacheVersion ||
+        header->kind != kind || header->numColumns != columnTypes.size()) {
+        return false;
+    }
+    for (size_t c = 0; c < columnTypes.size(); ++c) {
+        size_t elementSize = columnTypes[c] == columnDouble ? sizeof(double) : sizeof(int32_t);
+        if (table[c].type != columnTypes[c] || table[c].bytes != header->numSamples * elementSize ||
+            table[c].offset < tableEnd || table[c].offset + table[c].bytes > file.size()) {
+            return false;
+        }
+    }
+
+    SourceInfo source;
+    try {
+        source = describeSource(sourceFileName);
+    } catch (const std::exception&) {
+        return false;
+    }
+    return header->sourceSize == source.size && header->sourceMtime == source.mtime &&
+           header->sourceHash == source.hash;
+}
+
+template <typename T>
+void readColumn(const MappedFile& file, const CacheColumn& column, std::vector<T>& out) {
+    out.resize(column.bytes / sizeof(T));
+    std::memcpy(out.data(), file.data() + column.offset, column.bytes);
+}
+
+// Copia uma coluna do cache para uma coluna com passo
+void readColumn(const MappedFile& file, const CacheColumn& column, const ColumnSink& out, size_t numSamples) {
+    const char* data = file.data() + column.offset;
+    if (column.type == columnInt32) {
+        for (size_t i = 0; i < numSamples; ++i) {
+            int32_t v;
+            std::memcpy(&v, data + i * sizeof(v), sizeof(v));
+            out[i] = v;
+        }
+    } else if (out.stride == 1) {
+        std::memcpy(out.data, data, numSamples * sizeof(double));
+    } else {
+        for (size_t i = 0; i < numSamples; ++i) {
+            std::memcpy(&out[i], data + i * sizeof(double), sizeof(double));
+        }
+    }
+}
+
+ColumnRef contiguousColumn(uint32_t type, const void* data) {
+    return {type, data, type == columnInt32 ? sizeof(int32_t) : sizeof(double), ColumnSink()};
+}
+
+ColumnRef stridedColumn(uint32_t type, const ColumnSink& column) {
+    return {type, nullptr, type == columnInt32 ? sizeof(int32_t) : sizeof(double), column};
+}
+
+const std::vector<uint32_t> imuColumnTypes(7, columnDouble);
+const std::vector<uint32_t> gnssColumnTypes = {columnDouble, columnDouble, columnDouble, columnDouble,
+                                               columnDouble, columnDouble, columnDouble, columnInt32};
+
+} // namespace
+
+std::string cacheFileName(const std::string& sourceFileName) {
+    return sourceFileName + ".cache";
+}
+
+void invalidateCache(const std::string& sourceFileName) {
+    std::remove(cacheFileName(sourceFileName).c_str());
+}
+
+bool readImuCache(const std::string& sourceFileName, int& imuModel, ImuData& imuData) {
+    MappedFile file;
+    const CacheHeader* header;
+    const CacheColumn* table;
+    if (!openCache(sourceFileName, cacheKindImu, imuColumnTypes, file, header, table)) {
+        return false;
+    }
+    if (imuModel != 0 && imuModel != header->imuModel) {
+        return false;
+    }
+
+    imuModel = header->imuModel;
+    readColumn(file, table[0], imuData.timeStamp);
+    readColumn(file, table[1], imuData.accx);
+    readColumn(file, table[2], imuData.accy);
+    readColumn(file, table[3], imuData.accz);
+    readColumn(file, table[4], imuData.gx);
+    readColumn(file, table[5], imuData.gy);
+    readColumn(file, table[6], imuData.gz);
+    return true;
+}
+
+void writeImuCache(const std::string& sourceFileName, int imuModel, const ImuData& imuData) {
+    writeCache(sourceFileName, cacheKindImu, imuModel, imuData.timeStamp.size(), {
+        contiguousColumn(columnDouble, imuData.timeStamp.data()),
+        contiguousColumn(columnDouble, imuData.accx.data()),
+        contiguousColumn(columnDouble, imuData.accy.data()),
+        contiguousColumn(columnDouble, imuData.accz.data()),
+        contiguousColumn(columnDouble, imuData.gx.data()),
+        contiguousColumn(columnDouble, imuData.gy.data()),
+        contiguousColumn(columnDouble, imuData.gz.data()),
+    });
+}
+
+bool readImuCache(const std::string& sourceFileName, int& imuModel, const ImuColumnAllocator& allocate,
+                  size_t& numSamples) {
+    MappedFile file;
+    const CacheHeader* header;
+    const CacheColumn* table;
+    if (!openCache(sourceFileName, cacheKindImu, imuColumnTypes, file, header, table)) {
+        return false;
+    }
+    if (imuModel != 0 && imuModel != header->imuModel) {
+        return false;
+    }
+
+    imuModel = header->imuModel;
+    numSamples = header->numSamples;
+    ImuColumns columns = allocate(numSamples);
+    readColumn(file, table[0], columns.timeStamp, numSamples);
+    readColumn(file, table[1], columns.accx, numSamples);
+    readColumn(file, table[2], columns.accy, numSamples);
+    readColumn(file, table[3], columns.accz, numSamples);
+    readColumn(file, table[4], columns.gx, numSamples);
+    readColumn(file, table[5], columns.gy, numSamples);
+    readColumn(file, table[6], columns.gz, numSamples);
+    return true;
+}
+
+void writeImuCache(const std::string& sourceFileName, int imuModel, const ImuColumns& columns, size_t numSamples) {
+    writeCache(sourceFileName, cacheKindImu, imuModel, numSamples, {
+        stridedColumn(columnDouble, columns.timeStamp),
+        stridedColumn(columnDouble, columns.accx),
+        stridedColumn(columnDouble, columns.accy),
+        stridedColumn(columnDouble, columns.accz),
+        stridedColumn(columnDouble, columns.gx),
+        stridedColumn(columnDouble, columns.gy),
+        stridedColumn(columnDouble, columns.gz),
+    });
+}
+
+bool readGnssCache(const std::string& sourceFileName, GnssData& gnssData) {
+    MappedFile file;
+    const CacheHeader* header;
+    const CacheColumn* table;
+    if (!openCache(sourceFileName, cacheKindGnss, gnssColumnTypes, file, header, table)) {
+        return false;
+    }
+
+    readColumn(file, table[0], gnssData.time);
+    readColumn(file, table[1], gnssData.x);
+    readColumn(file, table[2], gnssData.y);
+    readColumn(file, table[3], gnssData.z);
+    readColumn(file, table[4], gnssData.lat);
+    readColumn(file, table[5], gnssData.lon);
+    readColumn(file, table[6], gnssData.alt);
+    readColumn(file, table[7], gnssData.fix);
+    return true;
+}
+
+void writeGnssCache(const std::string& sourceFileName, const GnssData& gnssData) {
+    static_assert(sizeof(int) == sizeof(int32_t), "GnssData::fix is stored as int32");
+    writeCache(sourceFileName, cacheKindGnss, 0, gnssData.time.size(), {
+        contiguousColumn(columnDouble, gnssData.time.data()),
+        contiguousColumn(columnDouble, gnssData.x.data()),
+        contiguousColumn(columnDouble, gnssData.y.data()),
+        contiguousColumn(columnDouble, gnssData.z.data()),
+        contiguousColumn(columnDouble, gnssData.lat.data()),
+        contiguousColumn(columnDouble, gnssData.lon.data()),
+        contiguousColumn(columnDouble, gnssData.alt.data()),
+        contiguousColumn(columnInt32, gnssData.fix.data()),
+    });
+}
+
+bool readGnssCache(const std::string& sourceFileName, const GnssColumnAllocator& allocate, size_t& numSamples) {
+    MappedFile file;
+    const CacheHeader* header;
+    const CacheColumn* table;
+    if (!openCache(sourceFileName, cacheKindGnss, gnssColumnTypes, file, header, table)) {
+        return false;
+    }
+
+    numSamples = header->numSamples;
+    GnssColumns columns = allocate(numSamples);
+    readColumn(file, table[0], columns.time, numSamples);
+    readColumn(file, table[1], columns.x, numSamples);
+    readColumn(file, table[2], columns.y, numSamples);
+    readColumn(file, table[3], columns.z, numSamples);
+    readColumn(file, table[4], columns.lat, numSamples);
+    readColumn(file, table[5], columns.lon, numSamples);
+    readColumn(file, table[6], columns.alt, numSamples);
+    readColumn(file, table[7], columns.fix, numSamples);
+    return true;
+}
+
+void writeGnssCache(const std::string& sourceFileName, const GnssColumns& columns, size_t numSamples) {
+    writeCache(sourceFileName, cacheKindGnss, 0, numSamples, {
+        stridedColumn(columnDouble, columns.time),
+        stridedColumn(columnDouble, columns.x),
+        stridedColumn(columnDouble, columns.y),
+        stridedColumn(columnDouble, columns.z),
+        stridedColumn(columnDouble, columns.lat),
+        stridedColumn(columnDouble, columns.lon),
+        stridedColumn(columnDouble, columns.alt),
+        stridedColumn(columnInt32, columns.fix),
+    });
+}
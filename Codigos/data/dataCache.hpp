@@ -0,0 +1,124 @@
+#ifndef DATA_CACHE_HPP
+#define DATA_CACHE_HPP
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include "columnSink.hpp"
+
+struct ImuData;
+struct GnssData;
+
+/**
+ * @brief How the loaders use the decoded-data cache stored next to the source file.
+ */
+enum class CacheMode {
+    Off, ///< Never read or write the cache
+    Use, ///< Read the cache if it is valid, otherwise decode the source and write it
+    Rebuild ///< Ignore any existing cache, decode the source and write a new cache
+};
+
+/**
+ * @brief Gets the name of the cache file of a source file.
+ *
+ * @param sourceFileName The name of the IMU (.bin) or GNSS (.pos) file.
+ * @return std::string The name of the cache file (source name plus ".cache").
+ */
+std::string cacheFileName(const std::string& sourceFileName);
+
+/**
+ * @brief Deletes the cache file of a source file, if there is one.
+ *
+ * @param sourceFileName The name of the IMU (.bin) or GNSS (.pos) file.
+ */
+void invalidateCache(const std::string& sourceFileName);
+
+/**
+ * @brief Reads decoded IMU data from the cache of a source file.
+ *
+ * The cache is valid if its format version matches and the size, modification
+ * time and content hash of the source file are the ones recorded when it was
+ * written. The hash covers the file size and its first and last MiB.
+ *
+ * @param sourceFileName The name of the IMU binary file.
+ * @param imuModel The IMU model. If 0, it is set to the cached model; otherwise it must match it.
+ * @param imuData The IMU data to fill.
+ * @return bool False if there is no valid cache.
+ */
+bool readImuCache(const std::string& sourceFileName, int& imuModel, ImuData& imuData);
+
+/**
+ * @brief Writes decoded IMU data to the cache of a source file.
+ *
+ * @param sourceFileName The name of the IMU binary file.
+ * @param imuModel The IMU model of the data.
+ * @param imuData The decoded IMU data.
+ * @throws std::runtime_error If the cache file cannot be written.
+ */
+void writeImuCache(const std::string& sourceFileName, int imuModel, const ImuData& imuData);
+
+/**
+ * @brief Reads decoded IMU data from the cache of a source file into caller-provided columns.
+ *
+ * @param sourceFileName The name of the IMU binary file.
+ * @param imuModel The IMU model. If 0, it is set to the cached model; otherwise it must match it.
+ * @param allocate Called once with the number of samples if the cache is valid.
+ * @param numSamples Output number of samples written.
+ * @return bool False if there is no valid cache; allocate is not called.
+ * @see readImuCache
+ */
+bool readImuCache(const std::string& sourceFileName, int& imuModel, const ImuColumnAllocator& allocate,
+                  size_t& numSamples);
+
+/**
+ * @brief Writes decoded IMU data held in caller-provided columns to the cache of a source file.
+ *
+ * @param sourceFileName The name of the IMU binary file.
+ * @param imuModel The IMU model of the data.
+ * @param columns The decoded IMU data.
+ * @param numSamples The number of samples.
+ * @throws std::runtime_error If the cache file cannot be written.
+ */
+void writeImuCache(const std::string& sourceFileName, int imuModel, const ImuColumns& columns, size_t numSamples);
+
+/**
+ * @brief Reads decoded GNSS data from the cache of a source file.
+ *
+ * @param sourceFileName The name of the GNSS .pos file.
+ * @param gnssData The GNSS data to fill.
+ * @return bool False if there is no valid cache.
+ * @see readImuCache
+ */
+bool readGnssCache(const std::string& sourceFileName, GnssData& gnssData);
+
+/**
+ * @brief Writes decoded GNSS data to the cache of a source file.
+ *
+ * @param sourceFileName The name of the GNSS .pos file.
+ * @param gnssData The decoded GNSS data.
+ * @throws std::runtime_error If the cache file cannot be written.
+ */
+void writeGnssCache(const std::string& sourceFileName, const GnssData& gnssData);
+
+/**
+ * @brief Reads decoded GNSS data from the cache of a source file into caller-provided columns.
+ *
+ * @param sourceFileName The name of the GNSS .pos file.
+ * @param allocate Called once with the number of samples if the cache is valid.
+ * @param numSamples Output number of samples written.
+ * @return bool False if there is no valid cache; allocate is not called.
+ * @see readImuCache
+ */
+bool readGnssCache(const std::string& sourceFileName, const GnssColumnAllocator& allocate, size_t& numSamples);
+
+/**
+ * @brief Writes decoded GNSS data held in caller-provided columns to the cache of a source file.
+ *
+ * @param sourceFileName The name of the GNSS .pos file.
+ * @param columns The decoded GNSS data.
+ * @param numSamples The number of samples.
+ * @throws std::runtime_error If the cache file cannot be written.
+ */
+void writeGnssCache(const std::string& sourceFileName, const GnssColumns& columns, size_t numSamples);
+
+#endif // DATA_CACHE_HPP
@@ -0,0 +1,162 @@
+#include "dataExport.hpp"
+#include "imuData.hpp"
+#include "gnssData.hpp"
+#include <charconv>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+// Linhas formatadas por bloco; cada thread formata um bloco por rodada
+const size_t blockRows = 1 << 16;
+
+// Maior número em notação fixa: sinal, 309 dígitos e o ponto decimal
+const size_t maxFixedChars = 311;
+
+struct ExportColumns {
+    std::vector<const double*> doubles; ///< Double columns, in output order
+    const int* fix = nullptr; ///< Optional integer last column
+};
+
+class RowFormatter {
+public:
+    RowFormatter(const ExportColumns& columns, ExportFormat format, int precision)
+        : columns_(columns), format_(format), precision_(precision),
+          separator_(format == ExportFormat::Csv ? ',' : '\t') {
+        size_t numColumns = columns.doubles.size() + (columns.fix ? 1 : 0);
+        maxRowBytes_ = format == ExportFormat::Binary ? numColumns * sizeof(double)
+                                                      : numColumns * (maxFixedChars + precision + 1);
+    }
+
+    size_t maxRowBytes() const { return maxRowBytes_; }
+
+    // Escreve a linha i em p e retorna o fim
+    char* format(size_t i, char* p, char* end) const {
+        if (format_ == ExportFormat::Binary) {
+            for (const double* column : columns_.doubles) {
+                std::memcpy(p, &column[i], sizeof(double));
+                p += sizeof(double);
+            }
+            if (columns_.fix) {
+                double fix = static_cast<double>(columns_.fix[i]);
+                std::memcpy(p, &fix, sizeof(double));
+                p += sizeof(double);
+            }
+            return p;
+        }
+
+        for (size_t c = 0; c < columns_.doubles.size(); ++c) {
+            if (c > 0) {
+                *p++ = separator_;
+            }
+            p = std::to_chars(p, end, columns_.doubles[c][i], std::chars_format::fixed, precision_).ptr;
+        }
+        if (columns_.fix) {
+            *p++ = separator_;
+            p = std::to_chars(p, end, columns_.fix[i]).ptr;
+        }
+        *p++ = '\n';
+        return p;
+    }
+
+private:
+    const ExportColumns& columns_;
+    ExportFormat format_;
+    int precision_;
+    char separator_;
+    size_t maxRowBytes_;
+};
+
+void formatBlock(const RowFormatter& formatter, size_t first, size_t last, std::vector<char>& buffer, size_t& used) {
+    used = 0;
+    for (size_t i = first; i < last; ++i) {
+        if (buffer.size() - used < formatter.maxRowBytes()) {
+            buffer.resize(std::max(buffer.size() * 2, used + formatter.maxRowBytes()));
+        }
+        used = formatter.format(i, buffer.data() + used, buffer.data() + buffer.size()) - buffer.data();
+    }
+}
+
+void exportColumns(const ExportColumns& columns, const std::string& header, int precision,
+                   const std::string& outputFileName, size_t initialIndex, size_t finalIndex,
+                   ExportFormat format, unsigned numThreads) {
+    // Texto continua em modo texto, como o operator<< fazia
+    std::ofstream outFile(outputFileName, format == ExportFormat::Binary ? std::ios::binary : std::ios::out);
+    if (!outFile) {
+        throw std::runtime_error("Error opening output file: " + outputFileName);
+    }
+
+    if (format != ExportFormat::Binary) {
+        std::string line = header;
+        if (format == ExportFormat::Csv) {
+            std::replace(line.begin(), line.end(), '\t', ',');
+        }
+        outFile << line << '\n';
+    }
+
+    if (numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    RowFormatter formatter(columns, format, precision);
+    std::vector<std::vector<char>> buffers(numThreads);
+    std::vector<size_t> used(numThreads);
+
+    for (size_t start = initialIndex; start < finalIndex; start += blockRows * numThreads) {
+        size_t numBlocks = std::min<size_t>(numThreads, (finalIndex - start + blockRows - 1) / blockRows);
+        auto formatOne = [&](size_t b) {
+            size_t first = start + b * blockRows;
+            formatBlock(formatter, first, std::min(first + blockRows, finalIndex), buffers[b], used[b]);
+        };
+
+        // Format disjoint blocks in parallel
+        if (numBlocks == 1) {
+            formatOne(0);
+        } else {
+            std::vector<std::thread> workers;
+            workers.reserve(numBlocks);
+            for (size_t b = 0; b < numBlocks; ++b) {
+                workers.emplace_back(formatOne, b);
+            }
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+        }
+
+        // Write them in order
+        for (size_t b = 0; b < numBlocks; ++b) {
+            outFile.write(buffers[b].data(), static_cast<std::streamsize>(used[b]));
+        }
+        if (!outFile) {
+            throw std::runtime_error("Error writing output file: " + outputFileName);
+        }
+    }
+}
+
+} // namespace
+
+void exportImuData(const ImuData& imuData, const std::string& outputFileName, size_t initialIndex, size_t finalIndex,
+                   ExportFormat format, unsigned numThreads) {
+    if (initialIndex > finalIndex || finalIndex > imuData.timeStamp.size()) {
+        throw std::invalid_argument("Invalid indices.");
+    }
+
+    ExportColumns columns;
+    columns.doubles = {imuData.timeStamp.data(), imuData.accx.data(), imuData.accy.data(), imuData.accz.data(),
+                       imuData.gx.data(), imuData.gy.data(), imuData.gz.data()};
+    exportColumns(columns, "TimeStamp\tAccX\tAccY\tAccZ\tGx\tGy\tGz", 9, outputFileName, initialIndex, finalIndex,
+                  format, numThreads);
+}
+
+void exportGnssData(const GnssData& gnssData, const std::string& outputFileName, size_t initialIndex, size_t finalIndex,
+                    ExportFormat format, unsigned numThreads) {
+    if (initialIndex > finalIndex || finalIndex > gnssData.time.size()) {
+        throw std::invalid_argument("Invalid indices.");
+    }
+
+    ExportColumns columns;
+    columns.doubles = {gnssData.time.data(), gnssData.x.data(), gnssData.y.data(), gnssData.z.data(),
+                       gnssData.lat.data(), gnssData.lon.data(), gnssData.alt.data()};
+    columns.fix = gnssData.fix.data();
+    exportColumns(columns, "Time\tX\tY\tZ\tLat\tLon\tAlt\tFix", 12, outputFileName, initialIndex, finalIndex,
+                  format, numThreads);
+}
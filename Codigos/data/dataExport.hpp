@@ -0,0 +1,47 @@
+#ifndef DATA_EXPORT_HPP
+#define DATA_EXPORT_HPP
+
+#include <string>
+#include <cstddef>
+
+struct ImuData;
+struct GnssData;
+
+/**
+ * @brief Output formats of the exporters.
+ */
+enum class ExportFormat {
+    Text, ///< Tab-separated text with a header line (layout of outputImuData/outputGnss)
+    Csv, ///< Comma-separated text with a header line, same precision as Text
+    Binary ///< Rows of little-endian doubles, no header (fix is written as a double)
+};
+
+/**
+ * @brief Exports IMU data to a file.
+ *
+ * Rows are formatted with std::to_chars in fixed notation with 9 decimals.
+ * Blocks of rows are formatted in parallel and written in order with large writes.
+ *
+ * @param imuData The IMU data to export.
+ * @param outputFileName The name of the file to write.
+ * @param initialIndex The initial index of the data to output.
+ * @param finalIndex One past the final index of the data to output.
+ * @param format The output format.
+ * @param numThreads Number of formatting threads. If 0, all hardware threads are used.
+ * @throws std::invalid_argument If the indices are out of range.
+ * @throws std::runtime_error If there is an error writing the output file.
+ */
+void exportImuData(const ImuData& imuData, const std::string& outputFileName, size_t initialIndex, size_t finalIndex,
+                   ExportFormat format = ExportFormat::Text, unsigned numThreads = 0);
+
+/**
+ * @brief Exports GNSS data to a file.
+ *
+ * Same as exportImuData, with 12 decimals.
+ *
+ * @see exportImuData
+ */
+void exportGnssData(const GnssData& gnssData, const std::string& outputFileName, size_t initialIndex, size_t finalIndex,
+                    ExportFormat format = ExportFormat::Text, unsigned numThreads = 0);
+
+#endif // DATA_EXPORT_HPP
@@ -0,0 +1,60 @@
+#ifndef DATA_LOG_HPP
+#define DATA_LOG_HPP
+
+#include <iostream>
+
+namespace dataLogDetail {
+inline thread_local std::ostream* logStream = nullptr;
+inline thread_local std::ostream* errorStream = nullptr;
+} // namespace dataLogDetail
+
+/**
+ * @brief Stream the loaders write progress and logs to on the calling thread.
+ *
+ * std::cout unless redirected with ScopedDataLog.
+ */
+inline std::ostream& dataLog() {
+    return dataLogDetail::logStream ? *dataLogDetail::logStream : std::cout;
+}
+
+/**
+ * @brief Stream the loaders write warnings to on the calling thread.
+ *
+ * std::cerr unless redirected with ScopedDataLog.
+ */
+inline std::ostream& dataErrors() {
+    return dataLogDetail::errorStream ? *dataLogDetail::errorStream : std::cerr;
+}
+
+/**
+ * @brief Redirects dataLog() and dataErrors() of the calling thread while in scope.
+ *
+ * Lets loads running on different threads keep their output apart.
+ */
+class ScopedDataLog {
+public:
+    /**
+     * @brief Sends the logs and the warnings to the same stream.
+     */
+    explicit ScopedDataLog(std::ostream& out) : ScopedDataLog(out, out) {}
+
+    ScopedDataLog(std::ostream& out, std::ostream& errors)
+        : previousLog_(dataLogDetail::logStream), previousErrors_(dataLogDetail::errorStream) {
+        dataLogDetail::logStream = &out;
+        dataLogDetail::errorStream = &errors;
+    }
+
+    ~ScopedDataLog() {
+        dataLogDetail::logStream = previousLog_;
+        dataLogDetail::errorStream = previousErrors_;
+    }
+
+    ScopedDataLog(const ScopedDataLog&) = delete;
+    ScopedDataLog& operator=(const ScopedDataLog&) = delete;
+
+private:
+    std::ostream* previousLog_;
+    std::ostream* previousErrors_;
+};
+
+#endif // DATA_LOG_HPP
@@ -0,0 +1,178 @@
+#include "dataProfile.hpp"
+#include <mutex>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+namespace {
+
+// Contadores de alocação da thread atual (tipos triviais: seguros dentro do operator new)
+thread_local uint64_t threadAllocations = 0;
+thread_local uint64_t threadAllocatedBytes = 0;
+
+// Carga em andamento na thread atual
+thread_local DataProfileLoad* currentLoad = nullptr;
+
+// Etapas na ordem em que rodaram pela primeira vez; são poucas, então a busca é linear
+std::mutex profileMutex;
+std::vector<StageProfile> profileStages;
+
+StageProfile& stage(std::vector<StageProfile>& stages, const char* name) {
+    for (StageProfile& s : stages) {
+        if (s.name == name) {
+            return s;
+        }
+    }
+    stages.emplace_back();
+    stages.back().name = name;
+    return stages.back();
+}
+
+// Soma uma execução (timed) ou só uma contagem a uma etapa
+void addRun(std::vector<StageProfile>& stages, const char* name, uint64_t ns, uint64_t records, uint64_t bytes,
+            uint64_t allocations, uint64_t allocatedBytes, bool timed) {
+    StageProfile& s = stage(stages, name);
+    ++s.calls;
+    if (timed) {
+        s.totalNs += ns;
+        s.maxNs = std::max(s.maxNs, ns);
+    }
+    s.records += records;
+    s.bytes += bytes;
+    s.allocations += allocations;
+    s.allocatedBytes += allocatedBytes;
+}
+
+std::vector<StageProfile> withPrefix(const std::vector<StageProfile>& stages, const std::string& prefix) {
+    std::vector<StageProfile> report;
+    for (const StageProfile& s : stages) {
+        if (s.name.compare(0, prefix.size(), prefix) == 0) {
+            report.push_back(s);
+        }
+    }
+    return report;
+}
+
+} // namespace
+
+DataProfileLoad::DataProfileLoad() : previous_(currentLoad) {
+    currentLoad = this;
+}
+
+DataProfileLoad::~DataProfileLoad() {
+    currentLoad = previous_;
+}
+
+std::vector<StageProfile> DataProfileLoad::report(const std::string& prefix) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return withPrefix(stages_, prefix);
+}
+
+DataProfileLoad* DataProfileLoad::current() {
+    return currentLoad;
+}
+
+void DataProfileLoad::record(const char* name, uint64_t ns, uint64_t records, uint64_t bytes, uint64_t allocations,
+                             uint64_t allocatedBytes, bool timed) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    addRun(stages_, name, ns, records, bytes, allocations, allocatedBytes, timed);
+}
+
+DataProfileAttach::DataProfileAttach(DataProfileLoad* load) : previous_(currentLoad) {
+    currentLoad = load;
+}
+
+DataProfileAttach::~DataProfileAttach() {
+    currentLoad = previous_;
+}
+
+ProfileScope::ProfileScope(const char* name)
+    : name_(name), allocations0_(threadAllocations), allocatedBytes0_(threadAllocatedBytes) {
+    start_ = std::chrono::steady_clock::now();
+}
+
+void ProfileScope::stop() {
+    if (!running_) {
+        return;
+    }
+    running_ = false;
+    uint64_t ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count());
+    uint64_t allocations = threadAllocations - allocations0_;
+    uint64_t allocatedBytes = threadAllocatedBytes - allocatedBytes0_;
+
+    if (currentLoad) {
+        currentLoad->record(name_, ns, records_, bytes_, allocations, allocatedBytes, true);
+    }
+    std::lock_guard<std::mutex> lock(profileMutex);
+    addRun(profileStages, name_, ns, records_, bytes_, allocations, allocatedBytes, true);
+}
+
+void dataProfileCount(const char* name, uint64_t records, uint64_t bytes) {
+    if (currentLoad) {
+        currentLoad->record(name, 0, records, bytes, 0, 0, false);
+    }
+    std::lock_guard<std::mutex> lock(profileMutex);
+    addRun(profileStages, name, 0, records, bytes, 0, 0, false);
+}
+
+void dataProfileNoteAllocation(size_t bytes) {
+    ++threadAllocations;
+    threadAllocatedBytes += bytes;
+}
+
+std::vector<StageProfile> dataProfileReport(const std::string& prefix) {
+    std::lock_guard<std::mutex> lock(profileMutex);
+    return withPrefix(profileStages, prefix);
+}
+
+std::vector<StageProfile> dataProfileLoadReport(const std::string& prefix) {
+    return currentLoad ? currentLoad->report(prefix) : dataProfileReport(prefix);
+}
+
+void resetDataProfile() {
+    std::lock_guard<std::mutex> lock(profileMutex);
+    profileStages.clear();
+}
+
+std::string formatDataProfile(const std::vector<StageProfile>& report) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(3);
+    for (const StageProfile& s : report) {
+        oss << "Stage " << s.name << ": " << s.calls << " calls, " << s.seconds() * 1e3 << " ms";
+        if (s.calls > 1) {
+            oss << " (max " << s.maxNs / 1e6 << " ms)";
+        }
+        if (s.records > 0) {
+            oss << ", " << s.records << " records";
+        }
+        if (s.bytes > 0) {
+            oss << ", " << s.bytes << " bytes";
+            if (s.totalNs > 0) {
+                oss << " (" << s.bytes / s.seconds() / 1e6 << " MB/s)";
+            }
+        }
+        if (s.allocations > 0) {
+            oss << ", " << s.allocations << " allocations (" << s.allocatedBytes << " bytes)";
+        }
+        oss << "\n";
+    }
+    if (!report.empty()) {
+        oss << "\n";
+    }
+    return oss.str();
+}
+
+std::string dataProfileJson(const std::vector<StageProfile>& report) {
+    std::ostringstream oss;
+    oss << "{\"stages\": [";
+    for (size_t i = 0; i < report.size(); ++i) {
+        const StageProfile& s = report[i];
+        oss << (i ? ", " : "") << "{\"name\": \"" << s.name << "\", \"calls\": " << s.calls
+            << ", \"totalNs\": " << s.totalNs << ", \"maxNs\": " << s.maxNs << ", \"records\": " << s.records
+            << ", \"bytes\": " << s.bytes << ", \"allocations\": " << s.allocations
+            << ", \"allocatedBytes\": " << s.allocatedBytes << "}";
+    }
+    oss << "]}";
+    return oss.str();
+}
@@ -0,0 +1,217 @@
+#ifndef DATA_PROFILE_HPP
+#define DATA_PROFILE_HPP
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <mutex>
+
+/**
+ * @brief Accumulated measurements of one stage of the loaders.
+ *
+ * A stage that runs on several threads at once (e.g. gnss.parse) adds the time
+ * of every thread, so its seconds can exceed the wall-clock time of the load.
+ */
+struct StageProfile {
+    std::string name; ///< Stage name, e.g. "imu.decode"
+    uint64_t calls = 0; ///< Number of times the stage ran
+    uint64_t totalNs = 0; ///< Total time in nanoseconds
+    uint64_t maxNs = 0; ///< Longest single run in nanoseconds
+    uint64_t records = 0; ///< Records processed
+    uint64_t bytes = 0; ///< Bytes processed
+    uint64_t allocations = 0; ///< Heap allocations made by the stage's thread (see dataProfileNoteAllocation)
+    uint64_t allocatedBytes = 0; ///< Bytes of those allocations
+
+    double seconds() const { return totalNs / 1e9; } ///< Total time in seconds
+};
+
+/**
+ * @brief Times a stage from construction until stop() or destruction.
+ *
+ * Use it through DATA_PROFILE_SCOPE, which compiles to nothing unless DATA_PROFILE is defined.
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name);
+    ~ProfileScope() { stop(); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+    /**
+     * @brief Adds to the records and bytes processed by the stage.
+     */
+    void add(uint64_t records, uint64_t bytes) {
+        records_ += records;
+        bytes_ += bytes;
+    }
+
+    /**
+     * @brief Ends the stage and adds its measurements to the report. Later calls do nothing.
+     */
+    void stop();
+
+private:
+    const char* name_;
+    std::chrono::steady_clock::time_point start_;
+    uint64_t records_ = 0;
+    uint64_t bytes_ = 0;
+    uint64_t allocations0_;
+    uint64_t allocatedBytes0_;
+    bool running_ = true;
+};
+
+/**
+ * @brief Measurements of a single load, for its log.
+ *
+ * While it exists, the stages that run on the thread that created it (and on
+ * threads attached with DataProfileAttach) are also recorded here, besides the
+ * process-wide report. The log of a load then shows only its own stages, even
+ * after earlier loads or next to concurrent ones (ingestSessions). Loads can
+ * nest; the innermost one records.
+ *
+ * Use it through DATA_PROFILE_LOAD, which compiles to nothing unless DATA_PROFILE is defined.
+ */
+class DataProfileLoad {
+public:
+    DataProfileLoad();
+    ~DataProfileLoad();
+
+    DataProfileLoad(const DataProfileLoad&) = delete;
+    DataProfileLoad& operator=(const DataProfileLoad&) = delete;
+
+    /**
+     * @brief Gets the stages of this load whose name starts with prefix, in the order they first ran.
+     */
+    std::vector<StageProfile> report(const std::string& prefix = "") const;
+
+    /**
+     * @brief Gets the load of the calling thread (nullptr if none).
+     */
+    static DataProfileLoad* current();
+
+private:
+    friend class ProfileScope;
+    friend void dataProfileCount(const char* name, uint64_t records, uint64_t bytes);
+
+    void record(const char* name, uint64_t ns, uint64_t records, uint64_t bytes, uint64_t allocations,
+                uint64_t allocatedBytes, bool timed);
+
+    DataProfileLoad* previous_;
+    mutable std::mutex mutex_;
+    std::vector<StageProfile> stages_;
+};
+
+/**
+ * @brief Makes a load (from DataProfileLoad::current() on the thread that started it) current on a worker thread.
+ */
+class DataProfileAttach {
+public:
+    explicit DataProfileAttach(DataProfileLoad* load);
+    ~DataProfileAttach();
+
+    DataProfileAttach(const DataProfileAttach&) = delete;
+    DataProfileAttach& operator=(const DataProfileAttach&) = delete;
+
+private:
+    DataProfileLoad* previous_;
+};
+
+/**
+ * @brief Adds records and bytes to a stage without timing it.
+ */
+void dataProfileCount(const char* name, uint64_t records, uint64_t bytes);
+
+/**
+ * @brief Counts a heap allocation of the calling thread.
+ *
+ * The library does not replace the global operator new (a MEX file must not);
+ * an executable that wants allocation counts per stage calls this from its own
+ * replacement, for instance by expanding DATA_PROFILE_COUNT_NEW in one file.
+ */
+void dataProfileNoteAllocation(size_t bytes);
+
+/**
+ * @brief Gets the measurements of every stage, in the order the stages first ran.
+ *
+ * @param prefix Only stages whose name starts with it are returned (e.g. "imu.").
+ */
+std::vector<StageProfile> dataProfileReport(const std::string& prefix = "");
+
+/**
+ * @brief Gets the stages of the current load (DataProfileLoad) or, without one, of the whole process.
+ */
+std::vector<StageProfile> dataProfileLoadReport(const std::string& prefix = "");
+
+/**
+ * @brief Clears all measurements.
+ */
+void resetDataProfile();
+
+/**
+ * @brief Formats a report as text, in the style of the log of the loaders.
+ */
+std::string formatDataProfile(const std::vector<StageProfile>& report);
+
+/**
+ * @brief Formats a report as a JSON object {"stages": [...]}.
+ */
+std::string dataProfileJson(const std::vector<StageProfile>& report);
+
+#ifdef DATA_PROFILE
+
+constexpr bool dataProfileEnabled = true;
+
+/// Declares a ProfileScope named var that times the stage name
+#define DATA_PROFILE_SCOPE(var, name) ProfileScope var(name)
+/// Adds records and bytes to the stage timed by var
+#define DATA_PROFILE_ADD(var, records, bytes) (var).add((records), (bytes))
+/// Ends the stage timed by var before the end of its block
+#define DATA_PROFILE_STOP(var) (var).stop()
+/// Adds records and bytes to a stage without timing it
+#define DATA_PROFILE_COUNT(name, records, bytes) dataProfileCount((name), (records), (bytes))
+/// Starts the measurements of one load (see DataProfileLoad), until the end of the block
+#define DATA_PROFILE_LOAD(var) DataProfileLoad var
+/// Declares var as the load of this thread, to be attached on worker threads
+#define DATA_PROFILE_CAPTURE(var) DataProfileLoad* var = DataProfileLoad::current()
+/// Attaches the load captured in var to this thread until the end of the block
+#define DATA_PROFILE_ATTACH(var) DataProfileAttach var##Attach(var)
+/// Writes the stages of the current load starting with prefix to dataLog() (process-wide without a load)
+#define DATA_PROFILE_LOG(prefix) (dataLog() << formatDataProfile(dataProfileLoadReport(prefix)))
+
+#else
+
+constexpr bool dataProfileEnabled = false;
+
+#define DATA_PROFILE_SCOPE(var, name) ((void)0)
+#define DATA_PROFILE_ADD(var, records, bytes) ((void)0)
+#define DATA_PROFILE_STOP(var) ((void)0)
+#define DATA_PROFILE_COUNT(name, records, bytes) ((void)0)
+#define DATA_PROFILE_LOAD(var) ((void)0)
+#define DATA_PROFILE_CAPTURE(var) ((void)0)
+#define DATA_PROFILE_ATTACH(var) ((void)0)
+#define DATA_PROFILE_LOG(prefix) ((void)0)
+
+#endif
+
+/// Replaces the global operator new/delete of an executable with versions that
+/// call dataProfileNoteAllocation. Expand it once, at namespace scope, in one file.
+#define DATA_PROFILE_COUNT_NEW                                                      \
+    void* operator new(size_t size) {                                               \
+        dataProfileNoteAllocation(size);                                            \
+        if (void* p = std::malloc(size ? size : 1)) {                               \
+            return p;                                                               \
+        }                                                                           \
+        throw std::bad_alloc();                                                     \
+    }                                                                               \
+    void* operator new[](size_t size) { return operator new(size); }                \
+    void operator delete(void* p) noexcept { std::free(p); }                        \
+    void operator delete[](void* p) noexcept { std::free(p); }                      \
+    void operator delete(void* p, size_t) noexcept { std::free(p); }                \
+    void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+#endif // DATA_PROFILE_HPP
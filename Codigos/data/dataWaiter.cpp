@@ -0,0 +1,78 @@
+#include "dataWaiter.hpp"
+
+size_t DataWaiter::addImu(const ImuData& imuData) {
+    return addSensor(SensorType::Imu, &imuData, imuData.timeStamp);
+}
+
+size_t DataWaiter::addGnss(const GnssData& gnssData) {
+    return addSensor(SensorType::Gnss, &gnssData, gnssData.time);
+}
+
+size_t DataWaiter::addSensor(SensorType type, const void* data, const std::vector<double>& time) {
+    size_t sensor = sensors_.size();
+    sensors_.push_back({type, data, time.data(), time.size(), 0});
+    if (!time.empty()) {
+        heap_.push({time[0], sensor});
+    }
+    return sensor;
+}
+
+bool DataWaiter::popNext(Measurement& measurement) {
+    if (heap_.empty()) {
+        measurement = Measurement();
+        return false;
+    }
+
+    // Oldest measurement across all sensors
+    size_t sensorIdx = heap_.top().second;
+    heap_.pop();
+    Sensor& sensor = sensors_[sensorIdx];
+
+    measurement.type = sensor.type;
+    measurement.sensor = sensorIdx;
+    measurement.index = sensor.next;
+    measurement.time = sensor.time[sensor.next];
+
+    // Increment the pointer for the sensor we just read
+    ++sensor.next;
+    if (sensor.next < sensor.size) {
+        heap_.push({sensor.time[sensor.next], sensorIdx});
+    }
+    return true;
+}
+
+size_t DataWaiter::popSorted(size_t k, std::vector<Measurement>& measurements) {
+    measurements.clear();
+    measurements.reserve(k);
+    Measurement measurement;
+    while (measurements.size() < k && popNext(measurement)) {
+        measurements.push_back(measurement);
+    }
+    return measurements.size();
+}
+
+void DataWaiter::reset() {
+    heap_ = Heap();
+    for (size_t i = 0; i < sensors_.size(); ++i) {
+        sensors_[i].next = 0;
+        if (sensors_[i].size > 0) {
+            heap_.push({sensors_[i].time[0], i});
+        }
+    }
+}
+
+const ImuData& DataWaiter::imuData(size_t sensor) const {
+    const Sensor& s = sensors_.at(sensor);
+    if (s.type != SensorType::Imu) {
+        throw std::invalid_argument("Sensor " + std::to_string(sensor) + " is not an IMU.");
+    }
+    return *static_cast<const ImuData*>(s.data);
+}
+
+const GnssData& DataWaiter::gnssData(size_t sensor) const {
+    const Sensor& s = sensors_.at(sensor);
+    if (s.type != SensorType::Gnss) {
+        throw std::invalid_argument("Sensor " + std::to_string(sensor) + " is not a GNSS.");
+    }
+    return *static_cast<const GnssData*>(s.data);
+}
@@ -0,0 +1,111 @@
+#ifndef DATA_WAITER_HPP
+#define DATA_WAITER_HPP
+
+#include <vector>
+#include <queue>
+#include <functional>
+#include <stdexcept>
+#include "imuData.hpp"
+#include "gnssData.hpp"
+
+/**
+ * @brief Type of a sensor in the DataWaiter (same codes as DataWaiter.m).
+ */
+enum class SensorType {
+    None = -1, ///< No data
+    Imu = 1, ///< IMU data (ImuData)
+    Gnss = 2 ///< GNSS data (GnssData)
+};
+
+/**
+ * @brief View of one measurement: the sensor it comes from and its row in that sensor's data.
+ */
+struct Measurement {
+    SensorType type = SensorType::None; ///< Type of the sensor
+    size_t sensor = 0; ///< Index of the sensor in the DataWaiter
+    size_t index = 0; ///< Row of the measurement in the sensor's data
+    double time = 0.0; ///< Timestamp of the measurement in seconds
+};
+
+/**
+ * @brief Plays back IMU and GNSS data in time order.
+ *
+ * C++ counterpart of DataWaiter.m. The sensors' time columns are already sorted,
+ * so a k-way merge with a heap holding the next timestamp of each sensor replaces
+ * the sorted queue of all measurements. Memory is O(number of sensors) and each
+ * pop is O(log number of sensors). Ties are resolved in favour of the sensor
+ * added first.
+ *
+ * The data is not copied: the ImuData and GnssData objects must outlive the DataWaiter.
+ */
+class DataWaiter {
+public:
+    /**
+     * @brief Adds an IMU sensor.
+     *
+     * @param imuData The IMU data, with increasing timestamps.
+     * @return size_t The index of the sensor.
+     */
+    size_t addImu(const ImuData& imuData);
+
+    /**
+     * @brief Adds a GNSS sensor.
+     *
+     * @param gnssData The GNSS data, with increasing times.
+     * @return size_t The index of the sensor.
+     */
+    size_t addGnss(const GnssData& gnssData);
+
+    /**
+     * @brief Returns the oldest measurement and advances its sensor.
+     *
+     * @param measurement The oldest measurement. Its type is SensorType::None if there is no data left.
+     * @return bool False if there is no data left.
+     */
+    bool popNext(Measurement& measurement);
+
+    /**
+     * @brief Returns the oldest k measurements in time order.
+     *
+     * @param k The maximum number of measurements to return.
+     * @param measurements The measurements. Cleared before filling.
+     * @return size_t The number of measurements returned (less than k at the end of the data).
+     */
+    size_t popSorted(size_t k, std::vector<Measurement>& measurements);
+
+    /**
+     * @brief Rewinds all sensors to their first measurement.
+     */
+    void reset();
+
+    /**
+     * @brief Checks if all measurements have been returned.
+     */
+    bool empty() const { return heap_.empty(); }
+
+    size_t numSensors() const { return sensors_.size(); } ///< Number of sensors
+    SensorType sensorType(size_t sensor) const { return sensors_.at(sensor).type; } ///< Type of a sensor
+    size_t dataPtr(size_t sensor) const { return sensors_.at(sensor).next; } ///< Next row of a sensor
+    const ImuData& imuData(size_t sensor) const; ///< IMU data of a sensor; throws if it is not an IMU
+    const GnssData& gnssData(size_t sensor) const; ///< GNSS data of a sensor; throws if it is not a GNSS
+
+private:
+    struct Sensor {
+        SensorType type;
+        const void* data;
+        const double* time;
+        size_t size;
+        size_t next;
+    };
+
+    // Próximo instante de cada sensor; o menor fica no topo
+    using HeapEntry = std::pair<double, size_t>;
+    using Heap = std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<HeapEntry>>;
+
+    size_t addSensor(SensorType type, const void* data, const std::vector<double>& time);
+
+    std::vector<Sensor> sensors_;
+    Heap heap_;
+};
+
+#endif // DATA_WAITER_HPP
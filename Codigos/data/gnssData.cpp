@@ -1,128 +1,378 @@
 #include "gnssData.hpp"
+#include "logStats.hpp"
+#include "dataProfile.hpp"
 
 
-GnssData loadGnssData(const std::string& fileName, bool logData) {
-    // Open the file for reading
-    std::ifstream file(fileName);
-    if (!file) {
-        throw std::runtime_error("Error opening file: " + fileName);
+namespace {
+
+// Mesmo conjunto de espaços em branco que o operator>> usa no locale "C"
+inline bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+inline const char* skipBlanks(const char* p, const char* end) {
+    while (p != end && isBlank(*p)) {
+        ++p;
     }
+    return p;
+}
 
-    // Temporary vectors to store the read data
-    std::vector<double> time, x, y, z;
-    std::vector<int> fix;
+// Lê um número como o operator>> de std::istream: aceita '+' inicial e
+// rejeita inf/nan, que std::from_chars aceitaria
+template <typename T>
+bool parseField(const char*& p, const char* end, T& value) {
+    p = skipBlanks(p, end);
+    const char* first = p;
+    if (first != end && *first == '+') {
+        ++first;
+        if (first != end && *first == '-') {
+            return false;
+        }
+    }
+    // Depois do sinal tem de vir um dígito ou '.', senão "-inf" e "-nan" passariam
+    const char* digits = first != end && *first == '-' ? first + 1 : first;
+    if (digits == end || !(std::isdigit(static_cast<unsigned char>(*digits)) || *digits == '.')) {
+        return false;
+    }
+    auto [ptr, ec] = std::from_chars(first, end, value);
+    if constexpr (std::is_floating_point<T>::value) {
+        if (ec == std::errc::result_out_of_range) {
+            // Underflow é aceito pelo istream; overflow não
+            std::string token(first, ptr);
+            double v = std::strtod(token.c_str(), nullptr);
+            if (!std::isfinite(v)) {
+                return false;
+            }
+            value = v;
+            ec = std::errc();
+        }
+    }
+    if (ec != std::errc()) {
+        return false;
+    }
+    p = ptr;
+    return true;
+}
 
-    std::cout << "Loading GNSS data from " << fileName << "...\n";
+// Chama onLine(t, x, y, z, fix) para cada linha válida de texto de solução do RTKLIB
+template <typename OnLine>
+void forEachSolution(const char* begin, const char* end, const OnLine& onLine) {
+    const char* lineBegin = begin;
+    while (lineBegin < end) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(lineBegin, '\n', end - lineBegin));
+        if (lineEnd == nullptr) {
+            lineEnd = end;
+        }
+        const char* p = lineBegin;
+        lineBegin = lineEnd + 1;
 
-    // Read the data from the file
-    std::string line;
-    while (std::getline(file, line)) {
         // Skip lines that start with '%' or are empty
-        if (line.empty() || line[0] == '%') {
+        if (p == lineEnd || *p == '%') {
+            continue;
+        }
+
+        // Skip the first column (GPST week)
+        p = skipBlanks(p, lineEnd);
+        if (p == lineEnd) {
             continue;
         }
+        while (p != lineEnd && !isBlank(*p)) {
+            ++p;
+        }
 
-        std::istringstream iss(line);
+        // Read the relevant columns; lines without all fields are skipped
         double t, xVal, yVal, zVal;
         int fixVal;
-        std::string temp;
-
-        // Read the first column (GPST) and ignore it
-        iss >> temp;
-
-        // Read the relevant columns
-        if (iss >> t >> xVal >> yVal >> zVal >> fixVal) {
-            time.push_back(t);
-            x.push_back(xVal);
-            y.push_back(yVal);
-            z.push_back(zVal);
-            fix.push_back(fixVal);
-        } else {
-            // If the line does not have the correct number of fields, skip it
-            continue;
+        if (parseField(p, lineEnd, t) && parseField(p, lineEnd, xVal) && parseField(p, lineEnd, yVal) &&
+            parseField(p, lineEnd, zVal) && parseField(p, lineEnd, fixVal)) {
+            onLine(t, xVal, yVal, zVal, fixVal);
         }
     }
+}
 
-    // Close the file
-    file.close();
+// Tamanho mínimo de um bloco para valer a pena criar uma thread
+const size_t minChunkBytes = 1 << 20;
+
+// Lê um trecho de texto, reservando as colunas pelo número de linhas
+void parseLines(const char* begin, const char* end, GnssData& gnssData) {
+    DATA_PROFILE_SCOPE(parse, "gnss.parse");
+    size_t numLines = std::count(begin, end, '\n') + 1;
+    gnssData.time.reserve(numLines);
+    gnssData.x.reserve(numLines);
+    gnssData.y.reserve(numLines);
+    gnssData.z.reserve(numLines);
+    gnssData.fix.reserve(numLines);
+
+    parseGnssText(begin, end, gnssData);
+    DATA_PROFILE_ADD(parse, gnssData.time.size(), static_cast<uint64_t>(end - begin));
+}
 
-    // Vectors to store geodetic coordinates
-    std::vector<double> lat, lon, alt;
+// Lê um trecho de texto e converte as coordenadas para geodésicas
+void parseAndConvert(const char* begin, const char* end, GnssData& gnssData) {
+    parseLines(begin, end, gnssData);
 
     // Convert ECEF coordinates to geodetic
-    llaFromEcef(x, y, z, lat, lon, alt);
+    DATA_PROFILE_SCOPE(lla, "gnss.llaFromEcef");
+    DATA_PROFILE_ADD(lla, gnssData.x.size(), 0);
+    llaFromEcef(gnssData.x, gnssData.y, gnssData.z, gnssData.lat, gnssData.lon, gnssData.alt);
+}
 
-    // Create and fill the GnssData object
-    GnssData gnssData;
-    gnssData.time = time;
-    gnssData.x = x;
-    gnssData.y = y;
-    gnssData.z = z;
-    gnssData.lat = lat;
-    gnssData.lon = lon;
-    gnssData.alt = alt;
-    gnssData.fix = fix;
+// Divide o texto em blocos de pelo menos minChunkBytes que começam no início de uma linha
+std::vector<const char*> splitLines(const char* begin, const char* end, unsigned numThreads) {
+    size_t size = end - begin;
+    if (numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t numChunks = std::min<size_t>(numThreads, std::max<size_t>(size / minChunkBytes, 1));
+
+    std::vector<const char*> bounds(numChunks + 1);
+    bounds[0] = begin;
+    bounds[numChunks] = end;
+    for (size_t c = 1; c < numChunks; ++c) {
+        const char* p = std::max(begin + size / numChunks * c, bounds[c - 1]);
+        const char* newline = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        bounds[c] = newline ? newline + 1 : end;
+    }
+    return bounds;
+}
 
-    // Log the GNSS data if requested
-    if (logData) {
-        logGnss(gnssData);
+// Executa work(c) para cada bloco, um por thread, e relança o erro do
+// primeiro bloco que falhou, como faria a leitura sequencial
+template <typename Work>
+void forEachChunk(size_t numChunks, const Work& work) {
+    if (numChunks == 1) {
+        work(0);
+        return;
+    }
+    std::vector<std::exception_ptr> errors(numChunks);
+    std::vector<std::thread> workers;
+    workers.reserve(numChunks);
+    DATA_PROFILE_CAPTURE(load);
+    for (size_t c = 0; c < numChunks; ++c) {
+        workers.emplace_back([&, c]() {
+            DATA_PROFILE_ATTACH(load);
+            try {
+                work(c);
+            } catch (...) {
+                errors[c] = std::current_exception();
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
     }
+}
 
-    std::cout << std::flush;
+// Conta as linhas válidas de um trecho de texto
+size_t countLines(const char* begin, const char* end) {
+    DATA_PROFILE_SCOPE(count, "gnss.count");
+    size_t numLines = 0;
+    forEachSolution(begin, end, [&](double, double, double, double, int) { ++numLines; });
+    DATA_PROFILE_ADD(count, numLines, static_cast<uint64_t>(end - begin));
+    return numLines;
+}
 
-    return gnssData;
+// Lê um trecho de texto direto nas colunas de destino a partir da linha first,
+// convertendo as coordenadas para geodésicas
+void parseInto(const char* begin, const char* end, size_t first, const GnssColumns& columns) {
+    DATA_PROFILE_SCOPE(parse, "gnss.parse");
+    size_t row = first;
+    forEachSolution(begin, end, [&](double t, double xVal, double yVal, double zVal, int fixVal) {
+        columns.time[row] = t;
+        columns.x[row] = xVal;
+        columns.y[row] = yVal;
+        columns.z[row] = zVal;
+        columns.fix[row] = fixVal;
+        llaFromEcefPoint(xVal, yVal, zVal, columns.lat[row], columns.lon[row], columns.alt[row]);
+        ++row;
+    });
+    DATA_PROFILE_ADD(parse, row - first, static_cast<uint64_t>(end - begin));
 }
 
-void logGnss(const GnssData& gnssData) {
-    // Obter a string de log
-    std::string logStr = getLogStream(gnssData);
+template <typename T>
+void appendColumn(std::vector<T>& column, const std::vector<T>& part) {
+    column.insert(column.end(), part.begin(), part.end());
+}
 
-    // Exibir a string usando std::cout
-    std::cout << logStr;
+} // namespace
+
+void parseGnssText(const char* begin, const char* end, GnssData& gnssData) {
+    forEachSolution(begin, end, [&](double t, double xVal, double yVal, double zVal, int fixVal) {
+        gnssData.time.push_back(t);
+        gnssData.x.push_back(xVal);
+        gnssData.y.push_back(yVal);
+        gnssData.z.push_back(zVal);
+        gnssData.fix.push_back(fixVal);
+    });
 }
 
+GnssData loadGnssData(const std::string& fileName, bool logData, unsigned numThreads, CacheMode cache) {
+    // Etapas desta carga, para o seu log
+    DATA_PROFILE_LOAD(profile);
+    dataLog() << "Loading GNSS data from " << fileName << "...\n";
+
+    // Use the decoded data from a previous load if it is still valid
+    if (cache == CacheMode::Use) {
+        GnssData gnssData;
+        DATA_PROFILE_SCOPE(cacheRead, "gnss.cache.read");
+        bool cached = readGnssCache(fileName, gnssData);
+        DATA_PROFILE_ADD(cacheRead, gnssData.time.size(), gnssData.time.size() * 8 * sizeof(double));
+        DATA_PROFILE_STOP(cacheRead);
+        if (cached) {
+            if (logData) {
+                logGnss(gnssData);
+                DATA_PROFILE_LOG("gnss.");
+            }
+            dataLog() << std::flush;
+            return gnssData;
+        }
+    }
+
+    // Map the file for reading
+    DATA_PROFILE_SCOPE(read, "gnss.read");
+    MappedFile file(fileName);
 
-// Função getLogStream
-std::string getLogStream(const GnssData &gnssData) {
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(2);
+    const char* begin = file.data();
+    const char* end = begin + file.size();
 
-    if (!gnssData.time.empty()) {
-        size_t gnssSamples = gnssData.time.size();
+    std::vector<const char*> bounds = splitLines(begin, end, numThreads);
+    size_t numChunks = bounds.size() - 1;
+    DATA_PROFILE_ADD(read, 0, file.size());
+    DATA_PROFILE_STOP(read);
 
-        // Verificar se há dados suficientes para calcular diferenças
-        if (gnssSamples < 2) {
-            oss << "Not enough GNSS data to calculate statistics.\n";
-            return oss.str();
+    GnssData gnssData;
+    if (numChunks == 1) {
+        parseAndConvert(begin, end, gnssData);
+    } else {
+        // Parse and convert each chunk on its own thread
+        std::vector<GnssData> parts(numChunks);
+        forEachChunk(numChunks, [&](size_t c) { parseAndConvert(bounds[c], bounds[c + 1], parts[c]); });
+
+        // Stitch the chunks in file order
+        DATA_PROFILE_SCOPE(merge, "gnss.merge");
+        size_t numSamples = 0;
+        for (const GnssData& part : parts) {
+            numSamples += part.time.size();
+        }
+        gnssData.time.reserve(numSamples);
+        gnssData.x.reserve(numSamples);
+        gnssData.y.reserve(numSamples);
+        gnssData.z.reserve(numSamples);
+        gnssData.lat.reserve(numSamples);
+        gnssData.lon.reserve(numSamples);
+        gnssData.alt.reserve(numSamples);
+        gnssData.fix.reserve(numSamples);
+        for (GnssData& part : parts) {
+            appendColumn(gnssData.time, part.time);
+            appendColumn(gnssData.x, part.x);
+            appendColumn(gnssData.y, part.y);
+            appendColumn(gnssData.z, part.z);
+            appendColumn(gnssData.lat, part.lat);
+            appendColumn(gnssData.lon, part.lon);
+            appendColumn(gnssData.alt, part.alt);
+            appendColumn(gnssData.fix, part.fix);
+            part = GnssData();
         }
+        DATA_PROFILE_ADD(merge, numSamples, numSamples * 8 * sizeof(double));
+    }
 
-        // Calcular diferenças de tempo
-        std::vector<double> gnssDiffTime(gnssSamples);
-        std::adjacent_difference(gnssData.time.begin(), gnssData.time.end(), gnssDiffTime.begin());
-        gnssDiffTime.erase(gnssDiffTime.begin()); // Remover o primeiro elemento inválido
+    if (cache != CacheMode::Off) {
+        DATA_PROFILE_SCOPE(cacheWrite, "gnss.cache.write");
+        try {
+            writeGnssCache(fileName, gnssData);
+        } catch (const std::exception& e) {
+            dataErrors() << "Warning: " << e.what() << std::endl;
+        }
+    }
 
-        // Calcular mediana das diferenças de tempo
-        std::nth_element(gnssDiffTime.begin(), gnssDiffTime.begin() + gnssDiffTime.size() / 2, gnssDiffTime.end());
-        double medianDiffTime = gnssDiffTime[gnssDiffTime.size() / 2];
+    // Log the GNSS data if requested
+    if (logData) {
+        {
+            DATA_PROFILE_SCOPE(logging, "gnss.log");
+            logGnss(gnssData);
+        }
+        DATA_PROFILE_LOG("gnss.");
+    }
 
-        // Calcular frequência
-        double gnssFreq = 1.0 / medianDiffTime;
+    dataLog() << std::flush;
 
-        // Calcular gaps
-        int gnssGaps = std::count_if(gnssDiffTime.begin(), gnssDiffTime.end(), [medianDiffTime](double dt) {
-            return std::abs(dt - medianDiffTime) > medianDiffTime * 0.1;
-        });
+    return gnssData;
+}
 
-        // Gerar a string de log
-        oss << "GNSS Samples: " << gnssSamples << " (" << (gnssData.time.back() - gnssData.time.front()) / 60.0 << " minutes)\n";
-        oss << "GNSS Freq: " << gnssFreq << " Hz\n";
-        oss << "GNSS Gaps: " << gnssGaps << " (" << (static_cast<double>(gnssGaps) / gnssSamples * 100.0) << "%)\n";
-        oss << "GNSS Quality: " << std::count(gnssData.fix.begin(), gnssData.fix.end(), 1) / static_cast<double>(gnssSamples) * 100.0 << "%\n\n";
-    } else {
-        oss << "No GNSS data available.\n";
+size_t loadGnssData(const std::string& fileName, const GnssColumnAllocator& allocate, unsigned numThreads,
+                    CacheMode cache) {
+    // Etapas desta carga, para o seu log
+    DATA_PROFILE_LOAD(profile);
+    dataLog() << "Loading GNSS data from " << fileName << "...\n";
+
+    if (cache == CacheMode::Use) {
+        size_t numCached = 0;
+        DATA_PROFILE_SCOPE(cacheRead, "gnss.cache.read");
+        bool cached = readGnssCache(fileName, allocate, numCached);
+        DATA_PROFILE_ADD(cacheRead, numCached, numCached * 8 * sizeof(double));
+        DATA_PROFILE_STOP(cacheRead);
+        if (cached) {
+            dataLog() << std::flush;
+            return numCached;
+        }
+    }
+
+    DATA_PROFILE_SCOPE(read, "gnss.read");
+    MappedFile file(fileName);
+    const char* begin = file.data();
+    const char* end = begin + file.size();
+    std::vector<const char*> bounds = splitLines(begin, end, numThreads);
+    size_t numChunks = bounds.size() - 1;
+    DATA_PROFILE_ADD(read, 0, file.size());
+    DATA_PROFILE_STOP(read);
+
+    // Count the valid lines of each chunk first, so the destination is the only copy of the data
+    std::vector<size_t> firstRow(numChunks + 1, 0);
+    forEachChunk(numChunks, [&](size_t c) { firstRow[c + 1] = countLines(bounds[c], bounds[c + 1]); });
+    for (size_t c = 0; c < numChunks; ++c) {
+        firstRow[c + 1] += firstRow[c];
+    }
+    size_t numSamples = firstRow[numChunks];
+
+    // Allocate the destination once and parse the rows of each chunk into it in parallel
+    DATA_PROFILE_SCOPE(allocation, "gnss.allocate");
+    GnssColumns columns = allocate(numSamples);
+    DATA_PROFILE_ADD(allocation, numSamples, numSamples * 8 * sizeof(double));
+    DATA_PROFILE_STOP(allocation);
+    forEachChunk(numChunks, [&](size_t c) { parseInto(bounds[c], bounds[c + 1], firstRow[c], columns); });
+
+    if (cache != CacheMode::Off) {
+        DATA_PROFILE_SCOPE(cacheWrite, "gnss.cache.write");
+        try {
+            writeGnssCache(fileName, columns, numSamples);
+        } catch (const std::exception& e) {
+            dataErrors() << "Warning: " << e.what() << std::endl;
+        }
     }
 
-    return oss.str();
+    dataLog() << std::flush;
+
+    return numSamples;
+}
+
+void logGnss(const GnssData& gnssData) {
+    // Obter a string de log
+    std::string logStr = getLogStream(gnssData);
+
+    // Exibir a string no log da thread (std::cout por padrão)
+    dataLog() << logStr;
+}
+
+
+// Função getLogStream
+std::string getLogStream(const GnssData &gnssData) {
+    // Estatísticas calculadas numa passada, sem copiar as diferenças de tempo
+    return getLogStream(computeGnssStats(gnssData));
 }
 
 void outputGnss(const GnssData& gnssData, const std::string& outputFileName, size_t initialIndex, size_t finalIndex) {
@@ -131,30 +381,7 @@ void outputGnss(const GnssData& gnssData, const std::string& outputFileName, siz
         throw std::invalid_argument("Invalid indices.");
     }
 
-    // Open the file for writing
-    std::ofstream outFile(outputFileName);
-    if (!outFile) {
-        throw std::runtime_error("Error opening output file: " + outputFileName);
-    }
-
-    std::cout << "Writing GNSS data to " << outputFileName << "...\n";
-
-    // Write the header
-    outFile << std::fixed << std::setprecision(12);
-    outFile << "Time\tX\tY\tZ\tLat\tLon\tAlt\tFix\n";
-
-    // Write the data
-    for (size_t i = initialIndex; i < finalIndex; ++i) {
-        outFile << gnssData.time[i] << "\t"
-                << gnssData.x[i] << "\t"
-                << gnssData.y[i] << "\t"
-                << gnssData.z[i] << "\t"
-                << gnssData.lat[i] << "\t"
-                << gnssData.lon[i] << "\t"
-                << gnssData.alt[i] << "\t"
-                << gnssData.fix[i] << "\n";
-    }
+    dataLog() << "Writing GNSS data to " << outputFileName << "...\n";
 
-    // Close the file
-    outFile.close();
+    exportGnssData(gnssData, outputFileName, initialIndex, finalIndex, ExportFormat::Text);
 }
\ No newline at end of file
@@ -11,7 +11,18 @@
 #include <iomanip>
 #include <iostream> // Para std::cout
 #include <algorithm> // Para std::nth_element e std::accumulate
+#include <charconv> // Para std::from_chars
+#include <cstring> // Para std::memchr
+#include <cctype>
+#include <cstdlib>
+#include <type_traits>
+#include <thread>
+#include <exception>
 #include "llaFromEcef.hpp"
+#include "mappedFile.hpp"
+#include "dataCache.hpp"
+#include "dataExport.hpp"
+#include "dataLog.hpp"
 
 /**
  * @brief Struct to hold GNSS data.
@@ -32,10 +43,46 @@ struct GnssData {
  * 
  * @param fileName The name of the file to load data from.
  * @param logData If true, the function will log the GNSS data.
+ * @param numThreads Number of worker threads. The file is split into line-aligned chunks
+ *                   that are parsed and converted in parallel; the result does not depend
+ *                   on the number of threads. If 0, all hardware threads are used.
+ * @param cache How to use the decoded-data cache next to the file (see CacheMode).
  * @return GnssData The loaded GNSS data.
  * @throws std::runtime_error If there is an error reading the file.
  */
-GnssData loadGnssData(const std::string& fileName, bool logData);
+GnssData loadGnssData(const std::string& fileName, bool logData, unsigned numThreads = 1,
+                      CacheMode cache = CacheMode::Use);
+
+/**
+ * @brief Loads GNSS data from a file straight into caller-provided columns.
+ * 
+ * The valid lines of each chunk are counted first and the destination is
+ * allocated once with their number; each chunk is then parsed again and
+ * converted to geodetic coordinates directly into it, so no intermediate copy
+ * of the data is made. The values are the same as those of the GnssData overload.
+ * 
+ * @param fileName The name of the file to load data from.
+ * @param allocate Called once with the number of samples; returns where to write them.
+ * @param numThreads Number of worker threads (see the GnssData overload). If 0, all hardware threads are used.
+ * @param cache How to use the decoded-data cache next to the file (see CacheMode).
+ * @return size_t The number of samples written.
+ * @throws std::runtime_error If there is an error reading the file.
+ */
+size_t loadGnssData(const std::string& fileName, const GnssColumnAllocator& allocate, unsigned numThreads = 1,
+                    CacheMode cache = CacheMode::Use);
+
+/**
+ * @brief Parses RTKLIB solution text (ECEF) and appends it to GNSS data.
+ * 
+ * Lines that are empty or start with '%' are skipped, as are lines that do not
+ * contain GPST week, time of week, X, Y, Z and fix status. Only time, x, y, z and
+ * fix are filled; lat, lon and alt are left untouched.
+ * 
+ * @param begin The first character of the text.
+ * @param end One past the last character of the text.
+ * @param gnssData The GNSS data to append to.
+ */
+void parseGnssText(const char* begin, const char* end, GnssData& gnssData);
 
 /**
  * @brief Outputs GNSS data to a file.
@@ -44,14 +91,16 @@ GnssData loadGnssData(const std::string& fileName, bool logData);
  * @param outputFileName The name of the file to output data to.
  * @param initialIndex The initial index of the data to output.
  * @param finalIndex The final index of the data to output.
+ * @throws std::invalid_argument If the indices are out of range.
  * @throws std::runtime_error If there is an error opening the output file.
+ * @see exportGnssData for CSV and binary output.
  */
 void outputGnss(const GnssData& gnssData, const std::string& outputFileName, size_t initialIndex, size_t finalIndex);
 
 std::string getLogStream(const GnssData &gnssData);
 
 /**
- * @brief Logs GNSS data to the console.
+ * @brief Logs GNSS data to the console (dataLog() of the calling thread).
  * 
  * @param gnssData The GNSS data to log.
  */
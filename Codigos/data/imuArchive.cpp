@@ -0,0 +1,411 @@
+#include "imuArchive.hpp"
+#include <cstring>
+#include <thread>
+#include <exception>
+
+namespace {
+
+// Formato do arquivo (little-endian):
+//   ArchiveHeader
+//   blocos: ArchiveBlockHeader, fluxos (tempo, gx, gy, gz, accx, accy, accz), 8 bytes de folga
+//   tabela de blocos: ArchiveBlockEntry[numBlocks] em tableOffset
+const char archiveMagic[8] = {'D', 'L', 'N', 'I', 'M', 'U', 'Z', '1'};
+const uint32_t archiveVersion = 1;
+const size_t numStreams = 7;
+const size_t groupSize = 128;
+const size_t blockPadding = 8;
+
+struct ArchiveHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t blockRecords;
+    uint64_t numRecords;
+    uint64_t numBlocks;
+    uint64_t tableOffset;
+};
+static_assert(sizeof(ArchiveHeader) == 40, "ArchiveHeader layout");
+
+struct ArchiveBlockHeader {
+    uint32_t numRecords;
+    uint32_t streamBytes[numStreams];
+    ImuRecord first;
+};
+static_assert(sizeof(ArchiveBlockHeader) == 64, "ArchiveBlockHeader layout");
+
+struct ArchiveBlockEntry {
+    uint64_t offset;
+    uint64_t bytes;
+};
+static_assert(sizeof(ArchiveBlockEntry) == 16, "ArchiveBlockEntry layout");
+
+inline uint64_t zigzag(uint64_t value) {
+    return (value << 1) ^ (0 - (value >> 63));
+}
+
+inline uint64_t unzigzag(uint64_t value) {
+    return (value >> 1) ^ (0 - (value & 1));
+}
+
+inline int32_t channel(const ImuRecord& r, size_t c) {
+    switch (c) {
+    case 0:
+        return r.gx;
+    case 1:
+        return r.gy;
+    case 2:
+        return r.gz;
+    case 3:
+        return r.accx;
+    case 4:
+        return r.accy;
+    default:
+        return r.accz;
+    }
+}
+
+inline int32_t& channel(ImuRecord& r, size_t c) {
+    switch (c) {
+    case 0:
+        return r.gx;
+    case 1:
+        return r.gy;
+    case 2:
+        return r.gz;
+    case 3:
+        return r.accx;
+    case 4:
+        return r.accy;
+    default:
+        return r.accz;
+    }
+}
+
+void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+// Codifica um bloco de registros (sem a folga final)
+std::vector<uint8_t> encodeBlock(const ImuRecord* records, size_t numRecords) {
+    ArchiveBlockHeader header = {};
+    header.numRecords = static_cast<uint32_t>(numRecords);
+    header.first = records[0];
+
+    std::vector<uint8_t> streams[numStreams];
+
+    // Tempo: delta do delta em zig-zag varint
+    uint64_t previousDelta = 0;
+    for (size_t i = 1; i < numRecords; ++i) {
+        uint64_t delta = imuRecordNanoseconds(records[i]) - imuRecordNanoseconds(records[i - 1]);
+        putVarint(streams[0], zigzag(delta - previousDelta));
+        previousDelta = delta;
+    }
+
+    // Canais: deltas em zig-zag, empacotados em grupos com a largura do maior
+    uint64_t values[groupSize];
+    for (size_t c = 0; c < numStreams - 1; ++c) {
+        std::vector<uint8_t>& out = streams[c + 1];
+        for (size_t start = 1; start < numRecords; start += groupSize) {
+            size_t count = std::min(groupSize, numRecords - start);
+            uint64_t all = 0;
+            for (size_t k = 0; k < count; ++k) {
+                int64_t delta = static_cast<int64_t>(channel(records[start + k], c)) -
+                                static_cast<int64_t>(channel(records[start + k - 1], c));
+                values[k] = zigzag(static_cast<uint64_t>(delta));
+                all |= values[k];
+            }
+            uint8_t width = 0;
+            while (width < 64 && (all >> width) != 0) {
+                ++width;
+            }
+            out.push_back(width);
+            uint64_t accumulator = 0;
+            unsigned bits = 0;
+            for (size_t k = 0; k < count; ++k) {
+                accumulator |= values[k] << bits;
+                bits += width;
+                while (bits >= 8) {
+                    out.push_back(static_cast<uint8_t>(accumulator));
+                    accumulator >>= 8;
+                    bits -= 8;
+                }
+            }
+            if (bits > 0) {
+                out.push_back(static_cast<uint8_t>(accumulator));
+            }
+        }
+    }
+
+    size_t total = sizeof(header);
+    for (size_t s = 0; s < numStreams; ++s) {
+        header.streamBytes[s] = static_cast<uint32_t>(streams[s].size());
+        total += streams[s].size();
+    }
+    std::vector<uint8_t> block;
+    block.reserve(total + blockPadding);
+    block.resize(sizeof(header));
+    std::memcpy(block.data(), &header, sizeof(header));
+    for (size_t s = 0; s < numStreams; ++s) {
+        block.insert(block.end(), streams[s].begin(), streams[s].end());
+    }
+    block.resize(total + blockPadding, 0);
+    return block;
+}
+
+[[noreturn]] void corrupted(const char* what) {
+    throw std::runtime_error(std::string("Corrupted IMU archive: ") + what);
+}
+
+inline uint64_t load64(const uint8_t* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+// Decodifica um bloco; data aponta para o cabeçalho e há bytes bytes válidos,
+// incluindo a folga final
+void decodeBlock(const uint8_t* data, size_t bytes, ImuRecord* out, size_t expectedRecords) {
+    if (bytes < sizeof(ArchiveBlockHeader) + blockPadding) {
+        corrupted("block too small");
+    }
+    ArchiveBlockHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    size_t numRecords = header.numRecords;
+    if (numRecords != expectedRecords || numRecords == 0) {
+        corrupted("wrong number of records in block");
+    }
+    size_t total = sizeof(header);
+    for (size_t s = 0; s < numStreams; ++s) {
+        total += header.streamBytes[s];
+    }
+    if (total + blockPadding != bytes) {
+        corrupted("wrong block size");
+    }
+
+    out[0] = header.first;
+    const uint8_t* stream = data + sizeof(header);
+
+    // Tempo
+    {
+        const uint8_t* p = stream;
+        const uint8_t* end = stream + header.streamBytes[0];
+        uint64_t time = imuRecordNanoseconds(header.first);
+        uint64_t delta = 0;
+        for (size_t i = 1; i < numRecords; ++i) {
+            uint64_t value = 0;
+            if (p < end && *p < 0x80) {
+                value = *p++;
+            } else {
+                unsigned shift = 0;
+                while (true) {
+                    if (p >= end || shift > 63) {
+                        corrupted("bad timestamp stream");
+                    }
+                    uint8_t byte = *p++;
+                    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+                    if (byte < 0x80) {
+                        break;
+                    }
+                    shift += 7;
+                }
+            }
+            delta += unzigzag(value);
+            time += delta;
+            out[i].timeLow = static_cast<uint32_t>(time);
+            out[i].timeHigh = static_cast<uint32_t>(time >> 32);
+        }
+        if (p != end) {
+            corrupted("bad timestamp stream");
+        }
+        stream = end;
+    }
+
+    // Canais
+    for (size_t c = 0; c < numStreams - 1; ++c) {
+        const uint8_t* p = stream;
+        const uint8_t* end = stream + header.streamBytes[c + 1];
+        int64_t value = channel(header.first, c);
+        for (size_t start = 1; start < numRecords; start += groupSize) {
+            size_t count = std::min(groupSize, numRecords - start);
+            if (p >= end) {
+                corrupted("bad channel stream");
+            }
+            unsigned width = *p++;
+            size_t groupBytes = (count * width + 7) / 8;
+            if (width > 33 || static_cast<size_t>(end - p) < groupBytes) {
+                corrupted("bad channel stream");
+            }
+            // Com largura até 33 bits, cada valor cabe numa leitura de 8 bytes;
+            // a folga do bloco garante os bytes além do fim do fluxo
+            uint64_t mask = width == 0 ? 0 : (~uint64_t(0) >> (64 - width));
+            size_t bit = 0;
+            for (size_t k = 0; k < count; ++k, bit += width) {
+                uint64_t zz = (load64(p + (bit >> 3)) >> (bit & 7)) & mask;
+                value += static_cast<int64_t>(unzigzag(zz));
+                channel(out[start + k], c) = static_cast<int32_t>(value);
+            }
+            p += groupBytes;
+        }
+        if (p != end) {
+            corrupted("bad channel stream");
+        }
+        stream = end;
+    }
+}
+
+// Executa work(first, last) para intervalos contíguos de [0, count), um por thread,
+// e relança o erro do primeiro intervalo que falhou
+template <typename Work>
+void forEachRange(size_t count, unsigned numThreads, const Work& work) {
+    if (numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t numRanges = std::min<size_t>(numThreads, count);
+    if (numRanges <= 1) {
+        work(0, count);
+        return;
+    }
+    std::vector<std::exception_ptr> errors(numRanges);
+    std::vector<std::thread> workers;
+    workers.reserve(numRanges);
+    for (size_t r = 0; r < numRanges; ++r) {
+        workers.emplace_back([&, r]() {
+            try {
+                work(count * r / numRanges, count * (r + 1) / numRanges);
+            } catch (...) {
+                errors[r] = std::current_exception();
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+} // namespace
+
+bool isImuArchive(const char* data, size_t size) {
+    return size >= sizeof(ArchiveHeader) && std::memcmp(data, archiveMagic, sizeof(archiveMagic)) == 0;
+}
+
+uint64_t imuArchiveRecords(const char* data, size_t size) {
+    if (!isImuArchive(data, size)) {
+        corrupted("missing header");
+    }
+    ArchiveHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    return header.numRecords;
+}
+
+void writeImuArchive(const ImuRecord* records, size_t numRecords, const std::string& fileName,
+                     size_t blockRecords, unsigned numThreads) {
+    if (blockRecords == 0 || blockRecords > UINT32_MAX) {
+        throw std::invalid_argument("Invalid number of records per block.");
+    }
+    std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Error opening output file: " + fileName);
+    }
+
+    ArchiveHeader header;
+    std::memcpy(header.magic, archiveMagic, sizeof(archiveMagic));
+    header.version = archiveVersion;
+    header.blockRecords = static_cast<uint32_t>(blockRecords);
+    header.numRecords = numRecords;
+    header.numBlocks = (numRecords + blockRecords - 1) / blockRecords;
+    header.tableOffset = 0;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // Os blocos são codificados em lotes, em paralelo, e gravados em ordem
+    if (numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t batchBlocks = 4 * static_cast<size_t>(numThreads);
+    std::vector<ArchiveBlockEntry> table(header.numBlocks);
+    uint64_t offset = sizeof(header);
+    for (size_t batch = 0; batch < header.numBlocks; batch += batchBlocks) {
+        size_t count = std::min<size_t>(batchBlocks, header.numBlocks - batch);
+        std::vector<std::vector<uint8_t>> blocks(count);
+        forEachRange(count, numThreads, [&](size_t first, size_t last) {
+            for (size_t b = first; b < last; ++b) {
+                size_t start = (batch + b) * blockRecords;
+                blocks[b] = encodeBlock(records + start, std::min(blockRecords, numRecords - start));
+            }
+        });
+        for (size_t b = 0; b < count; ++b) {
+            table[batch + b].offset = offset;
+            table[batch + b].bytes = blocks[b].size();
+            out.write(reinterpret_cast<const char*>(blocks[b].data()), blocks[b].size());
+            offset += blocks[b].size();
+        }
+    }
+
+    header.tableOffset = offset;
+    out.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(ArchiveBlockEntry));
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!out) {
+        throw std::runtime_error("Error writing output file: " + fileName);
+    }
+}
+
+void compressImuLog(const std::string& logFileName, const std::string& archiveFileName, size_t blockRecords,
+                    unsigned numThreads) {
+    MappedFile file(logFileName);
+    size_t numRecords = 0;
+    const ImuRecord* records = imuRecords(file, logFileName, numRecords);
+    writeImuArchive(records, numRecords, archiveFileName, blockRecords, numThreads);
+}
+
+std::vector<ImuRecord> decodeImuArchive(const char* data, size_t size, unsigned numThreads) {
+    if (!isImuArchive(data, size)) {
+        corrupted("missing header");
+    }
+    ArchiveHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.version != archiveVersion) {
+        throw std::runtime_error("Unsupported IMU archive version " + std::to_string(header.version));
+    }
+    if (header.blockRecords == 0 ||
+        header.numBlocks != (header.numRecords + header.blockRecords - 1) / header.blockRecords ||
+        header.tableOffset > size || (size - header.tableOffset) / sizeof(ArchiveBlockEntry) != header.numBlocks) {
+        corrupted("bad block table");
+    }
+    std::vector<ArchiveBlockEntry> table(header.numBlocks);
+    std::memcpy(table.data(), data + header.tableOffset, table.size() * sizeof(ArchiveBlockEntry));
+    for (const ArchiveBlockEntry& entry : table) {
+        if (entry.offset < sizeof(header) || entry.offset > header.tableOffset ||
+            entry.bytes > header.tableOffset - entry.offset) {
+            corrupted("bad block table");
+        }
+    }
+
+    std::vector<ImuRecord> records(header.numRecords);
+    forEachRange(table.size(), numThreads, [&](size_t first, size_t last) {
+        for (size_t b = first; b < last; ++b) {
+            size_t start = b * header.blockRecords;
+            size_t count = std::min<size_t>(header.blockRecords, header.numRecords - start);
+            decodeBlock(reinterpret_cast<const uint8_t*>(data) + table[b].offset, table[b].bytes,
+                        records.data() + start, count);
+        }
+    });
+    return records;
+}
+
+const ImuRecord* readImuRecords(const MappedFile& file, const std::string& fileName,
+                                std::vector<ImuRecord>& storage, size_t& numSamples) {
+    if (!isImuArchive(file.data(), file.size())) {
+        return imuRecords(file, fileName, numSamples);
+    }
+    storage = decodeImuArchive(file.data(), file.size());
+    numSamples = storage.size();
+    return storage.data();
+}
@@ -0,0 +1,83 @@
+#ifndef IMU_ARCHIVE_HPP
+#define IMU_ARCHIVE_HPP
+
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include "imuData.hpp"
+
+/**
+ * @brief Records per block of a new IMU archive.
+ */
+const size_t defaultArchiveBlockRecords = 1 << 16;
+
+/**
+ * @brief Checks if a buffer holds an IMU archive (by its magic number).
+ */
+bool isImuArchive(const char* data, size_t size);
+
+/**
+ * @brief Gets the number of records of an IMU archive from its header.
+ *
+ * @throws std::runtime_error If the buffer is not an IMU archive.
+ */
+uint64_t imuArchiveRecords(const char* data, size_t size);
+
+/**
+ * @brief Compresses raw IMU records into a lossless archive.
+ *
+ * The records are split into blocks that can be decoded independently. In each
+ * block the first record is stored as is; timestamps are stored as zig-zag
+ * varints of the delta-of-delta and each channel as zig-zag deltas bit-packed
+ * in groups of 128 with the width of the largest one.
+ *
+ * @param records The raw IMU records.
+ * @param numRecords The number of records.
+ * @param fileName The name of the archive to write.
+ * @param blockRecords The number of records per block.
+ * @param numThreads Number of threads encoding blocks. If 0, all hardware threads are used.
+ * @throws std::runtime_error If the file cannot be written.
+ */
+void writeImuArchive(const ImuRecord* records, size_t numRecords, const std::string& fileName,
+                     size_t blockRecords = defaultArchiveBlockRecords, unsigned numThreads = 0);
+
+/**
+ * @brief Compresses an IMU binary log (the format of loadImuData) into an archive.
+ *
+ * @param logFileName The name of the IMU binary file.
+ * @param archiveFileName The name of the archive to write.
+ * @param blockRecords The number of records per block.
+ * @param numThreads Number of threads encoding blocks. If 0, all hardware threads are used.
+ * @throws std::runtime_error If a file cannot be read or written.
+ */
+void compressImuLog(const std::string& logFileName, const std::string& archiveFileName,
+                    size_t blockRecords = defaultArchiveBlockRecords, unsigned numThreads = 0);
+
+/**
+ * @brief Decodes an IMU archive into raw records, identical to the original log.
+ *
+ * @param data The archive contents.
+ * @param size The size of the archive in bytes.
+ * @param numThreads Number of threads decoding blocks. If 0, all hardware threads are used.
+ * @return std::vector<ImuRecord> The records.
+ * @throws std::runtime_error If the archive is corrupted.
+ */
+std::vector<ImuRecord> decodeImuArchive(const char* data, size_t size, unsigned numThreads = 0);
+
+/**
+ * @brief Gets the raw records of an IMU log, decoding it if it is an archive.
+ *
+ * Raw logs are viewed in place; archives are decoded into storage.
+ *
+ * @param file The mapped log or archive.
+ * @param fileName The name of the file, used in error messages.
+ * @param storage Holds the records of an archive.
+ * @param numSamples Output number of records.
+ * @return const ImuRecord* Pointer to the first record.
+ * @throws std::runtime_error If the log is truncated or the archive is corrupted.
+ */
+const ImuRecord* readImuRecords(const MappedFile& file, const std::string& fileName,
+                                std::vector<ImuRecord>& storage, size_t& numSamples);
+
+#endif // IMU_ARCHIVE_HPP
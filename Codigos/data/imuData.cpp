@@ -1,34 +1,34 @@
 #include "imuData.hpp"
+#include "logStats.hpp"
+#include "imuArchive.hpp"
+#include "dataProfile.hpp"
 
-ImuData loadImuData(const std::string &fileName, int &imuModel, bool logData)
+bool imuScaleFactors(int imuModel, double &anglfak, double &accelfak)
 {
-    // Load Raw Data
-    std::ifstream file(fileName, std::ios::binary | std::ios::ate);
-    std::streamsize size = file.tellg();
-    file.seekg(0, std::ios::beg);
-
-    // Read the file into a buffer
-    std::vector<uint32_t> buffer(size / sizeof(uint32_t));
-    if (!file.read(reinterpret_cast<char *>(buffer.data()), size))
+    if (imuModel == 16495)
     {
-        throw std::runtime_error("Error reading file");
+        anglfak = 6.25e-3 / (1 << 16);
+        accelfak = 2.5e-4 / (1 << 16);
     }
-
-    // Determine the number of samples
-    size_t numSamples = buffer.size() / 8;
-    std::vector<std::vector<uint32_t>> A(numSamples, std::vector<uint32_t>(8));
-    for (size_t i = 0; i < numSamples; ++i)
+    else if (imuModel == 16490)
     {
-        std::copy(buffer.begin() + i * 8, buffer.begin() + (i + 1) * 8, A[i].begin());
+        anglfak = 5e-3 / (1 << 16);
+        accelfak = 5e-4 / (1 << 16);
     }
+    else
+    {
+        return false;
+    }
+    return true;
+}
 
-    bool imuOK = false;
-    double anglfak, accelfak;
-
-    // Initialize vectors to store IMU data
-    std::vector<double> timeStamp(numSamples);
-    std::vector<double> gx(numSamples), gy(numSamples), gz(numSamples);
-    std::vector<double> accx(numSamples), accy(numSamples), accz(numSamples);
+int detectImuModel(const ImuRecord *records, size_t numSamples, int imuModel)
+{
+    if (numSamples == 0)
+    {
+        throw std::runtime_error("IMU log has no samples.");
+    }
+    size_t numCheck = std::min<size_t>(numSamples, 10);
 
     // Iterate over possible IMU models
     for (int k : {16495, 16490})
@@ -38,49 +38,30 @@ ImuData loadImuData(const std::string &fileName, int &imuModel, bool logData)
             k = imuModel;
         }
 
-        // Set scaling factors based on IMU model
-        if (k == 16495)
-        {
-            anglfak = 6.25e-3 / (1 << 16);
-            accelfak = 2.5e-4 / (1 << 16);
-        }
-        else if (k == 16490)
-        {
-            anglfak = 5e-3 / (1 << 16);
-            accelfak = 5e-4 / (1 << 16);
-        }
-        else
+        double anglfak, accelfak;
+        if (!imuScaleFactors(k, anglfak, accelfak))
         {
-            std::cerr << "Modelo não implementado." << std::endl;
+            dataErrors() << "Modelo não implementado." << std::endl;
+            if (imuModel)
+            {
+                break;
+            }
             continue;
         }
 
-        // Process each sample
-        for (size_t i = 0; i < numSamples; ++i)
-        {
-            uint64_t t = (static_cast<uint64_t>(A[i][1]) << 32) | A[i][0];
-            timeStamp[i] = static_cast<double>(t) / 1e9;
-            gx[i] = static_cast<double>(static_cast<int32_t>(A[i][2])) * anglfak;
-            gy[i] = static_cast<double>(static_cast<int32_t>(A[i][3])) * anglfak;
-            gz[i] = static_cast<double>(static_cast<int32_t>(A[i][4])) * anglfak;
-            accx[i] = static_cast<double>(static_cast<int32_t>(A[i][5])) * accelfak;
-            accy[i] = static_cast<double>(static_cast<int32_t>(A[i][6])) * accelfak;
-            accz[i] = static_cast<double>(static_cast<int32_t>(A[i][7])) * accelfak;
-        }
-
         // Check if the accelerometer data corresponds to gravity
-        std::vector<double> acc(10);
-        for (int i = 0; i < 10; ++i)
+        double sum = 0.0;
+        for (size_t i = 0; i < numCheck; ++i)
         {
-            acc[i] = std::sqrt(accx[i] * accx[i] + accy[i] * accy[i] + accz[i] * accz[i]);
+            double ax = static_cast<double>(records[i].accx) * accelfak;
+            double ay = static_cast<double>(records[i].accy) * accelfak;
+            double az = static_cast<double>(records[i].accz) * accelfak;
+            sum += std::sqrt(ax * ax + ay * ay + az * az);
         }
-        double g0 = std::accumulate(acc.begin(), acc.end(), 0.0) / acc.size();
+        double g0 = sum / numCheck;
         if (std::abs(g0 - 1) < 0.05)
         {
-            // If the static acceleration is close to 1g, set the IMU model and exit the loop
-            imuOK = true;
-            imuModel = k;
-            break;
+            return k;
         }
         else if (imuModel)
         {
@@ -88,140 +69,268 @@ ImuData loadImuData(const std::string &fileName, int &imuModel, bool logData)
         }
     }
 
-    // Throw an error if IMU data is not valid (i.e., the accelerometer data does not correspond to gravity)
-    if (!imuOK)
+    throw std::runtime_error("Escala dos acelerômetros da IMU não correspondem a gravidade.");
+}
+
+const ImuRecord* imuRecords(const MappedFile &file, const std::string &fileName, size_t &numSamples)
+{
+    // O arquivo deve conter apenas registros completos de 32 bytes
+    if (file.size() % sizeof(ImuRecord) != 0)
+    {
+        throw std::runtime_error("Truncated IMU record at the end of " + fileName + ": " +
+                                 std::to_string(file.size() % sizeof(ImuRecord)) + " trailing bytes");
+    }
+    numSamples = file.size() / sizeof(ImuRecord);
+    return reinterpret_cast<const ImuRecord *>(file.data());
+}
+
+namespace
+{
+
+// Number of samples left after dropping repeated timestamps
+size_t countUniqueTimestamps(const ImuRecord *records, size_t numSamples)
+{
+    size_t numUnique = 0;
+    double lastTime = 0.0;
+    for (size_t i = 0; i < numSamples; ++i)
     {
-        throw std::runtime_error("Escala dos acelerômetros da IMU não correspondem a gravidade.");
+        double t = imuRecordTime(records[i]);
+        if (numUnique == 0 || t != lastTime)
+        {
+            ++numUnique;
+            lastTime = t;
+        }
     }
+    return numUnique;
+}
 
-    // Create and populate the ImuData object
-    ImuData imuData;
-    imuData.timeStamp = timeStamp;
-    imuData.accx = accx;
-    imuData.accy = accy;
-    imuData.accz = accz;
-    imuData.gx = gx;
-    imuData.gy = gy;
-    imuData.gz = gz;
+// Decodes, scales and drops duplicate timestamps in a single pass; the first
+// sample of each run is kept. Columns is ImuData (sized for numSamples) or ImuColumns
+template <typename Columns>
+size_t decodeImuRecords(const ImuRecord *records, size_t numSamples, double anglfak, double accelfak,
+                        Columns &out)
+{
+    size_t numUnique = 0;
+    double lastTime = 0.0;
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        const ImuRecord &r = records[i];
+        double t = imuRecordTime(r);
+        if (numUnique > 0 && t == lastTime)
+        {
+            continue;
+        }
+        lastTime = t;
+        out.timeStamp[numUnique] = t;
+        out.gx[numUnique] = static_cast<double>(r.gx) * anglfak;
+        out.gy[numUnique] = static_cast<double>(r.gy) * anglfak;
+        out.gz[numUnique] = static_cast<double>(r.gz) * anglfak;
+        out.accx[numUnique] = static_cast<double>(r.accx) * accelfak;
+        out.accy[numUnique] = static_cast<double>(r.accy) * accelfak;
+        out.accz[numUnique] = static_cast<double>(r.accz) * accelfak;
+        ++numUnique;
+    }
+    return numUnique;
+}
 
-    removeDuplicateTimestamps(imuData);
+} // namespace
+
+ImuData loadImuData(const std::string &fileName, int &imuModel, bool logData, CacheMode cache)
+{
+    // Etapas desta carga, para o seu log
+    DATA_PROFILE_LOAD(profile);
+
+    // Use the decoded data from a previous load if it is still valid
+    if (cache == CacheMode::Use)
+    {
+        ImuData imuData;
+        DATA_PROFILE_SCOPE(cacheRead, "imu.cache.read");
+        bool cached = readImuCache(fileName, imuModel, imuData);
+        DATA_PROFILE_ADD(cacheRead, imuData.timeStamp.size(), imuData.timeStamp.size() * 7 * sizeof(double));
+        DATA_PROFILE_STOP(cacheRead);
+        if (cached)
+        {
+            if (logData)
+            {
+                logImuData(imuData, imuModel);
+                DATA_PROFILE_LOG("imu.");
+            }
+            return imuData;
+        }
+    }
+
+    // Map the raw data (archives are decoded first)
+    DATA_PROFILE_SCOPE(read, "imu.read");
+    MappedFile file(fileName);
+    size_t numSamples = 0;
+    std::vector<ImuRecord> archived;
+    const ImuRecord *records = readImuRecords(file, fileName, archived, numSamples);
+    DATA_PROFILE_ADD(read, numSamples, file.size());
+    DATA_PROFILE_STOP(read);
+
+    // Determine the model from the first samples only
+    DATA_PROFILE_SCOPE(detect, "imu.detectModel");
+    imuModel = detectImuModel(records, numSamples, imuModel);
+    double anglfak = 0.0, accelfak = 0.0;
+    imuScaleFactors(imuModel, anglfak, accelfak);
+    DATA_PROFILE_STOP(detect);
+
+    // Decode, scale and drop duplicate timestamps in a single pass,
+    // straight into the output columns
+    DATA_PROFILE_SCOPE(decode, "imu.decode");
+    ImuData imuData;
+    imuData.timeStamp.resize(numSamples);
+    imuData.gx.resize(numSamples);
+    imuData.gy.resize(numSamples);
+    imuData.gz.resize(numSamples);
+    imuData.accx.resize(numSamples);
+    imuData.accy.resize(numSamples);
+    imuData.accz.resize(numSamples);
+    size_t numUnique = decodeImuRecords(records, numSamples, anglfak, accelfak, imuData);
+
+    // Shrinking keeps the capacity, so no column is reallocated
+    imuData.timeStamp.resize(numUnique);
+    imuData.gx.resize(numUnique);
+    imuData.gy.resize(numUnique);
+    imuData.gz.resize(numUnique);
+    imuData.accx.resize(numUnique);
+    imuData.accy.resize(numUnique);
+    imuData.accz.resize(numUnique);
+    DATA_PROFILE_ADD(decode, numSamples, numSamples * sizeof(ImuRecord));
+    DATA_PROFILE_STOP(decode);
+    DATA_PROFILE_COUNT("imu.duplicates", numSamples - numUnique, 0);
+
+    if (cache != CacheMode::Off)
+    {
+        DATA_PROFILE_SCOPE(cacheWrite, "imu.cache.write");
+        try
+        {
+            writeImuCache(fileName, imuModel, imuData);
+        }
+        catch (const std::exception &e)
+        {
+            dataErrors() << "Warning: " << e.what() << std::endl;
+        }
+    }
 
     // Log IMU data if requested
     if (logData)
     {
-        logImuData(imuData, imuModel);
+        {
+            DATA_PROFILE_SCOPE(logging, "imu.log");
+            logImuData(imuData, imuModel);
+        }
+        DATA_PROFILE_LOG("imu.");
     }
 
     return imuData;
 }
 
-void removeDuplicateTimestamps(ImuData& imuData) {
-    // Find unique timestamps and their corresponding indices
-    std::vector<size_t> uniqueIndices;
-    uniqueIndices.reserve(imuData.timeStamp.size());
+size_t loadImuData(const std::string &fileName, int &imuModel, const ImuColumnAllocator &allocate, CacheMode cache)
+{
+    // Etapas desta carga, para o seu log
+    DATA_PROFILE_LOAD(profile);
 
-    auto last = std::unique(imuData.timeStamp.begin(), imuData.timeStamp.end());
-    for (auto it = imuData.timeStamp.begin(); it != last; ++it) {
-        uniqueIndices.push_back(std::distance(imuData.timeStamp.begin(), it));
+    if (cache == CacheMode::Use)
+    {
+        size_t numCached = 0;
+        DATA_PROFILE_SCOPE(cacheRead, "imu.cache.read");
+        bool cached = readImuCache(fileName, imuModel, allocate, numCached);
+        DATA_PROFILE_ADD(cacheRead, numCached, numCached * 7 * sizeof(double));
+        DATA_PROFILE_STOP(cacheRead);
+        if (cached)
+        {
+            return numCached;
+        }
     }
 
-    // Create new vectors with only unique elements
-    std::vector<double> newTimeStamp, newaccx, newaccy, newaccz, newgx, newgy, newgz;
-    newTimeStamp.reserve(uniqueIndices.size());
-    newaccx.reserve(uniqueIndices.size());
-    newaccy.reserve(uniqueIndices.size());
-    newaccz.reserve(uniqueIndices.size());
-    newgx.reserve(uniqueIndices.size());
-    newgy.reserve(uniqueIndices.size());
-    newgz.reserve(uniqueIndices.size());
-
-    for (size_t idx : uniqueIndices) {
-        newTimeStamp.push_back(imuData.timeStamp[idx]);
-        newaccx.push_back(imuData.accx[idx]);
-        newaccy.push_back(imuData.accy[idx]);
-        newaccz.push_back(imuData.accz[idx]);
-        newgx.push_back(imuData.gx[idx]);
-        newgy.push_back(imuData.gy[idx]);
-        newgz.push_back(imuData.gz[idx]);
+    DATA_PROFILE_SCOPE(read, "imu.read");
+    MappedFile file(fileName);
+    size_t numSamples = 0;
+    std::vector<ImuRecord> archived;
+    const ImuRecord *records = readImuRecords(file, fileName, archived, numSamples);
+    DATA_PROFILE_ADD(read, numSamples, file.size());
+    DATA_PROFILE_STOP(read);
+
+    DATA_PROFILE_SCOPE(detect, "imu.detectModel");
+    imuModel = detectImuModel(records, numSamples, imuModel);
+    double anglfak = 0.0, accelfak = 0.0;
+    imuScaleFactors(imuModel, anglfak, accelfak);
+    DATA_PROFILE_STOP(detect);
+
+    // Count first so the destination is allocated once with its final size
+    DATA_PROFILE_SCOPE(count, "imu.countUnique");
+    size_t numUnique = countUniqueTimestamps(records, numSamples);
+    DATA_PROFILE_STOP(count);
+    DATA_PROFILE_SCOPE(allocation, "imu.allocate");
+    ImuColumns columns = allocate(numUnique);
+    DATA_PROFILE_ADD(allocation, numUnique, numUnique * 7 * sizeof(double));
+    DATA_PROFILE_STOP(allocation);
+    DATA_PROFILE_SCOPE(decode, "imu.decode");
+    decodeImuRecords(records, numSamples, anglfak, accelfak, columns);
+    DATA_PROFILE_ADD(decode, numSamples, numSamples * sizeof(ImuRecord));
+    DATA_PROFILE_STOP(decode);
+    DATA_PROFILE_COUNT("imu.duplicates", numSamples - numUnique, 0);
+
+    if (cache != CacheMode::Off)
+    {
+        DATA_PROFILE_SCOPE(cacheWrite, "imu.cache.write");
+        try
+        {
+            writeImuCache(fileName, imuModel, columns, numUnique);
+        }
+        catch (const std::exception &e)
+        {
+            dataErrors() << "Warning: " << e.what() << std::endl;
+        }
     }
 
-    // Replace old vectors with new vectors
-    imuData.timeStamp = std::move(newTimeStamp);
-    imuData.accx = std::move(newaccx);
-    imuData.accy = std::move(newaccy);
-    imuData.accz = std::move(newaccz);
-    imuData.gx = std::move(newgx);
-    imuData.gy = std::move(newgy);
-    imuData.gz = std::move(newgz);
+    return numUnique;
 }
 
-void outputImuData(const ImuData& imuData, const std::string& outputFileName, size_t initialIndex, size_t finalIndex) {
-    // Open output file
-    std::ofstream outFile(outputFileName);
-    if (!outFile) {
-        throw std::runtime_error("Error opening output file");
+void removeDuplicateTimestamps(ImuData& imuData) {
+    // Keep the first sample of each run of equal timestamps, compacting all columns in place
+    size_t numSamples = imuData.timeStamp.size();
+    size_t numUnique = 0;
+    for (size_t i = 0; i < numSamples; ++i) {
+        if (numUnique > 0 && imuData.timeStamp[i] == imuData.timeStamp[numUnique - 1]) {
+            continue;
+        }
+        if (numUnique != i) {
+            imuData.timeStamp[numUnique] = imuData.timeStamp[i];
+            imuData.accx[numUnique] = imuData.accx[i];
+            imuData.accy[numUnique] = imuData.accy[i];
+            imuData.accz[numUnique] = imuData.accz[i];
+            imuData.gx[numUnique] = imuData.gx[i];
+            imuData.gy[numUnique] = imuData.gy[i];
+            imuData.gz[numUnique] = imuData.gz[i];
+        }
+        ++numUnique;
     }
 
-    outFile << std::fixed << std::setprecision(9);
-    outFile << "TimeStamp\tAccX\tAccY\tAccZ\tGx\tGy\tGz\n";
-    for (size_t i = initialIndex; i < finalIndex; ++i) {
-        outFile << imuData.timeStamp[i] << "\t"
-                << imuData.accx[i] << "\t"
-                << imuData.accy[i] << "\t"
-                << imuData.accz[i] << "\t"
-                << imuData.gx[i] << "\t"
-                << imuData.gy[i] << "\t"
-                << imuData.gz[i] << "\n";
-    }
+    imuData.timeStamp.resize(numUnique);
+    imuData.accx.resize(numUnique);
+    imuData.accy.resize(numUnique);
+    imuData.accz.resize(numUnique);
+    imuData.gx.resize(numUnique);
+    imuData.gy.resize(numUnique);
+    imuData.gz.resize(numUnique);
+}
+
+void outputImuData(const ImuData& imuData, const std::string& outputFileName, size_t initialIndex, size_t finalIndex) {
+    exportImuData(imuData, outputFileName, initialIndex, finalIndex, ExportFormat::Text);
 }
 
 void logImuData(const ImuData &imuData, int imuModel) {
     // Obter a string de log
     std::string logStr = getLogStream(imuData, imuModel);
 
-    // Exibir a string usando std::cout
-    std::cout << logStr;
+    // Exibir a string no log da thread (std::cout por padrão)
+    dataLog() << logStr;
 }
 
 // Função getLogStream
 std::string getLogStream(const ImuData &imuData, int imuModel) {
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(2);
-
-    if (!imuData.timeStamp.empty()) {
-        size_t imuSamples = imuData.timeStamp.size();
-
-        // Verificar se há dados suficientes para calcular diferenças
-        if (imuSamples < 2) {
-            oss << "Not enough IMU data to calculate statistics.\n";
-            return oss.str();
-        }
-
-        // Calcular diferenças de tempo
-        std::vector<double> imuDiffTime(imuSamples - 1);
-        std::adjacent_difference(imuData.timeStamp.begin(), imuData.timeStamp.end(), imuDiffTime.begin());
-        imuDiffTime.erase(imuDiffTime.begin()); // Remover o primeiro elemento inválido
-
-        // Calcular mediana das diferenças de tempo
-        std::nth_element(imuDiffTime.begin(), imuDiffTime.begin() + imuDiffTime.size() / 2, imuDiffTime.end());
-        double medianDiffTime = imuDiffTime[imuDiffTime.size() / 2];
-
-        // Calcular frequência
-        double imuFreq = 1.0 / medianDiffTime;
-
-        // Calcular gaps
-        int imuGaps = std::count_if(imuDiffTime.begin(), imuDiffTime.end(), [medianDiffTime](double dt) {
-            return std::abs(dt - medianDiffTime) > medianDiffTime * 0.1;
-        });
-
-        // Gerar a string de log
-        oss << "IMU Model: " << imuModel << "\n";
-        oss << "IMU Samples: " << imuSamples << " (" << (imuData.timeStamp.back() - imuData.timeStamp.front()) / 60.0 << " minutes)\n";
-        oss << "IMU Freq: " << imuFreq << " Hz\n";
-        oss << "IMU Gaps: " << imuGaps << " (" << (static_cast<double>(imuGaps) / imuSamples * 100.0) << "%)\n\n";
-    } else {
-        oss << "No IMU data available.\n";
-    }
-
-    return oss.str();
-}
\ No newline at end of file
+    // Estatísticas calculadas numa passada, sem copiar as diferenças de tempo
+    return getLogStream(computeImuStats(imuData, imuModel));
+}
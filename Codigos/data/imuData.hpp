@@ -12,6 +12,10 @@
 #include <stdexcept>
 #include <cstdint>
 #include <sstream>
+#include "mappedFile.hpp"
+#include "dataCache.hpp"
+#include "dataExport.hpp"
+#include "dataLog.hpp"
 
 /**
  * @brief Struct to hold IMU data.
@@ -26,16 +30,102 @@ struct ImuData {
     std::vector<double> gz; ///< Gyroscope data in Z direction
 };
 
+/**
+ * @brief Raw IMU record as stored in the binary log (32 bytes, little-endian).
+ */
+struct ImuRecord {
+    uint32_t timeLow; ///< Lower 32 bits of the timestamp in nanoseconds
+    uint32_t timeHigh; ///< Upper 32 bits of the timestamp in nanoseconds
+    int32_t gx; ///< Gyroscope count in X direction
+    int32_t gy; ///< Gyroscope count in Y direction
+    int32_t gz; ///< Gyroscope count in Z direction
+    int32_t accx; ///< Accelerometer count in X direction
+    int32_t accy; ///< Accelerometer count in Y direction
+    int32_t accz; ///< Accelerometer count in Z direction
+};
+static_assert(sizeof(ImuRecord) == 32, "ImuRecord must match the 32-byte record of the binary log");
+
+/**
+ * @brief Gets the timestamp of a raw IMU record in nanoseconds.
+ */
+inline uint64_t imuRecordNanoseconds(const ImuRecord &r) {
+    return (static_cast<uint64_t>(r.timeHigh) << 32) | r.timeLow;
+}
+
+/**
+ * @brief Gets the timestamp of a raw IMU record in seconds.
+ */
+inline double imuRecordTime(const ImuRecord &r) {
+    return static_cast<double>(imuRecordNanoseconds(r)) / 1e9;
+}
+
+/**
+ * @brief Gets the scaling factors of an IMU model.
+ * 
+ * @param imuModel The IMU model (16495 or 16490).
+ * @param anglfak Output gyroscope scale (deg/s per count).
+ * @param accelfak Output accelerometer scale (g per count).
+ * @return bool False if the model is not implemented.
+ */
+bool imuScaleFactors(int imuModel, double &anglfak, double &accelfak);
+
+/**
+ * @brief Determines the IMU model from the first samples of a log.
+ * 
+ * The first 10 samples are scaled with each candidate model and the model whose
+ * mean acceleration norm is within 5% of 1g is selected.
+ * 
+ * @param records The raw IMU records.
+ * @param numSamples The number of records available.
+ * @param imuModel The IMU model to check. If 0, all implemented models are tried.
+ * @return int The detected IMU model.
+ * @throws std::runtime_error If no model matches gravity.
+ */
+int detectImuModel(const ImuRecord *records, size_t numSamples, int imuModel);
+
+/**
+ * @brief Views a mapped IMU binary log as an array of records.
+ * 
+ * @param file The mapped file.
+ * @param fileName The name of the file, used in error messages.
+ * @param numSamples Output number of records in the file.
+ * @return const ImuRecord* Pointer to the first record.
+ * @throws std::runtime_error If the file ends with a truncated record.
+ */
+const ImuRecord* imuRecords(const MappedFile &file, const std::string &fileName, size_t &numSamples);
+
 /**
  * @brief Loads IMU data from a binary file.
  * 
+ * The file may also be a compressed archive (see writeImuArchive); it is detected
+ * by its header and decoded block-parallel.
+ * 
  * @param fileName The name of the file to load data from.
  * @param imuModel The IMU model to use. If 0, the function will try to determine the model.
  * @param logData If true, the function will log the IMU data.
+ * @param cache How to use the decoded-data cache next to the file (see CacheMode).
  * @return ImuData The loaded IMU data.
  * @throws std::runtime_error If there is an error reading the file or the IMU data is not valid.
  */
-ImuData loadImuData(const std::string &fileName, int &imuModel, bool logData);
+ImuData loadImuData(const std::string &fileName, int &imuModel, bool logData, CacheMode cache = CacheMode::Use);
+
+/**
+ * @brief Loads IMU data from a binary file straight into caller-provided columns.
+ * 
+ * The samples left after removing duplicate timestamps are counted first, so
+ * the destination is allocated once with its final size and no intermediate
+ * ImuData is built. The values are the same as those of the ImuData overload.
+ * Compressed archives are accepted as well.
+ * 
+ * @param fileName The name of the file to load data from.
+ * @param imuModel The IMU model to use. If 0, the function will try to determine the model.
+ * @param allocate Called once with the number of samples; returns where to write them.
+ * @param cache How to use the decoded-data cache next to the file (see CacheMode).
+ * @return size_t The number of samples written.
+ * @throws std::runtime_error If there is an error reading the file or the IMU data is not valid.
+ */
+size_t loadImuData(const std::string &fileName, int &imuModel, const ImuColumnAllocator &allocate,
+                   CacheMode cache = CacheMode::Use);
 
 /**
  * @brief Removes lines with duplicate timestamps from IMU data.
@@ -45,7 +135,7 @@ ImuData loadImuData(const std::string &fileName, int &imuModel, bool logData);
 void removeDuplicateTimestamps(ImuData& imuData);
 
 /**
- * @brief Logs IMU data to the console.
+ * @brief Logs IMU data to the console (dataLog() of the calling thread).
  * 
  * @param imuData The IMU data to log.
  * @param imuModel The IMU model used.
@@ -62,7 +152,9 @@ std::string getLogStream(const ImuData &imuData, int imuModel);
  * @param outputFileName The name of the file to output data to.
  * @param initialIndex The initial index of the data to output.
  * @param finalIndex The final index of the data to output.
+ * @throws std::invalid_argument If the indices are out of range.
  * @throws std::runtime_error If there is an error opening the output file.
+ * @see exportImuData for CSV and binary output.
  */
 void outputImuData(const ImuData& imuData, const std::string& outputFileName, size_t initialIndex, size_t finalIndex);
 
@@ -0,0 +1,269 @@
+#include "imuLive.hpp"
+#include <cstring>
+#include <cerrno>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+namespace {
+
+// Número de amostras usadas por detectImuModel
+const size_t modelCheckRecords = 10;
+
+// Intervalo em que uma leitura bloqueada de pipe ou socket verifica stop()
+const int blockingCheckMs = 20;
+
+#ifdef _WIN32
+
+int openSource(const std::string &fileName, bool &regularFile) {
+    regularFile = true;
+    int fd = _open(fileName.c_str(), _O_RDONLY | _O_BINARY);
+    if (fd < 0) {
+        throw std::runtime_error("Unable to open file " + fileName + ": " + std::strerror(errno));
+    }
+    return fd;
+}
+
+long readSome(int fd, char *buffer, size_t size) {
+    return _read(fd, buffer, static_cast<unsigned>(size));
+}
+
+void closeSource(int fd) {
+    _close(fd);
+}
+
+#else
+
+int openSource(const std::string &fileName, bool &regularFile) {
+    struct stat info;
+    if (stat(fileName.c_str(), &info) != 0) {
+        throw std::runtime_error("Unable to open file " + fileName + ": " + std::strerror(errno));
+    }
+    regularFile = S_ISREG(info.st_mode);
+
+    int fd = -1;
+    if (S_ISSOCK(info.st_mode)) {
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (fileName.size() >= sizeof(address.sun_path)) {
+            throw std::runtime_error("Socket path is too long: " + fileName);
+        }
+        std::memcpy(address.sun_path, fileName.c_str(), fileName.size());
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            int e = errno;
+            close(fd);
+            throw std::runtime_error("Unable to connect to socket " + fileName + ": " + std::strerror(e));
+        }
+    } else {
+        // Um FIFO aberto sem O_NONBLOCK esperaria pelo escritor sem ver stop()
+        fd = open(fileName.c_str(), O_RDONLY | (regularFile ? 0 : O_NONBLOCK));
+    }
+    if (fd < 0) {
+        throw std::runtime_error("Unable to open file " + fileName + ": " + std::strerror(errno));
+    }
+    return fd;
+}
+
+long readSome(int fd, char *buffer, size_t size) {
+    return static_cast<long>(read(fd, buffer, size));
+}
+
+void closeSource(int fd) {
+    close(fd);
+}
+
+#endif
+
+} // namespace
+
+ImuLiveReader::ImuLiveReader(const std::string &fileName, int imuModel, const ImuLiveOptions &options)
+    : fileName_(fileName), options_(options), ring_(std::max<size_t>(options.ringCapacity, 1)), givenModel_(imuModel)
+{
+    struct stat info;
+    if (stat(fileName.c_str(), &info) != 0) {
+        throw std::runtime_error("Unable to open file " + fileName + ": " + std::strerror(errno));
+    }
+    if (imuModel != 0 && !imuScaleFactors(imuModel, anglfak_, accelfak_)) {
+        throw std::invalid_argument("IMU model " + std::to_string(imuModel) + " is not implemented.");
+    }
+    firstRecords_.reserve(modelCheckRecords);
+    thread_ = std::thread([this]() { run(); });
+}
+
+ImuLiveReader::~ImuLiveReader() {
+    stop();
+}
+
+void ImuLiveReader::stop() {
+    stop_.store(true, std::memory_order_release);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+bool ImuLiveReader::tryPop(ImuSample &sample) {
+    return ring_.pop(sample);
+}
+
+bool ImuLiveReader::pop(ImuSample &sample, std::chrono::microseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (unsigned spin = 0;; ++spin) {
+        // done_ é lido antes do anel para não perder amostras emitidas logo antes do fim
+        bool done = done_.load(std::memory_order_acquire);
+        if (ring_.pop(sample)) {
+            return true;
+        }
+        if (done || std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        // Curta espera ativa, depois pausas curtas para não ocupar um núcleo
+        if (spin < 64) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(20));
+        }
+    }
+}
+
+bool ImuLiveReader::finished() const {
+    return done_.load(std::memory_order_acquire) && ring_.size() == 0;
+}
+
+std::string ImuLiveReader::error() const {
+    std::lock_guard<std::mutex> lock(errorMutex_);
+    return error_;
+}
+
+void ImuLiveReader::run() {
+    int fd = -1;
+    try {
+        bool regularFile = true;
+        fd = openSource(fileName_, regularFile);
+        readSource(fd, regularFile);
+
+        // Fluxo com menos de 10 registros: detecta com o que chegou
+        if (imuModel() == 0 && !firstRecords_.empty() && !stop_.load(std::memory_order_acquire)) {
+            int model = detectImuModel(firstRecords_.data(), firstRecords_.size(), givenModel_);
+            imuScaleFactors(model, anglfak_, accelfak_);
+            imuModel_.store(model, std::memory_order_release);
+            for (const ImuRecord &record : firstRecords_) {
+                emit(record);
+            }
+            firstRecords_.clear();
+        }
+    } catch (const std::exception &e) {
+        std::lock_guard<std::mutex> lock(errorMutex_);
+        error_ = e.what();
+    }
+    if (fd >= 0) {
+        closeSource(fd);
+    }
+    done_.store(true, std::memory_order_release);
+}
+
+void ImuLiveReader::readSource(int fd, bool regularFile) {
+    // Os bytes de um registro incompleto ficam no início do buffer até a próxima leitura
+    std::vector<char> buffer(4096 * sizeof(ImuRecord));
+    size_t pending = 0;
+
+    while (!stop_.load(std::memory_order_acquire)) {
+#ifndef _WIN32
+        if (!regularFile) {
+            pollfd request = {fd, POLLIN, 0};
+            int ready = poll(&request, 1, blockingCheckMs);
+            if (ready < 0 && errno != EINTR) {
+                throw std::runtime_error("Error waiting for " + fileName_ + ": " + std::strerror(errno));
+            }
+            if (ready <= 0) {
+                continue;
+            }
+        }
+#endif
+        long n = readSome(fd, buffer.data() + pending, buffer.size() - pending);
+        if (n < 0) {
+            if (errno == EINTR || errno == EAGAIN) {
+                continue;
+            }
+            throw std::runtime_error("Error reading " + fileName_ + ": " + std::strerror(errno));
+        }
+        if (n == 0) {
+            // Fim atual de um arquivo em crescimento: espera o escritor
+            if (regularFile && options_.follow) {
+                std::this_thread::sleep_for(options_.pollInterval);
+                continue;
+            }
+            break;
+        }
+
+        size_t available = pending + static_cast<size_t>(n);
+        size_t numComplete = available / sizeof(ImuRecord);
+        for (size_t i = 0; i < numComplete; ++i) {
+            ImuRecord record;
+            std::memcpy(&record, buffer.data() + i * sizeof(ImuRecord), sizeof(ImuRecord));
+            addRecord(record);
+        }
+        numRecords_.fetch_add(numComplete, std::memory_order_relaxed);
+        pending = available - numComplete * sizeof(ImuRecord);
+        std::memmove(buffer.data(), buffer.data() + numComplete * sizeof(ImuRecord), pending);
+    }
+
+    if (pending != 0 && !stop_.load(std::memory_order_acquire)) {
+        throw std::runtime_error("IMU stream " + fileName_ + " ends with a truncated record.");
+    }
+}
+
+void ImuLiveReader::addRecord(const ImuRecord &record) {
+    if (imuModel() != 0) {
+        emit(record);
+        return;
+    }
+    firstRecords_.push_back(record);
+    if (firstRecords_.size() < modelCheckRecords) {
+        return;
+    }
+    int model = detectImuModel(firstRecords_.data(), firstRecords_.size(), givenModel_);
+    imuScaleFactors(model, anglfak_, accelfak_);
+    imuModel_.store(model, std::memory_order_release);
+    for (const ImuRecord &r : firstRecords_) {
+        emit(r);
+    }
+    firstRecords_.clear();
+}
+
+void ImuLiveReader::emit(const ImuRecord &record) {
+    double t = imuRecordTime(record);
+    if (hasLast_ && t == lastTimeStamp_) {
+        numDuplicates_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    hasLast_ = true;
+    lastTimeStamp_ = t;
+
+    ImuSample sample;
+    sample.timeStamp = t;
+    sample.gx = static_cast<double>(record.gx) * anglfak_;
+    sample.gy = static_cast<double>(record.gy) * anglfak_;
+    sample.gz = static_cast<double>(record.gz) * anglfak_;
+    sample.accx = static_cast<double>(record.accx) * accelfak_;
+    sample.accy = static_cast<double>(record.accy) * accelfak_;
+    sample.accz = static_cast<double>(record.accz) * accelfak_;
+
+    // Anel cheio: espera o consumidor em vez de descartar
+    while (!ring_.push(sample)) {
+        if (stop_.load(std::memory_order_acquire)) {
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+}
@@ -0,0 +1,137 @@
+#ifndef IMU_LIVE_HPP
+#define IMU_LIVE_HPP
+
+#include <string>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+#include "imuData.hpp"
+#include "spscRing.hpp"
+
+/**
+ * @brief One scaled IMU sample.
+ */
+struct ImuSample {
+    double timeStamp = 0.0; ///< Timestamp in seconds
+    double accx = 0.0; ///< Accelerometer data in X direction (g)
+    double accy = 0.0; ///< Accelerometer data in Y direction (g)
+    double accz = 0.0; ///< Accelerometer data in Z direction (g)
+    double gx = 0.0; ///< Gyroscope data in X direction (deg/s)
+    double gy = 0.0; ///< Gyroscope data in Y direction (deg/s)
+    double gz = 0.0; ///< Gyroscope data in Z direction (deg/s)
+};
+
+/**
+ * @brief Options of ImuLiveReader.
+ */
+struct ImuLiveOptions {
+    size_t ringCapacity = 16384; ///< Samples buffered between the reader and the consumer
+    std::chrono::microseconds pollInterval{100}; ///< Wait before reading a regular file again at its end
+    bool follow = true; ///< Keep waiting for new data at the end of a regular file (like tail -f)
+};
+
+/**
+ * @brief Reads a growing IMU binary log while it is being written.
+ *
+ * A reader thread decodes the complete 32-byte records of the source into a
+ * lock-free single-producer/single-consumer ring, which one consumer thread
+ * drains with pop(). The source is a regular file (tailed until stop(), or read
+ * to its end if options.follow is false), a FIFO or, on POSIX systems, a Unix
+ * domain stream socket; pipes and sockets end when the writer closes them.
+ *
+ * The IMU model is detected once the first 10 records have arrived (or at the
+ * end, for a shorter stream), so those first samples wait for it. Duplicate
+ * timestamps are dropped as they arrive, so the popped samples are the ones
+ * loadImuData gives for the final file. When the ring is full the reader waits
+ * for the consumer; no sample is lost.
+ */
+class ImuLiveReader {
+public:
+    /**
+     * @brief Starts reading a source.
+     *
+     * @param fileName The file, FIFO or socket to read.
+     * @param imuModel The IMU model to use. If 0, the model is detected from the first samples.
+     * @param options The reader options.
+     * @throws std::runtime_error If the source does not exist.
+     * @throws std::invalid_argument If imuModel is not implemented.
+     */
+    explicit ImuLiveReader(const std::string &fileName, int imuModel = 0,
+                           const ImuLiveOptions &options = ImuLiveOptions());
+
+    /**
+     * @brief Stops the reader thread.
+     */
+    ~ImuLiveReader();
+
+    ImuLiveReader(const ImuLiveReader&) = delete;
+    ImuLiveReader& operator=(const ImuLiveReader&) = delete;
+
+    /**
+     * @brief Gets the next sample without waiting.
+     *
+     * @param sample The sample to fill.
+     * @return bool False if no sample is ready.
+     */
+    bool tryPop(ImuSample &sample);
+
+    /**
+     * @brief Gets the next sample, waiting up to a timeout for it.
+     *
+     * @param sample The sample to fill.
+     * @param timeout The longest time to wait.
+     * @return bool False on timeout or if the stream has finished.
+     */
+    bool pop(ImuSample &sample, std::chrono::microseconds timeout);
+
+    /**
+     * @brief Stops reading. The samples already in the ring can still be popped.
+     */
+    void stop();
+
+    /**
+     * @brief Checks whether the stream has ended and every sample has been popped.
+     */
+    bool finished() const;
+
+    /**
+     * @brief Gets the error that stopped the reader thread.
+     *
+     * @return std::string The error message, empty if there was none.
+     */
+    std::string error() const;
+
+    int imuModel() const { return imuModel_.load(std::memory_order_acquire); } ///< IMU model (0 until detected)
+    uint64_t numRecords() const { return numRecords_.load(std::memory_order_relaxed); } ///< Complete records read
+    uint64_t numDuplicates() const { return numDuplicates_.load(std::memory_order_relaxed); } ///< Records dropped as duplicates
+
+private:
+    void run();
+    void readSource(int fd, bool regularFile);
+    void addRecord(const ImuRecord &record);
+    void emit(const ImuRecord &record);
+
+    std::string fileName_;
+    ImuLiveOptions options_;
+    SpscRing<ImuSample> ring_;
+    std::thread thread_;
+    std::atomic<bool> stop_{false};
+    std::atomic<bool> done_{false};
+    std::atomic<int> imuModel_{0};
+    std::atomic<uint64_t> numRecords_{0};
+    std::atomic<uint64_t> numDuplicates_{0};
+    mutable std::mutex errorMutex_;
+    std::string error_;
+
+    // Estado da thread de leitura
+    int givenModel_ = 0;
+    double anglfak_ = 0.0;
+    double accelfak_ = 0.0;
+    std::vector<ImuRecord> firstRecords_; ///< Records held until the model is known
+    bool hasLast_ = false;
+    double lastTimeStamp_ = 0.0;
+};
+
+#endif // IMU_LIVE_HPP
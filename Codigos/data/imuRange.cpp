@@ -0,0 +1,148 @@
+#include "imuRange.hpp"
+
+namespace {
+
+// Tempo usado na busca binária: mediana do registro e de seus vizinhos, para
+// que um timestamp isolado fora de ordem não desvie a busca
+double probeTime(const ImuRecord* records, size_t numSamples, size_t i) {
+    size_t first = i >= 2 ? i - 2 : 0;
+    size_t last = std::min(i + 3, numSamples);
+    double times[5];
+    size_t count = 0;
+    for (size_t j = first; j < last; ++j) {
+        times[count++] = imuRecordTime(records[j]);
+    }
+    std::nth_element(times, times + count / 2, times + count);
+    return times[count / 2];
+}
+
+// Primeiro registro cujo tempo de sondagem satisfaz before(t) == false
+template <typename Before>
+size_t partitionPoint(const ImuRecord* records, size_t numSamples, Before before) {
+    size_t lo = 0;
+    size_t hi = numSamples;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (before(probeTime(records, numSamples, mid))) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+} // namespace
+
+ImuTimeIndex::ImuTimeIndex(const std::string& fileName, size_t blockSize) {
+    MappedFile file(fileName);
+    size_t numSamples = 0;
+    const ImuRecord* records = imuRecords(file, fileName, numSamples);
+    *this = ImuTimeIndex(records, numSamples, blockSize);
+}
+
+ImuTimeIndex::ImuTimeIndex(const ImuRecord* records, size_t numSamples, size_t blockSize)
+    : numSamples_(numSamples), blockSize_(std::max<size_t>(blockSize, 1)) {
+    size_t numBlocks = (numSamples_ + blockSize_ - 1) / blockSize_;
+    prefixMax_.resize(numBlocks);
+    suffixMin_.resize(numBlocks);
+
+    // Mínimo e máximo de cada bloco
+    for (size_t b = 0; b < numBlocks; ++b) {
+        uint64_t lo = UINT64_MAX;
+        uint64_t hi = 0;
+        for (size_t i = b * blockSize_; i < std::min(numSamples_, (b + 1) * blockSize_); ++i) {
+            uint64_t t = imuRecordNanoseconds(records[i]);
+            lo = std::min(lo, t);
+            hi = std::max(hi, t);
+        }
+        prefixMax_[b] = hi;
+        suffixMin_[b] = lo;
+    }
+
+    // Máximo acumulado do início e mínimo acumulado do fim
+    for (size_t b = 1; b < numBlocks; ++b) {
+        prefixMax_[b] = std::max(prefixMax_[b], prefixMax_[b - 1]);
+    }
+    for (size_t b = numBlocks; b-- > 1;) {
+        suffixMin_[b - 1] = std::min(suffixMin_[b - 1], suffixMin_[b]);
+    }
+}
+
+std::pair<size_t, size_t> ImuTimeIndex::candidates(double t0, double t1) const {
+    // Os tempos são comparados em segundos, como em ImuData::timeStamp
+    auto seconds = [](uint64_t ns) { return static_cast<double>(ns) / 1e9; };
+
+    // Primeiro bloco com algum tempo >= t0 até ele e último com algum tempo <= t1 a partir dele
+    size_t firstBlock = std::partition_point(prefixMax_.begin(), prefixMax_.end(),
+                                             [&](uint64_t t) { return seconds(t) < t0; }) - prefixMax_.begin();
+    size_t endBlock = std::partition_point(suffixMin_.begin(), suffixMin_.end(),
+                                           [&](uint64_t t) { return seconds(t) <= t1; }) - suffixMin_.begin();
+    if (firstBlock >= endBlock) {
+        return {0, 0};
+    }
+    return {firstBlock * blockSize_, std::min(numSamples_, endBlock * blockSize_)};
+}
+
+ImuData loadImuRange(const std::string& fileName, double t0, double t1, int& imuModel, const ImuTimeIndex* index) {
+    if (t0 > t1) {
+        throw std::invalid_argument("Invalid time window.");
+    }
+
+    MappedFile file(fileName);
+    size_t numSamples = 0;
+    const ImuRecord* records = imuRecords(file, fileName, numSamples);
+    if (index != nullptr && index->numSamples() != numSamples) {
+        throw std::invalid_argument("Time index does not match " + fileName);
+    }
+
+    // The model is detected from the start of the file, as in loadImuData
+    imuModel = detectImuModel(records, numSamples, imuModel);
+    double anglfak = 0.0, accelfak = 0.0;
+    imuScaleFactors(imuModel, anglfak, accelfak);
+
+    size_t first, last;
+    if (index != nullptr) {
+        std::tie(first, last) = index->candidates(t0, t1);
+    } else {
+        first = partitionPoint(records, numSamples, [&](double t) { return t < t0; });
+        last = partitionPoint(records, numSamples, [&](double t) { return t <= t1; });
+        first = first > disorderMargin ? first - disorderMargin : 0;
+        last = std::min(numSamples, last + disorderMargin);
+    }
+
+    ImuData imuData;
+    if (first >= last) {
+        return imuData;
+    }
+    size_t capacity = last - first;
+    imuData.timeStamp.reserve(capacity);
+    imuData.gx.reserve(capacity);
+    imuData.gy.reserve(capacity);
+    imuData.gz.reserve(capacity);
+    imuData.accx.reserve(capacity);
+    imuData.accy.reserve(capacity);
+    imuData.accz.reserve(capacity);
+
+    // loadImuData drops a sample whose timestamp repeats the previous record's,
+    // including across the start of the range
+    double previous = first > 0 ? imuRecordTime(records[first - 1]) : 0.0;
+    for (size_t i = first; i < last; ++i) {
+        const ImuRecord& r = records[i];
+        double t = imuRecordTime(r);
+        bool duplicate = i > 0 && t == previous;
+        previous = t;
+        if (duplicate || t < t0 || t > t1) {
+            continue;
+        }
+        imuData.timeStamp.push_back(t);
+        imuData.gx.push_back(static_cast<double>(r.gx) * anglfak);
+        imuData.gy.push_back(static_cast<double>(r.gy) * anglfak);
+        imuData.gz.push_back(static_cast<double>(r.gz) * anglfak);
+        imuData.accx.push_back(static_cast<double>(r.accx) * accelfak);
+        imuData.accy.push_back(static_cast<double>(r.accy) * accelfak);
+        imuData.accz.push_back(static_cast<double>(r.accz) * accelfak);
+    }
+
+    return imuData;
+}
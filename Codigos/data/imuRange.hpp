@@ -0,0 +1,92 @@
+#ifndef IMU_RANGE_HPP
+#define IMU_RANGE_HPP
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <tuple>
+#include "imuData.hpp"
+
+/**
+ * @brief Sparse time index of an IMU binary log.
+ *
+ * Keeps, for each block of records, the largest timestamp up to the end of the
+ * block and the smallest timestamp from its start to the end of the file. Both
+ * are monotonic even when the timestamps are not, so the blocks that can hold a
+ * time window are found exactly, whatever the gaps or out-of-order records.
+ * Building it reads every timestamp once; queries do not touch the file.
+ */
+class ImuTimeIndex {
+public:
+    static constexpr size_t defaultBlockSize = 4096; ///< Records per block
+
+    ImuTimeIndex() = default;
+
+    /**
+     * @brief Builds the index of an IMU binary log.
+     *
+     * @param fileName The name of the IMU binary file.
+     * @param blockSize The number of records per block.
+     * @throws std::runtime_error If the file cannot be read.
+     */
+    explicit ImuTimeIndex(const std::string& fileName, size_t blockSize = defaultBlockSize);
+
+    /**
+     * @brief Builds the index of records already in memory.
+     *
+     * @param records The raw IMU records.
+     * @param numSamples The number of records.
+     * @param blockSize The number of records per block.
+     */
+    ImuTimeIndex(const ImuRecord* records, size_t numSamples, size_t blockSize = defaultBlockSize);
+
+    /**
+     * @brief Gets the records [first, last) that may have timestamps in [t0, t1].
+     *
+     * Every record with a timestamp in the window is inside the returned range.
+     *
+     * @param t0 Start of the window in seconds.
+     * @param t1 End of the window in seconds.
+     */
+    std::pair<size_t, size_t> candidates(double t0, double t1) const;
+
+    size_t numSamples() const { return numSamples_; } ///< Number of records indexed
+    size_t blockSize() const { return blockSize_; } ///< Records per block
+
+private:
+    size_t numSamples_ = 0;
+    size_t blockSize_ = defaultBlockSize;
+    std::vector<uint64_t> prefixMax_; ///< Largest timestamp in blocks [0, b]
+    std::vector<uint64_t> suffixMin_; ///< Smallest timestamp in blocks [b, end)
+};
+
+/**
+ * @brief Records added on each side of the range found by the binary search.
+ */
+const size_t disorderMargin = 64;
+
+/**
+ * @brief Loads the IMU samples of a time window from a binary file.
+ *
+ * Without an index, the mapped records are binary-searched on their timestamps.
+ * Each probe uses the median of 5 neighbouring timestamps and the range found is
+ * widened by disorderMargin records on each side, so isolated out-of-order
+ * timestamps do not hide samples of the window. With an index the search is exact.
+ * Only the records of the range are decoded. The samples are the ones loadImuData
+ * returns whose timestamps are in [t0, t1], in file order.
+ *
+ * @param fileName The name of the IMU binary file.
+ * @param t0 Start of the window in seconds (same time base as ImuData::timeStamp).
+ * @param t1 End of the window in seconds, inclusive.
+ * @param imuModel The IMU model to use. If 0, it is determined from the first samples of the file.
+ * @param index Optional time index of the file, for logs with long disordered stretches.
+ * @return ImuData The samples of the window (empty if there are none).
+ * @throws std::invalid_argument If t0 > t1 or the index does not match the file.
+ * @throws std::runtime_error If there is an error reading the file or the IMU data is not valid.
+ */
+ImuData loadImuRange(const std::string& fileName, double t0, double t1, int& imuModel,
+                     const ImuTimeIndex* index = nullptr);
+
+#endif // IMU_RANGE_HPP
@@ -0,0 +1,112 @@
+#include "imuRawData.hpp"
+#include "imuArchive.hpp"
+
+const std::vector<int32_t>& ImuRawData::counts(ImuChannel channel) const {
+    switch (channel) {
+    case ImuChannel::AccX:
+        return accx;
+    case ImuChannel::AccY:
+        return accy;
+    case ImuChannel::AccZ:
+        return accz;
+    case ImuChannel::Gx:
+        return gx;
+    case ImuChannel::Gy:
+        return gy;
+    default:
+        return gz;
+    }
+}
+
+double ImuRawData::scale(ImuChannel channel) const {
+    bool accelerometer = channel == ImuChannel::AccX || channel == ImuChannel::AccY || channel == ImuChannel::AccZ;
+    return accelerometer ? accelfak : anglfak;
+}
+
+void ImuRawData::scaled(ImuChannel channel, size_t first, size_t last, double* out) const {
+    // Laço simples, sem dependências, que o compilador vetoriza
+    const int32_t* in = counts(channel).data();
+    double factor = scale(channel);
+    for (size_t i = first; i < last; ++i) {
+        out[i - first] = static_cast<double>(in[i]) * factor;
+    }
+}
+
+void ImuRawData::timeStamps(size_t first, size_t last, double* out) const {
+    const uint64_t* in = timeNs.data();
+    for (size_t i = first; i < last; ++i) {
+        out[i - first] = static_cast<double>(in[i]) / 1e9;
+    }
+}
+
+ImuData ImuRawData::toImuData(size_t first, size_t last) const {
+    if (first > last || last > size()) {
+        throw std::invalid_argument("Invalid indices.");
+    }
+    size_t n = last - first;
+    ImuData imuData;
+    imuData.timeStamp.resize(n);
+    imuData.accx.resize(n);
+    imuData.accy.resize(n);
+    imuData.accz.resize(n);
+    imuData.gx.resize(n);
+    imuData.gy.resize(n);
+    imuData.gz.resize(n);
+    timeStamps(first, last, imuData.timeStamp.data());
+    scaled(ImuChannel::AccX, first, last, imuData.accx.data());
+    scaled(ImuChannel::AccY, first, last, imuData.accy.data());
+    scaled(ImuChannel::AccZ, first, last, imuData.accz.data());
+    scaled(ImuChannel::Gx, first, last, imuData.gx.data());
+    scaled(ImuChannel::Gy, first, last, imuData.gy.data());
+    scaled(ImuChannel::Gz, first, last, imuData.gz.data());
+    return imuData;
+}
+
+ImuRawData loadImuRawData(const std::string& fileName, int& imuModel) {
+    MappedFile file(fileName);
+    size_t numSamples = 0;
+    std::vector<ImuRecord> archived;
+    const ImuRecord* records = readImuRecords(file, fileName, archived, numSamples);
+
+    ImuRawData raw;
+    imuModel = detectImuModel(records, numSamples, imuModel);
+    raw.imuModel = imuModel;
+    imuScaleFactors(imuModel, raw.anglfak, raw.accelfak);
+
+    raw.timeNs.resize(numSamples);
+    raw.accx.resize(numSamples);
+    raw.accy.resize(numSamples);
+    raw.accz.resize(numSamples);
+    raw.gx.resize(numSamples);
+    raw.gy.resize(numSamples);
+    raw.gz.resize(numSamples);
+
+    // Duplicatas comparadas em segundos, como em loadImuData
+    size_t numUnique = 0;
+    double lastTime = 0.0;
+    for (size_t i = 0; i < numSamples; ++i) {
+        const ImuRecord& r = records[i];
+        double t = imuRecordTime(r);
+        if (numUnique > 0 && t == lastTime) {
+            continue;
+        }
+        lastTime = t;
+        raw.timeNs[numUnique] = imuRecordNanoseconds(r);
+        raw.accx[numUnique] = r.accx;
+        raw.accy[numUnique] = r.accy;
+        raw.accz[numUnique] = r.accz;
+        raw.gx[numUnique] = r.gx;
+        raw.gy[numUnique] = r.gy;
+        raw.gz[numUnique] = r.gz;
+        ++numUnique;
+    }
+
+    raw.timeNs.resize(numUnique);
+    raw.accx.resize(numUnique);
+    raw.accy.resize(numUnique);
+    raw.accz.resize(numUnique);
+    raw.gx.resize(numUnique);
+    raw.gy.resize(numUnique);
+    raw.gz.resize(numUnique);
+    return raw;
+}
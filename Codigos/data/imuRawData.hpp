@@ -0,0 +1,101 @@
+#ifndef IMU_RAW_DATA_HPP
+#define IMU_RAW_DATA_HPP
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include "imuData.hpp"
+
+/**
+ * @brief IMU channels of ImuRawData.
+ */
+enum class ImuChannel {
+    AccX, AccY, AccZ, Gx, Gy, Gz
+};
+
+/**
+ * @brief Compact IMU data: integer timestamps and raw counts (32 bytes per sample).
+ *
+ * Holds the log as decoded from the file, before scaling, so it takes about
+ * half the memory of ImuData. Values in physical units are computed when read,
+ * with the same operations as loadImuData, so they are identical to it.
+ */
+struct ImuRawData {
+    int imuModel = 0; ///< IMU model
+    double anglfak = 0.0; ///< Gyroscope scale (deg/s per count)
+    double accelfak = 0.0; ///< Accelerometer scale (g per count)
+    std::vector<uint64_t> timeNs; ///< Timestamps in nanoseconds
+    std::vector<int32_t> accx; ///< Accelerometer counts in X direction
+    std::vector<int32_t> accy; ///< Accelerometer counts in Y direction
+    std::vector<int32_t> accz; ///< Accelerometer counts in Z direction
+    std::vector<int32_t> gx; ///< Gyroscope counts in X direction
+    std::vector<int32_t> gy; ///< Gyroscope counts in Y direction
+    std::vector<int32_t> gz; ///< Gyroscope counts in Z direction
+
+    size_t size() const { return timeNs.size(); } ///< Number of samples
+
+    /**
+     * @brief Gets a timestamp in seconds (as ImuData::timeStamp).
+     */
+    double timeStamp(size_t i) const { return static_cast<double>(timeNs[i]) / 1e9; }
+
+    /**
+     * @brief Gets a sample of a channel in physical units (g or deg/s).
+     */
+    double value(ImuChannel channel, size_t i) const {
+        return static_cast<double>(counts(channel)[i]) * scale(channel);
+    }
+
+    /**
+     * @brief Gets the raw counts of a channel.
+     */
+    const std::vector<int32_t>& counts(ImuChannel channel) const;
+
+    /**
+     * @brief Gets the scale of a channel (g or deg/s per count).
+     */
+    double scale(ImuChannel channel) const;
+
+    /**
+     * @brief Converts samples [first, last) of a channel to physical units.
+     *
+     * @param channel The channel.
+     * @param first The first sample.
+     * @param last One past the last sample.
+     * @param out Output buffer with room for last - first values.
+     */
+    void scaled(ImuChannel channel, size_t first, size_t last, double* out) const;
+
+    /**
+     * @brief Converts timestamps [first, last) to seconds.
+     */
+    void timeStamps(size_t first, size_t last, double* out) const;
+
+    /**
+     * @brief Converts samples [first, last) to ImuData.
+     *
+     * @throws std::invalid_argument If the indices are out of range.
+     */
+    ImuData toImuData(size_t first, size_t last) const;
+
+    /**
+     * @brief Converts all samples to ImuData.
+     */
+    ImuData toImuData() const { return toImuData(0, size()); }
+};
+
+/**
+ * @brief Loads IMU data from a binary file without scaling it.
+ *
+ * Duplicate timestamps are removed as in loadImuData, so toImuData() gives the
+ * same data as loadImuData.
+ *
+ * @param fileName The name of the file to load data from.
+ * @param imuModel The IMU model to use. If 0, the function will try to determine the model.
+ * @return ImuRawData The loaded IMU data.
+ * @throws std::runtime_error If there is an error reading the file or the IMU data is not valid.
+ */
+ImuRawData loadImuRawData(const std::string& fileName, int& imuModel);
+
+#endif // IMU_RAW_DATA_HPP
@@ -0,0 +1,292 @@
+#include "imuResample.hpp"
+#include "logStats.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define RESAMPLE_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Amostras e pesos de cada alvo, comuns a todos os canais:
+// valor = (wa0 y[a] + wa1 y[a + 1]) + (wb0 y[b] + wb1 y[b + 1])
+struct Taps {
+    std::vector<size_t> a, b;
+    std::vector<double> wa0, wa1, wb0, wb1;
+
+    explicit Taps(size_t numTargets)
+        : a(numTargets, 0), b(numTargets, 0), wa0(numTargets, 0.0), wa1(numTargets, 0.0), wb0(numTargets, 0.0),
+          wb1(numTargets, 0.0) {}
+};
+
+void scalarTaps(const double* y, const Taps& taps, bool fourTaps, size_t first, size_t last, double* out) {
+    for (size_t k = first; k < last; ++k) {
+        size_t a = taps.a[k];
+        double value = taps.wa0[k] * y[a] + taps.wa1[k] * y[a + 1];
+        if (fourTaps) {
+            size_t b = taps.b[k];
+            value = value + (taps.wb0[k] * y[b] + taps.wb1[k] * y[b + 1]);
+        }
+        out[k] = value;
+    }
+}
+
+} // namespace
+
+#ifdef RESAMPLE_SIMD_X86
+
+namespace {
+
+namespace sse2 {
+
+struct Ops {
+    using V = __m128d;
+    static constexpr size_t width = 2;
+
+    static V load(const double* p) { return _mm_loadu_pd(p); }
+    static void store(double* p, V a) { _mm_storeu_pd(p, a); }
+    static V add(V a, V b) { return _mm_add_pd(a, b); }
+    static V mul(V a, V b) { return _mm_mul_pd(a, b); }
+    // p[i[0]], p[i[1]] (o SSE2 não tem gather)
+    static V gather(const double* p, const size_t* i) { return _mm_set_pd(p[i[1]], p[i[0]]); }
+};
+
+#include "imuResample.inl"
+
+} // namespace sse2
+
+} // namespace
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace {
+
+namespace avx2 {
+
+struct Ops {
+    using V = __m256d;
+    static constexpr size_t width = 4;
+
+    static V load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, V a) { _mm256_storeu_pd(p, a); }
+    static V add(V a, V b) { return _mm256_add_pd(a, b); }
+    static V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+    // p[i[0]], ..., p[i[3]]
+    static V gather(const double* p, const size_t* i) {
+        return _mm256_i64gather_pd(p, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(i)), 8);
+    }
+};
+
+#include "imuResample.inl"
+
+} // namespace avx2
+
+} // namespace
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // RESAMPLE_SIMD_X86
+
+namespace {
+
+void evaluate(const double* y, const Taps& taps, bool fourTaps, size_t numTargets, double* out, SimdLevel level) {
+    switch (level) {
+#ifdef RESAMPLE_SIMD_X86
+    case SimdLevel::Avx2:
+        avx2::tapKernel(y, taps, fourTaps, numTargets, out);
+        break;
+    case SimdLevel::Sse2:
+        sse2::tapKernel(y, taps, fourTaps, numTargets, out);
+        break;
+#endif
+    default:
+        scalarTaps(y, taps, fourTaps, 0, numTargets, out);
+        break;
+    }
+}
+
+} // namespace
+
+ResampledImu resampleImu(const ImuData& imuData, const double* targets, size_t numTargets,
+                         const ResampleOptions& options) {
+    const double* t = imuData.timeStamp.data();
+    const size_t n = imuData.timeStamp.size();
+    for (size_t s = 1; s < n; ++s) {
+        if (!(t[s] > t[s - 1])) {
+            throw std::invalid_argument("IMU timestamps must be increasing.");
+        }
+    }
+    for (size_t k = 1; k < numTargets; ++k) {
+        if (!(targets[k] > targets[k - 1])) {
+            throw std::invalid_argument("Target times must be increasing.");
+        }
+    }
+
+    ResampledImu result;
+    result.data.timeStamp.assign(targets, targets + numTargets);
+    result.flags.assign(numTargets, resampleOutside);
+    const double maxGap = options.maxGap > 0.0 ? options.maxGap : 1.1 * medianSampleInterval(imuData.timeStamp);
+    // Intervalo s vai de t[s - 1] a t[s]
+    auto isGap = [&](size_t s) { return t[s] - t[s - 1] > maxGap; };
+
+    // Caminhada única pelas duas sequências
+    Taps taps(numTargets);
+    const bool fourTaps = options.mode != ResampleMode::Linear;
+    size_t j = 0; // Primeira amostra com t[j] >= alvo
+    size_t scanned = 0, lastGap = 0; // Intervalos já verificados e o último com lacuna (0 = nenhum)
+    size_t previousInterval = 0;
+    double previousFraction = 0.0, previousTarget = 0.0;
+    bool previousInside = false;
+    for (size_t k = 0; k < numTargets; ++k) {
+        double target = targets[k] + options.timeOffset;
+        while (j < n && t[j] < target) {
+            ++j;
+        }
+        bool inside = n >= 2 && j < n && target >= t[0];
+        size_t i = std::max<size_t>(j, 1); // Intervalo que contém o alvo
+        double fraction = inside ? (target - t[i - 1]) / (t[i] - t[i - 1]) : 0.0;
+        for (; inside && options.mode == ResampleMode::IntegrateAndDump && scanned < i; ++scanned) {
+            if (isGap(scanned + 1)) {
+                lastGap = scanned + 1;
+            }
+        }
+
+        uint8_t flag = inside ? resampleOk : resampleOutside;
+        // Um alvo sobre uma amostra não interpola através do intervalo
+        bool acrossGap = fraction > 0.0 && fraction < 1.0 && isGap(i);
+        if (options.mode == ResampleMode::Linear) {
+            if (flag == resampleOk && acrossGap) {
+                flag = resampleGap;
+            }
+            if (flag == resampleOk) {
+                taps.a[k] = i - 1;
+                taps.wa0[k] = 1.0 - fraction;
+                taps.wa1[k] = fraction;
+            }
+        } else if (options.mode == ResampleMode::Cubic) {
+            if (flag == resampleOk && acrossGap) {
+                flag = resampleGap;
+            }
+            if (flag == resampleOk) {
+                // Hermite com inclinações centrais, ou a secante junto a lacunas e às pontas
+                double s = fraction, s2 = s * s, s3 = s2 * s, h = t[i] - t[i - 1];
+                double h00 = 2.0 * s3 - 3.0 * s2 + 1.0, h10 = s3 - 2.0 * s2 + s;
+                double h01 = -2.0 * s3 + 3.0 * s2, h11 = s3 - s2;
+                double w[4] = {0.0, h00, h01, 0.0}; // y[i - 2], y[i - 1], y[i], y[i + 1]
+                if (i >= 2 && !isGap(i - 1)) {
+                    double c = h10 * h / (t[i] - t[i - 2]);
+                    w[0] -= c;
+                    w[2] += c;
+                } else {
+                    w[1] -= h10;
+                    w[2] += h10;
+                }
+                if (i + 1 < n && !isGap(i + 1)) {
+                    double c = h11 * h / (t[i + 1] - t[i - 1]);
+                    w[3] += c;
+                    w[1] -= c;
+                } else {
+                    w[1] -= h11;
+                    w[2] += h11;
+                }
+                // Os pares de amostras ficam dentro dos dados nas pontas
+                taps.a[k] = i >= 2 ? i - 2 : i - 1;
+                taps.wa0[k] = i >= 2 ? w[0] : w[1];
+                taps.wa1[k] = i >= 2 ? w[1] : 0.0;
+                taps.b[k] = i + 1 < n ? i : i - 1;
+                taps.wb0[k] = i + 1 < n ? w[2] : 0.0;
+                taps.wb1[k] = i + 1 < n ? w[3] : w[2];
+            }
+        } else {
+            // Média na janela (alvo anterior, alvo] = diferença da integral acumulada
+            // nas pontas, cada uma interpolada linearmente
+            if (k == 0 || !previousInside) {
+                flag = resampleOutside;
+            }
+            size_t firstInterval = previousFraction == 1.0 ? previousInterval + 1 : previousInterval;
+            if (flag == resampleOk && lastGap >= firstInterval) {
+                flag = resampleGap;
+            }
+            if (flag == resampleOk) {
+                double scale = 1.0 / (target - previousTarget);
+                taps.a[k] = previousInterval - 1;
+                taps.wa0[k] = -(1.0 - previousFraction) * scale;
+                taps.wa1[k] = -previousFraction * scale;
+                taps.b[k] = i - 1;
+                taps.wb0[k] = (1.0 - fraction) * scale;
+                taps.wb1[k] = fraction * scale;
+            }
+            previousInterval = i;
+            previousFraction = fraction;
+            previousTarget = target;
+            previousInside = inside;
+        }
+        result.flags[k] = flag;
+        if (flag != resampleOk) {
+            ++result.numFlagged;
+        }
+    }
+
+    // Não usar um conjunto de instruções que a CPU não tem
+    static const SimdLevel supported = detectSimdLevel();
+    SimdLevel level = static_cast<int>(options.level) > static_cast<int>(supported) ? supported : options.level;
+
+    // Mesma ordem de ImuChannel
+    const std::vector<double>* columns[] = {&imuData.accx, &imuData.accy, &imuData.accz,
+                                            &imuData.gx,   &imuData.gy,   &imuData.gz};
+    std::vector<double>* outputs[] = {&result.data.accx, &result.data.accy, &result.data.accz,
+                                      &result.data.gx,   &result.data.gy,   &result.data.gz};
+    std::vector<double> integral;
+    for (ImuChannel channel : options.channels) {
+        std::vector<double>& out = *outputs[static_cast<size_t>(channel)];
+        out.assign(numTargets, std::numeric_limits<double>::quiet_NaN());
+        if (n < 2 || result.numFlagged == numTargets) {
+            continue;
+        }
+        const double* y = columns[static_cast<size_t>(channel)]->data();
+        if (options.mode == ResampleMode::IntegrateAndDump) {
+            // Cada amostra vale no intervalo que termina nela; a primeira não tem intervalo
+            integral.resize(n);
+            integral[0] = 0.0;
+            for (size_t s = 1; s < n; ++s) {
+                integral[s] = integral[s - 1] + y[s] * (t[s] - t[s - 1]);
+            }
+            y = integral.data();
+        }
+        evaluate(y, taps, fourTaps, numTargets, out.data(), level);
+        for (size_t k = 0; k < numTargets; ++k) {
+            if (result.flags[k] != resampleOk) {
+                out[k] = std::numeric_limits<double>::quiet_NaN();
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<double> uniformTimes(double start, double end, double interval) {
+    if (!(interval > 0.0)) {
+        throw std::invalid_argument("Interval must be positive.");
+    }
+    std::vector<double> times;
+    if (end >= start) {
+        // Multiplicação em vez de soma acumulada: sem deriva por arredondamento
+        size_t count = static_cast<size_t>(std::floor((end - start) / interval * (1.0 + 1e-12))) + 1;
+        times.reserve(count);
+        for (size_t k = 0; k < count; ++k) {
+            times.push_back(start + k * interval);
+        }
+    }
+    return times;
+}
@@ -0,0 +1,106 @@
+#ifndef IMU_RESAMPLE_HPP
+#define IMU_RESAMPLE_HPP
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "imuData.hpp"
+#include "imuRawData.hpp"
+#include "gnssData.hpp"
+#include "llaFromEcefSimd.hpp"
+
+/**
+ * @brief How the IMU channels are evaluated at a target time.
+ */
+enum class ResampleMode {
+    Linear, ///< Straight line between the samples around the target
+    Cubic, ///< Cubic Hermite through the samples around the target, with Catmull-Rom slopes
+    IntegrateAndDump ///< Mean of the signal since the previous target (each sample held over the interval it ends)
+};
+
+/**
+ * @brief Why a target has no resampled value (the values are NaN there).
+ */
+enum ResampleFlag : uint8_t {
+    resampleOk = 0, ///< Valid value
+    resampleOutside = 1, ///< The target (or its window) is not covered by the IMU data
+    resampleGap = 2 ///< The target (or its window) falls in a gap of the IMU data
+};
+
+/**
+ * @brief Options of the IMU resampler.
+ */
+struct ResampleOptions {
+    ResampleMode mode = ResampleMode::Linear; ///< Interpolation mode
+    std::vector<ImuChannel> channels = {ImuChannel::AccX, ImuChannel::AccY, ImuChannel::AccZ,
+                                        ImuChannel::Gx,   ImuChannel::Gy,   ImuChannel::Gz}; ///< Channels to resample
+    double maxGap = 0.0; ///< Longer intervals between IMU samples are gaps (s; 0 = 1.1 median intervals, as getLogStream counts them)
+    double timeOffset = 0.0; ///< Added to the targets to put them on the IMU clock (s), as GnssInsOptions::timeOffset
+    SimdLevel level = detectSimdLevel(); ///< Instruction set of the interpolation kernel
+};
+
+/**
+ * @brief IMU channels resampled at target times.
+ */
+struct ResampledImu {
+    ImuData data; ///< timeStamp holds the targets as given; only the selected channels are filled
+    std::vector<uint8_t> flags; ///< ResampleFlag of each target
+    size_t numFlagged = 0; ///< Targets without a value
+};
+
+/**
+ * @brief Resamples IMU channels at increasing target times.
+ *
+ * The samples around every target are found by one merge walk over both time
+ * lines, which turns each target into a few sample indices and weights shared
+ * by all channels: two for the linear mode, four for the cubic mode (whose
+ * slopes fall back to the secant next to a gap or the ends of the data) and,
+ * for integrate-and-dump, two at each end of the window on the running integral
+ * of the channel, so a window costs the same whatever its length. The channels
+ * are then evaluated with SIMD (gathering the samples by index); the SSE2 and
+ * AVX2 paths perform the same operations as the scalar one and give identical
+ * results.
+ *
+ * A target is flagged instead of interpolated when the interval between the
+ * samples around it (for integrate-and-dump, any interval overlapping its
+ * window) is longer than maxGap, or when it lies outside the data. The window
+ * of the first target has no start, so integrate-and-dump always flags it.
+ *
+ * @param imuData The IMU data, with increasing timestamps.
+ * @param targets The target times, increasing.
+ * @param numTargets The number of targets.
+ * @param options The resampling options.
+ * @return ResampledImu The values and flags of the targets.
+ * @throws std::invalid_argument If the timestamps or the targets are not increasing.
+ */
+ResampledImu resampleImu(const ImuData& imuData, const double* targets, size_t numTargets,
+                         const ResampleOptions& options = ResampleOptions());
+
+/**
+ * @brief Resamples IMU channels at increasing target times.
+ *
+ * @see resampleImu
+ */
+inline ResampledImu resampleImu(const ImuData& imuData, const std::vector<double>& targets,
+                                const ResampleOptions& options = ResampleOptions()) {
+    return resampleImu(imuData, targets.data(), targets.size(), options);
+}
+
+/**
+ * @brief Resamples IMU channels at the GNSS epochs (gnssData.time + options.timeOffset on the IMU clock).
+ *
+ * @see resampleImu
+ */
+inline ResampledImu resampleImu(const ImuData& imuData, const GnssData& gnssData,
+                                const ResampleOptions& options = ResampleOptions()) {
+    return resampleImu(imuData, gnssData.time.data(), gnssData.time.size(), options);
+}
+
+/**
+ * @brief Makes a uniform grid of times start, start + interval, ... up to end (inclusive).
+ *
+ * @throws std::invalid_argument If interval is not positive.
+ */
+std::vector<double> uniformTimes(double start, double end, double interval);
+
+#endif // IMU_RESAMPLE_HPP
@@ -0,0 +1,28 @@
+// Kernel de resampleImu. Este arquivo é incluído uma vez para cada conjunto de
+// instruções em imuResample.cpp, dentro de um namespace que define Ops (tipo
+// vetorial V, largura, operações elementares e leitura por índices).
+
+using V = Ops::V;
+
+// Mesmas operações, na mesma ordem, que scalarTaps
+inline void tapKernel(const double* y, const Taps& taps, bool fourTaps, size_t numTargets, double* out) {
+    const size_t width = Ops::width;
+    const size_t* a = taps.a.data();
+    const size_t* b = taps.b.data();
+    size_t k = 0;
+    if (fourTaps) {
+        for (; k + width <= numTargets; k += width) {
+            V sumA = Ops::add(Ops::mul(Ops::load(taps.wa0.data() + k), Ops::gather(y, a + k)),
+                              Ops::mul(Ops::load(taps.wa1.data() + k), Ops::gather(y + 1, a + k)));
+            V sumB = Ops::add(Ops::mul(Ops::load(taps.wb0.data() + k), Ops::gather(y, b + k)),
+                              Ops::mul(Ops::load(taps.wb1.data() + k), Ops::gather(y + 1, b + k)));
+            Ops::store(out + k, Ops::add(sumA, sumB));
+        }
+    } else {
+        for (; k + width <= numTargets; k += width) {
+            Ops::store(out + k, Ops::add(Ops::mul(Ops::load(taps.wa0.data() + k), Ops::gather(y, a + k)),
+                                         Ops::mul(Ops::load(taps.wa1.data() + k), Ops::gather(y + 1, a + k))));
+        }
+    }
+    scalarTaps(y, taps, fourTaps, k, numTargets, out);
+}
@@ -0,0 +1,79 @@
+#include "imuStream.hpp"
+
+ImuStreamReader::ImuStreamReader(const std::string &fileName, int imuModel, size_t batchSize)
+    : fileName_(fileName), batchSize_(std::max<size_t>(batchSize, 1)) {
+    file_.open(fileName, std::ios::binary | std::ios::ate);
+    if (!file_) {
+        throw std::runtime_error("Error opening file: " + fileName);
+    }
+    std::streamoff size = file_.tellg();
+    if (size % static_cast<std::streamoff>(sizeof(ImuRecord)) != 0) {
+        throw std::runtime_error("Truncated IMU record at the end of " + fileName + ": " +
+                                 std::to_string(size % sizeof(ImuRecord)) + " trailing bytes");
+    }
+    totalRecords_ = static_cast<size_t>(size) / sizeof(ImuRecord);
+
+    // Detectar o modelo a partir das primeiras amostras
+    ImuRecord prefix[10];
+    size_t numPrefix = std::min<size_t>(totalRecords_, 10);
+    file_.seekg(0, std::ios::beg);
+    if (!file_.read(reinterpret_cast<char *>(prefix), numPrefix * sizeof(ImuRecord))) {
+        throw std::runtime_error("Error reading file: " + fileName);
+    }
+    imuModel_ = detectImuModel(prefix, numPrefix, imuModel);
+    imuScaleFactors(imuModel_, anglfak_, accelfak_);
+
+    buffer_.resize(std::min(batchSize_, totalRecords_));
+    reset();
+}
+
+size_t ImuStreamReader::batchSizeForMemory(size_t maxBytes) {
+    return std::max<size_t>(maxBytes / bytesPerSample, 1);
+}
+
+void ImuStreamReader::reset() {
+    file_.clear();
+    file_.seekg(0, std::ios::beg);
+    recordsRead_ = 0;
+    hasLast_ = false;
+    stats_ = ImuStats();
+    stats_.imuModel = imuModel_;
+}
+
+bool ImuStreamReader::next(ImuData &batch) {
+    for (std::vector<double> *column : {&batch.timeStamp, &batch.accx, &batch.accy, &batch.accz,
+                                        &batch.gx, &batch.gy, &batch.gz}) {
+        column->clear();
+        column->reserve(batchSize_);
+    }
+
+    // Um lote só de duplicatas fica vazio, então continua lendo
+    while (batch.timeStamp.empty() && recordsRead_ < totalRecords_) {
+        size_t n = std::min(batchSize_, totalRecords_ - recordsRead_);
+        if (!file_.read(reinterpret_cast<char *>(buffer_.data()), n * sizeof(ImuRecord))) {
+            throw std::runtime_error("Error reading file: " + fileName_);
+        }
+        recordsRead_ += n;
+
+        for (size_t i = 0; i < n; ++i) {
+            const ImuRecord &r = buffer_[i];
+            double t = imuRecordTime(r);
+            if (hasLast_ && t == lastTimeStamp_) {
+                continue;
+            }
+            hasLast_ = true;
+            lastTimeStamp_ = t;
+
+            batch.timeStamp.push_back(t);
+            batch.gx.push_back(static_cast<double>(r.gx) * anglfak_);
+            batch.gy.push_back(static_cast<double>(r.gy) * anglfak_);
+            batch.gz.push_back(static_cast<double>(r.gz) * anglfak_);
+            batch.accx.push_back(static_cast<double>(r.accx) * accelfak_);
+            batch.accy.push_back(static_cast<double>(r.accy) * accelfak_);
+            batch.accz.push_back(static_cast<double>(r.accz) * accelfak_);
+        }
+    }
+
+    stats_.add(batch, 0, batch.timeStamp.size());
+    return !batch.timeStamp.empty();
+}
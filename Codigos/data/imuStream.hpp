@@ -0,0 +1,80 @@
+#ifndef IMU_STREAM_HPP
+#define IMU_STREAM_HPP
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdint>
+#include "imuData.hpp"
+#include "logStats.hpp"
+
+/**
+ * @brief Reads an IMU binary log in fixed-size batches.
+ *
+ * Only one batch of raw records and one batch of decoded samples are kept in
+ * memory. The IMU model is detected from the first samples of the file and
+ * duplicate timestamps are removed across batch boundaries, so concatenating
+ * all batches gives the same samples as loadImuData.
+ */
+class ImuStreamReader {
+public:
+    /// Memory used per sample in a batch (raw record plus decoded columns)
+    static constexpr size_t bytesPerSample = sizeof(ImuRecord) + 7 * sizeof(double);
+
+    /**
+     * @brief Opens an IMU binary log for streaming.
+     *
+     * @param fileName The name of the file to read.
+     * @param imuModel The IMU model to use. If 0, the model is detected from the first samples.
+     * @param batchSize The maximum number of samples returned by each call to next().
+     * @throws std::runtime_error If the file cannot be read, ends with a truncated record
+     *         or the IMU data is not valid.
+     */
+    ImuStreamReader(const std::string &fileName, int imuModel = 0, size_t batchSize = 65536);
+
+    /**
+     * @brief Gets the largest batch size that fits in a memory budget.
+     *
+     * @param maxBytes The memory budget in bytes.
+     * @return size_t The batch size (at least 1).
+     */
+    static size_t batchSizeForMemory(size_t maxBytes);
+
+    /**
+     * @brief Reads the next batch of samples.
+     *
+     * The columns of batch are overwritten and keep their capacity between calls.
+     *
+     * @param batch The IMU data to fill.
+     * @return bool False if there are no more samples.
+     * @throws std::runtime_error If there is an error reading the file.
+     */
+    bool next(ImuData &batch);
+
+    /**
+     * @brief Rewinds the reader to the first sample.
+     */
+    void reset();
+
+    int imuModel() const { return imuModel_; } ///< Detected or given IMU model
+    size_t batchSize() const { return batchSize_; } ///< Maximum samples per batch
+    size_t totalRecords() const { return totalRecords_; } ///< Number of records in the file
+    size_t recordsRead() const { return recordsRead_; } ///< Number of records consumed so far
+    const ImuStats& stats() const { return stats_; } ///< Statistics of the samples returned so far
+
+private:
+    std::string fileName_;
+    std::ifstream file_;
+    std::vector<ImuRecord> buffer_;
+    size_t batchSize_;
+    size_t totalRecords_ = 0;
+    size_t recordsRead_ = 0;
+    int imuModel_ = 0;
+    double anglfak_ = 0.0;
+    double accelfak_ = 0.0;
+    bool hasLast_ = false;
+    double lastTimeStamp_ = 0.0;
+    ImuStats stats_;
+};
+
+#endif // IMU_STREAM_HPP
@@ -0,0 +1,198 @@
+#include "llaFromEcefSimd.hpp"
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define LLA_SIMD_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#ifdef LLA_SIMD_X86
+
+namespace {
+
+namespace sse2 {
+
+struct Ops {
+    using V = __m128d;
+    static constexpr size_t width = 2;
+
+    static V set1(double a) { return _mm_set1_pd(a); }
+    static V load(const double* p) { return _mm_loadu_pd(p); }
+    static void store(double* p, V a) { _mm_storeu_pd(p, a); }
+    static V add(V a, V b) { return _mm_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm_div_pd(a, b); }
+    static V sqrt(V a) { return _mm_sqrt_pd(a); }
+    static V min(V a, V b) { return _mm_min_pd(a, b); }
+    static V max(V a, V b) { return _mm_max_pd(a, b); }
+    static V cmplt(V a, V b) { return _mm_cmplt_pd(a, b); }
+    static V cmpgt(V a, V b) { return _mm_cmpgt_pd(a, b); }
+    static V cmpeq(V a, V b) { return _mm_cmpeq_pd(a, b); }
+    static bool any(V mask) { return _mm_movemask_pd(mask) != 0; }
+    // Seleciona a onde mask é verdadeira e b nas demais posições
+    static V select(V mask, V a, V b) { return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b)); }
+    static V abs(V a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+    static V copysign(V mag, V sign) {
+        V signMask = _mm_set1_pd(-0.0);
+        return _mm_or_pd(_mm_andnot_pd(signMask, mag), _mm_and_pd(signMask, sign));
+    }
+    // Arredonda para o inteiro mais próximo (|a| < 2^51)
+    static V round(V a) {
+        V magic = _mm_set1_pd(6755399441055744.0);
+        return _mm_sub_pd(_mm_add_pd(a, magic), magic);
+    }
+    // Decompõe a > 0 em mant * 2^E, com mant em [1, 2)
+    static V exponent(V a, V& mant) {
+        __m128i bits = _mm_castpd_si128(a);
+        __m128i biased = _mm_srli_epi64(bits, 52);
+        V e = _mm_sub_pd(_mm_castsi128_pd(_mm_or_si128(biased, _mm_set1_epi64x(0x4330000000000000LL))),
+                         _mm_set1_pd(4503599627370496.0 + 1023.0));
+        mant = _mm_castsi128_pd(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi64x(0x000FFFFFFFFFFFFFLL)),
+                                             _mm_set1_epi64x(0x3FF0000000000000LL)));
+        return e;
+    }
+    // 2^q para q inteiro em [-1022, 1023]
+    static V pow2(V q) {
+        __m128i biased = _mm_castpd_si128(_mm_add_pd(q, _mm_set1_pd(4503599627370496.0 + 1023.0)));
+        return _mm_castsi128_pd(_mm_slli_epi64(biased, 52));
+    }
+};
+
+#include "llaFromEcefSimd.inl"
+
+} // namespace sse2
+
+} // namespace
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace {
+
+namespace avx2 {
+
+struct Ops {
+    using V = __m256d;
+    static constexpr size_t width = 4;
+
+    static V set1(double a) { return _mm256_set1_pd(a); }
+    static V load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, V a) { _mm256_storeu_pd(p, a); }
+    static V add(V a, V b) { return _mm256_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm256_div_pd(a, b); }
+    static V sqrt(V a) { return _mm256_sqrt_pd(a); }
+    static V min(V a, V b) { return _mm256_min_pd(a, b); }
+    static V max(V a, V b) { return _mm256_max_pd(a, b); }
+    static V cmplt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static V cmpgt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    static V cmpeq(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+    static bool any(V mask) { return _mm256_movemask_pd(mask) != 0; }
+    // Seleciona a onde mask é verdadeira e b nas demais posições
+    static V select(V mask, V a, V b) { return _mm256_blendv_pd(b, a, mask); }
+    static V abs(V a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+    static V copysign(V mag, V sign) {
+        V signMask = _mm256_set1_pd(-0.0);
+        return _mm256_or_pd(_mm256_andnot_pd(signMask, mag), _mm256_and_pd(signMask, sign));
+    }
+    // Arredonda para o inteiro mais próximo (|a| < 2^51)
+    static V round(V a) {
+        V magic = _mm256_set1_pd(6755399441055744.0);
+        return _mm256_sub_pd(_mm256_add_pd(a, magic), magic);
+    }
+    // Decompõe a > 0 em mant * 2^E, com mant em [1, 2)
+    static V exponent(V a, V& mant) {
+        __m256i bits = _mm256_castpd_si256(a);
+        __m256i biased = _mm256_srli_epi64(bits, 52);
+        V e = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(biased, _mm256_set1_epi64x(0x4330000000000000LL))),
+                            _mm256_set1_pd(4503599627370496.0 + 1023.0));
+        mant = _mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL)),
+                                                   _mm256_set1_epi64x(0x3FF0000000000000LL)));
+        return e;
+    }
+    // 2^q para q inteiro em [-1022, 1023]
+    static V pow2(V q) {
+        __m256i biased = _mm256_castpd_si256(_mm256_add_pd(q, _mm256_set1_pd(4503599627370496.0 + 1023.0)));
+        return _mm256_castsi256_pd(_mm256_slli_epi64(biased, 52));
+    }
+};
+
+#include "llaFromEcefSimd.inl"
+
+} // namespace avx2
+
+} // namespace
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // LLA_SIMD_X86
+
+SimdLevel detectSimdLevel() {
+#ifdef LLA_SIMD_X86
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] >= 7) {
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        // O sistema operacional precisa salvar os registradores YMM
+        if (osxsave && avx && (_xgetbv(0) & 6) == 6) {
+            __cpuidex(info, 7, 0);
+            if (info[1] & (1 << 5)) {
+                return SimdLevel::Avx2;
+            }
+        }
+    }
+    return SimdLevel::Sse2;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? SimdLevel::Avx2 : SimdLevel::Sse2;
+#endif
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+void llaFromEcefBatch(const double* x, const double* y, const double* z,
+                      double* lat, double* lon, double* alt, size_t nPoints, SimdLevel level) {
+    if (nPoints == 0) {
+        return;
+    }
+
+    // Não usar um conjunto de instruções que a CPU não tem
+    static const SimdLevel supported = detectSimdLevel();
+    if (static_cast<int>(level) > static_cast<int>(supported)) {
+        level = supported;
+    }
+
+    switch (level) {
+#ifdef LLA_SIMD_X86
+    case SimdLevel::Avx2:
+        avx2::llaKernel(x, y, z, lat, lon, alt, nPoints);
+        break;
+    case SimdLevel::Sse2:
+        sse2::llaKernel(x, y, z, lat, lon, alt, nPoints);
+        break;
+#endif
+    default:
+        for (size_t j = 0; j < nPoints; ++j) {
+            llaFromEcefPoint(x[j], y[j], z[j], lat[j], lon[j], alt[j]);
+        }
+        break;
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef LLA_FROM_ECEF_SIMD_HPP
+#define LLA_FROM_ECEF_SIMD_HPP
+
+#include <vector>
+#include <cstddef>
+#include <stdexcept>
+#include "llaFromEcef.hpp"
+
+/**
+ * @brief Instruction sets available for the batch ECEF to geodetic conversion.
+ */
+enum class SimdLevel {
+    Scalar, ///< Reference implementation (llaFromEcefPoint)
+    Sse2, ///< 2 points per instruction
+    Avx2 ///< 4 points per instruction
+};
+
+/**
+ * @brief Gets the best instruction set supported by the running CPU.
+ */
+SimdLevel detectSimdLevel();
+
+/**
+ * @brief Converts ECEF coordinates to geodetic coordinates using SIMD.
+ *
+ * Same algorithm as llaFromEcef, with vectorized cbrt and atan2 approximations
+ * (errors below 1e-6 m in altitude and 1e-11 degrees in latitude/longitude).
+ * The SSE2 and AVX2 paths execute the same operations and give identical results.
+ *
+ * @param x The X coordinates in meters (ECEF).
+ * @param y The Y coordinates in meters (ECEF).
+ * @param z The Z coordinates in meters (ECEF).
+ * @param lat Output latitudes in degrees.
+ * @param lon Output longitudes in degrees.
+ * @param alt Output altitudes in meters.
+ * @param nPoints The number of points.
+ * @param level The instruction set to use. Levels the CPU does not support fall back to the best supported one.
+ * @throws std::runtime_error If a point is too close to the center of the Earth.
+ */
+void llaFromEcefBatch(const double* x, const double* y, const double* z,
+                      double* lat, double* lon, double* alt, size_t nPoints,
+                      SimdLevel level = detectSimdLevel());
+
+/**
+ * @brief Converts ECEF coordinates to geodetic coordinates using SIMD.
+ *
+ * @see llaFromEcefBatch
+ */
+inline void llaFromEcefFast(const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& z,
+                            std::vector<double>& lat, std::vector<double>& lon, std::vector<double>& alt) {
+    size_t nPoints = x.size();
+    lat.resize(nPoints);
+    lon.resize(nPoints);
+    alt.resize(nPoints);
+    llaFromEcefBatch(x.data(), y.data(), z.data(), lat.data(), lon.data(), alt.data(), nPoints);
+}
+
+#endif // LLA_FROM_ECEF_SIMD_HPP
@@ -0,0 +1,151 @@
+// Kernel SIMD de llaFromEcef. Este arquivo é incluído uma vez para cada
+// conjunto de instruções em llaFromEcefSimd.cpp, dentro de um namespace que
+// define Ops (tipo vetorial V, largura e operações elementares).
+
+using V = Ops::V;
+
+// Raiz cúbica para x > 0: estimativa polinomial da mantissa seguida de duas
+// iterações de Halley
+inline V vcbrt(V x) {
+    V mant;
+    V E = Ops::exponent(x, mant);
+    // q = floor(E / 3), r = E - 3q
+    V q = Ops::round(Ops::div(Ops::sub(E, Ops::set1(1.0)), Ops::set1(3.0)));
+    V r = Ops::sub(E, Ops::mul(Ops::set1(3.0), q));
+
+    V y = Ops::add(Ops::set1(0.6263522077800208),
+                   Ops::mul(mant, Ops::add(Ops::set1(0.4335672380064994),
+                                           Ops::mul(mant, Ops::set1(-0.05863781317602286)))));
+    V scale = Ops::select(Ops::cmpeq(r, Ops::set1(1.0)), Ops::set1(1.2599210498948732),
+                          Ops::select(Ops::cmpeq(r, Ops::set1(2.0)), Ops::set1(1.5874010519681994),
+                                      Ops::set1(1.0)));
+    y = Ops::mul(Ops::mul(y, scale), Ops::pow2(q));
+
+    for (int iter = 0; iter < 2; ++iter) {
+        V y3 = Ops::mul(Ops::mul(y, y), y);
+        V num = Ops::add(y3, Ops::add(x, x));
+        V den = Ops::add(Ops::add(y3, y3), x);
+        y = Ops::div(Ops::mul(y, num), den);
+    }
+    return y;
+}
+
+// Arco tangente para 0 <= t <= 1 (aproximação racional do Cephes)
+inline V vatan01(V t) {
+    const double MOREBITS = 6.123233995736765886130E-17;
+    V big = Ops::cmpgt(t, Ops::set1(0.66));
+    V one = Ops::set1(1.0);
+    V x = Ops::select(big, Ops::div(Ops::sub(t, one), Ops::add(t, one)), t);
+    V base = Ops::select(big, Ops::set1(M_PI / 4), Ops::set1(0.0));
+    V extra = Ops::select(big, Ops::set1(0.5 * MOREBITS), Ops::set1(0.0));
+
+    V z = Ops::mul(x, x);
+    V num = Ops::set1(-8.750608600031904122785E-1);
+    num = Ops::add(Ops::mul(num, z), Ops::set1(-1.615753718733365076637E1));
+    num = Ops::add(Ops::mul(num, z), Ops::set1(-7.500855792314704667340E1));
+    num = Ops::add(Ops::mul(num, z), Ops::set1(-1.228866684490136173410E2));
+    num = Ops::add(Ops::mul(num, z), Ops::set1(-6.485021904942025371773E1));
+    V den = Ops::add(z, Ops::set1(2.485846490142306297962E1));
+    den = Ops::add(Ops::mul(den, z), Ops::set1(1.650270098316988542046E2));
+    den = Ops::add(Ops::mul(den, z), Ops::set1(4.328810604912902668951E2));
+    den = Ops::add(Ops::mul(den, z), Ops::set1(4.853903996359136964868E2));
+    den = Ops::add(Ops::mul(den, z), Ops::set1(1.945506571482613964425E2));
+
+    V r = Ops::div(Ops::mul(z, num), den);
+    r = Ops::add(Ops::mul(x, r), x);
+    return Ops::add(base, Ops::add(r, extra));
+}
+
+inline V vatan2(V y, V x) {
+    V ax = Ops::abs(x);
+    V ay = Ops::abs(y);
+    V mx = Ops::max(ax, ay);
+    V mn = Ops::min(ax, ay);
+    V zero = Ops::set1(0.0);
+    V t = Ops::select(Ops::cmpeq(mx, zero), zero, Ops::div(mn, mx));
+    V a = vatan01(t);
+    a = Ops::select(Ops::cmpgt(ay, ax), Ops::sub(Ops::set1(M_PI / 2), a), a);
+    a = Ops::select(Ops::cmplt(x, zero), Ops::sub(Ops::set1(M_PI), a), a);
+    return Ops::copysign(a, y);
+}
+
+// Converte Ops::width pontos
+inline void llaGroup(const double* xp, const double* yp, const double* zp, double* latp, double* lonp, double* altp) {
+    const double a = 6.378137e6; // Semi-major axis
+    const double e = 0.0818191908425; // Eccentricity
+    const double l = e * e / 2;
+    const double Hmin = std::pow(e, 12) / 4;
+
+    V x = Ops::load(xp);
+    V y = Ops::load(yp);
+    V z = Ops::load(zp);
+
+    V w2 = Ops::add(Ops::mul(x, x), Ops::mul(y, y));
+    V m = Ops::div(w2, Ops::set1(a * a));
+    V n = Ops::div(Ops::mul(Ops::mul(z, z), Ops::set1(1 - e * e)), Ops::set1(a * a));
+    V p = Ops::div(Ops::sub(Ops::add(m, n), Ops::set1(4 * l * l)), Ops::set1(6.0));
+    V G = Ops::mul(Ops::mul(m, n), Ops::set1(l * l));
+    V H = Ops::add(Ops::mul(Ops::mul(Ops::mul(Ops::set1(2.0), p), p), p), G);
+
+    if (Ops::any(Ops::cmplt(H, Ops::set1(Hmin)))) {
+        throw std::runtime_error("H < Hmin.. not feasible");
+    }
+
+    V C = Ops::div(vcbrt(Ops::add(Ops::add(H, G), Ops::mul(Ops::set1(2.0), Ops::sqrt(Ops::mul(H, G))))),
+                   Ops::set1(1.2599210498948732));
+    V mn = Ops::add(m, n);
+    V i = Ops::div(Ops::sub(Ops::set1(0.0), Ops::add(Ops::set1(2 * l * l), mn)), Ops::set1(2.0));
+    V P = Ops::mul(p, p);
+    V beta = Ops::sub(Ops::sub(Ops::div(i, Ops::set1(3.0)), C), Ops::div(P, C));
+    V k = Ops::mul(Ops::set1(l * l), Ops::sub(Ops::set1(l * l), mn));
+    V mMinusN = Ops::sub(m, n);
+    V t = Ops::sub(Ops::sqrt(Ops::sub(Ops::sqrt(Ops::sub(Ops::mul(beta, beta), k)),
+                                      Ops::div(Ops::add(beta, i), Ops::set1(2.0)))),
+                   Ops::copysign(Ops::sqrt(Ops::abs(Ops::div(Ops::sub(beta, i), Ops::set1(2.0)))), mMinusN));
+    V t2 = Ops::mul(t, t);
+    V twoLmn = Ops::mul(Ops::set1(2 * l), mMinusN);
+    V F = Ops::add(Ops::add(Ops::add(Ops::mul(t2, t2), Ops::mul(Ops::mul(Ops::set1(2.0), i), t2)),
+                            Ops::mul(twoLmn, t)), k);
+    V dF = Ops::add(Ops::add(Ops::mul(Ops::set1(4.0), Ops::mul(t2, t)), Ops::mul(Ops::mul(Ops::set1(4.0), i), t)),
+                    twoLmn);
+    V dt = Ops::div(F, dF);
+    V u = Ops::add(Ops::sub(t, dt), Ops::set1(l));
+    V v = Ops::sub(Ops::sub(t, dt), Ops::set1(l));
+    V w = Ops::sqrt(w2);
+    V latRad = vatan2(Ops::mul(z, u), Ops::mul(w, v));
+
+    V dw = Ops::mul(w, Ops::sub(Ops::set1(1.0), Ops::div(Ops::set1(1.0), u)));
+    V dz = Ops::sub(z, Ops::mul(z, Ops::div(Ops::set1(1 - e * e), v)));
+    V alt = Ops::copysign(Ops::sqrt(Ops::add(Ops::mul(dw, dw), Ops::mul(dz, dz))), Ops::sub(u, Ops::set1(1.0)));
+    V lonRad = vatan2(y, x);
+
+    Ops::store(latp, Ops::div(Ops::mul(latRad, Ops::set1(180.0)), Ops::set1(M_PI)));
+    Ops::store(lonp, Ops::div(Ops::mul(lonRad, Ops::set1(180.0)), Ops::set1(M_PI)));
+    Ops::store(altp, alt);
+}
+
+inline void llaKernel(const double* x, const double* y, const double* z,
+                      double* lat, double* lon, double* alt, size_t nPoints) {
+    const size_t width = Ops::width;
+    size_t j = 0;
+    for (; j + width <= nPoints; j += width) {
+        llaGroup(x + j, y + j, z + j, lat + j, lon + j, alt + j);
+    }
+
+    // Os pontos restantes são completados com o último ponto válido
+    if (j < nPoints) {
+        double xs[width], ys[width], zs[width], lats[width], lons[width], alts[width];
+        for (size_t k = 0; k < width; ++k) {
+            size_t src = std::min(j + k, nPoints - 1);
+            xs[k] = x[src];
+            ys[k] = y[src];
+            zs[k] = z[src];
+        }
+        llaGroup(xs, ys, zs, lats, lons, alts);
+        for (size_t k = 0; j + k < nPoints; ++k) {
+            lat[j + k] = lats[k];
+            lon[j + k] = lons[k];
+            alt[j + k] = alts[k];
+        }
+    }
+}
@@ -0,0 +1,562 @@
+#include "logStats.hpp"
+#include "imuData.hpp"
+#include "gnssData.hpp"
+#include <cstring>
+#include <algorithm>
+#include <thread>
+
+void RunningStats::add(double value) {
+    ++count;
+    double delta = value - mean;
+    mean += delta / count;
+    m2 += delta * (value - mean);
+    min = std::min(min, value);
+    max = std::max(max, value);
+}
+
+void RunningStats::merge(const RunningStats& other) {
+    if (other.count == 0) {
+        return;
+    }
+    if (count == 0) {
+        *this = other;
+        return;
+    }
+    // Chan et al.: combina médias e somas de quadrados das duas partes
+    uint64_t n = count + other.count;
+    double delta = other.mean - mean;
+    mean += delta * other.count / n;
+    m2 += other.m2 + delta * delta * (static_cast<double>(count) * other.count / n);
+    count = n;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+}
+
+double RunningStats::rms() const {
+    if (count == 0) {
+        return 0.0;
+    }
+    // E[x^2] = var_pop + mean^2
+    return std::sqrt(m2 / count + mean * mean);
+}
+
+size_t LogHistogram::binIndex(double value) {
+    if (!(value >= std::ldexp(1.0, minOctave))) {
+        return 0;
+    }
+    if (value >= std::ldexp(1.0, maxOctave)) {
+        return numBins - 1;
+    }
+    // Expoente e os 7 bits mais altos da mantissa
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    int exponent = static_cast<int>((bits >> 52) & 0x7FF) - 1023;
+    size_t sub = static_cast<size_t>((bits >> (52 - 7)) & (binsPerOctave - 1));
+    return 1 + static_cast<size_t>(exponent - minOctave) * binsPerOctave + sub;
+}
+
+void LogHistogram::add(double value) {
+    size_t bin = binIndex(value);
+    ++counts_[bin];
+    sums_[bin] += value;
+    mins_[bin] = std::min(mins_[bin], value);
+    maxs_[bin] = std::max(maxs_[bin], value);
+    ++total_;
+}
+
+void LogHistogram::merge(const LogHistogram& other) {
+    for (size_t b = 0; b < numBins; ++b) {
+        counts_[b] += other.counts_[b];
+        sums_[b] += other.sums_[b];
+        mins_[b] = std::min(mins_[b], other.mins_[b]);
+        maxs_[b] = std::max(maxs_[b], other.maxs_[b]);
+    }
+    total_ += other.total_;
+}
+
+double LogHistogram::valueAtRank(uint64_t rank) const {
+    uint64_t seen = 0;
+    for (size_t b = 0; b < numBins; ++b) {
+        seen += counts_[b];
+        if (seen > rank) {
+            return sums_[b] / counts_[b];
+        }
+    }
+    return std::numeric_limits<double>::quiet_NaN();
+}
+
+size_t LogHistogram::binAtRank(uint64_t rank, uint64_t& below) const {
+    below = 0;
+    for (size_t b = 0; b < numBins; ++b) {
+        if (below + counts_[b] > rank) {
+            return b;
+        }
+        below += counts_[b];
+    }
+    return numBins;
+}
+
+uint64_t LogHistogram::countOutside(double lo, double hi) const {
+    uint64_t outside = 0;
+    for (size_t b = 0; b < numBins; ++b) {
+        if (counts_[b] > 0) {
+            double mean = sums_[b] / counts_[b];
+            if (mean < lo || mean > hi) {
+                outside += counts_[b];
+            }
+        }
+    }
+    return outside;
+}
+
+uint64_t LogHistogram::countBetween(double lo, double hi) const {
+    uint64_t between = 0;
+    for (size_t b = 0; b < numBins; ++b) {
+        if (counts_[b] > 0) {
+            double mean = sums_[b] / counts_[b];
+            if (mean >= lo && mean < hi) {
+                between += counts_[b];
+            }
+        }
+    }
+    return between;
+}
+
+void TimeSeriesStats::add(double time) {
+    exactMedian = std::numeric_limits<double>::quiet_NaN();
+    if (samples == 0) {
+        firstTime = time;
+    } else {
+        intervals.add(time - lastTime);
+    }
+    lastTime = time;
+    ++samples;
+}
+
+void TimeSeriesStats::append(const TimeSeriesStats& next) {
+    if (next.samples == 0) {
+        return;
+    }
+    if (samples == 0) {
+        *this = next;
+        return;
+    }
+    exactMedian = std::numeric_limits<double>::quiet_NaN();
+    intervals.add(next.firstTime - lastTime);
+    intervals.merge(next.intervals);
+    samples += next.samples;
+    lastTime = next.lastTime;
+}
+
+namespace {
+
+// Classe de um intervalo no gapHistogram (-1 = não é gap), com o critério de 10% do cálculo direto
+int gapClass(double dt, double median) {
+    if (!(std::abs(dt - median) > median * 0.1)) {
+        return -1;
+    }
+    if (dt < median) {
+        return 0;
+    }
+    const std::vector<double>& edges = gapHistogramEdges();
+    int k = 1;
+    while (static_cast<size_t>(k) < edges.size() && dt >= edges[k] * median) {
+        ++k;
+    }
+    return k;
+}
+
+// Intervalo de posto rank (0 = o menor): o bin do histograma é estreitado com subdivisões lineares até guardar
+// poucos valores, que então são ordenados
+double exactIntervalAtRank(const ColumnSink& timeStamp, size_t count, const LogHistogram& intervals, uint64_t rank) {
+    const uint64_t maxKept = 1 << 16;
+    const size_t numSub = 1 << 12;
+    uint64_t below = 0;
+    size_t bin = intervals.binAtRank(rank, below);
+    double lo = intervals.binMin(bin), hi = intervals.binMax(bin);
+    uint64_t inRange = intervals.binCount(bin);
+    while (lo < hi) {
+        if (inRange <= maxKept) {
+            std::vector<double> kept;
+            kept.reserve(inRange);
+            for (size_t i = 1; i < count; ++i) {
+                double dt = timeStamp[i] - timeStamp[i - 1];
+                if (dt >= lo && dt <= hi) {
+                    kept.push_back(dt);
+                }
+            }
+            std::nth_element(kept.begin(), kept.begin() + (rank - below), kept.end());
+            return kept[rank - below];
+        }
+        // Metades para a largura não estourar nos bins extremos
+        std::vector<uint64_t> subCounts(numSub, 0);
+        std::vector<double> subMins(numSub, std::numeric_limits<double>::infinity());
+        std::vector<double> subMaxs(numSub, -std::numeric_limits<double>::infinity());
+        double scale = numSub / (0.5 * hi - 0.5 * lo);
+        for (size_t i = 1; i < count; ++i) {
+            double dt = timeStamp[i] - timeStamp[i - 1];
+            if (dt >= lo && dt <= hi) {
+                size_t s = std::min(numSub - 1, static_cast<size_t>((0.5 * dt - 0.5 * lo) * scale));
+                ++subCounts[s];
+                subMins[s] = std::min(subMins[s], dt);
+                subMaxs[s] = std::max(subMaxs[s], dt);
+            }
+        }
+        // O menor e o maior valor caem em subdivisões diferentes, então a faixa sempre diminui
+        size_t s = 0;
+        while (below + subCounts[s] <= rank) {
+            below += subCounts[s++];
+        }
+        lo = subMins[s];
+        hi = subMaxs[s];
+        inRange = subCounts[s];
+    }
+    return lo;
+}
+
+} // namespace
+
+void TimeSeriesStats::setExactIntervals(const ColumnSink& timeStamp, size_t count) {
+    exactMedian = std::numeric_limits<double>::quiet_NaN();
+    exactGapCounts.clear();
+    if (count < 2 || intervals.count() != count - 1) {
+        return;
+    }
+    // O mesmo elemento que nth_element em size / 2
+    double median = exactIntervalAtRank(timeStamp, count, intervals, intervals.count() / 2);
+
+    // Bins inteiros numa só classe (as classes crescem com o intervalo); os outros são vistos valor a valor
+    std::vector<uint64_t> counts(gapHistogramEdges().size() + 1, 0);
+    std::vector<char> straddles(LogHistogram::numBins, 0);
+    bool rescan = false;
+    for (size_t b = 0; b < LogHistogram::numBins; ++b) {
+        if (intervals.binCount(b) == 0) {
+            continue;
+        }
+        int first = gapClass(intervals.binMin(b), median), last = gapClass(intervals.binMax(b), median);
+        if (first != last) {
+            straddles[b] = 1;
+            rescan = true;
+        } else if (first >= 0) {
+            counts[first] += intervals.binCount(b);
+        }
+    }
+    if (rescan) {
+        for (size_t i = 1; i < count; ++i) {
+            double dt = timeStamp[i] - timeStamp[i - 1];
+            if (straddles[LogHistogram::binIndex(dt)]) {
+                int k = gapClass(dt, median);
+                if (k >= 0) {
+                    ++counts[k];
+                }
+            }
+        }
+    }
+    exactMedian = median;
+    exactGapCounts = counts;
+}
+
+void TimeSeriesStats::setExactIntervals(const std::vector<double>& timeStamp) {
+    setExactIntervals(ColumnSink{const_cast<double*>(timeStamp.data()), 1}, timeStamp.size());
+}
+
+double TimeSeriesStats::medianInterval() const {
+    if (!std::isnan(exactMedian)) {
+        return exactMedian;
+    }
+    // Mesmo elemento que nth_element em size / 2, a menos da largura do bin
+    return intervals.valueAtRank(intervals.count() / 2);
+}
+
+uint64_t TimeSeriesStats::gaps() const {
+    // Soma do gapHistogram, para que os dois nunca discordem
+    uint64_t total = 0;
+    for (uint64_t count : gapHistogram(*this)) {
+        total += count;
+    }
+    return total;
+}
+
+const std::vector<double>& gapHistogramEdges() {
+    static const std::vector<double> edges = {1.1, 2.0, 5.0, 10.0, 100.0};
+    return edges;
+}
+
+std::vector<uint64_t> gapHistogram(const TimeSeriesStats& time) {
+    const std::vector<double>& edges = gapHistogramEdges();
+    if (!std::isnan(time.exactMedian)) {
+        return time.exactGapCounts;
+    }
+    std::vector<uint64_t> counts(edges.size() + 1, 0);
+    if (time.intervals.count() == 0) {
+        return counts;
+    }
+    double median = time.medianInterval();
+    counts[0] = time.intervals.countBetween(-std::numeric_limits<double>::infinity(), 0.9 * median);
+    for (size_t k = 1; k < edges.size(); ++k) {
+        counts[k] = time.intervals.countBetween(edges[k - 1] * median, edges[k] * median);
+    }
+    counts.back() = time.intervals.countBetween(edges.back() * median, std::numeric_limits<double>::infinity());
+    return counts;
+}
+
+double medianSampleInterval(const std::vector<double>& timeStamp) {
+    if (timeStamp.size() < 2) {
+        return 0.0;
+    }
+    // Uma amostra dos intervalos basta para a mediana
+    const size_t maxIntervals = 1 << 16;
+    size_t numIntervals = timeStamp.size() - 1;
+    size_t step = std::max<size_t>(1, numIntervals / maxIntervals);
+    LogHistogram intervals;
+    for (size_t i = 0; i < numIntervals; i += step) {
+        intervals.add(timeStamp[i + 1] - timeStamp[i]);
+    }
+    return intervals.valueAtRank(intervals.count() / 2);
+}
+
+void ImuStats::add(const ImuData& imuData, size_t first, size_t last) {
+    for (size_t i = first; i < last; ++i) {
+        time.add(imuData.timeStamp[i]);
+        accx.add(imuData.accx[i]);
+        accy.add(imuData.accy[i]);
+        accz.add(imuData.accz[i]);
+        gx.add(imuData.gx[i]);
+        gy.add(imuData.gy[i]);
+        gz.add(imuData.gz[i]);
+    }
+}
+
+void ImuStats::add(const ImuColumns& columns, size_t first, size_t last) {
+    for (size_t i = first; i < last; ++i) {
+        time.add(columns.timeStamp[i]);
+        accx.add(columns.accx[i]);
+        accy.add(columns.accy[i]);
+        accz.add(columns.accz[i]);
+        gx.add(columns.gx[i]);
+        gy.add(columns.gy[i]);
+        gz.add(columns.gz[i]);
+    }
+}
+
+void ImuStats::append(const ImuStats& next) {
+    if (imuModel == 0) {
+        imuModel = next.imuModel;
+    }
+    time.append(next.time);
+    accx.merge(next.accx);
+    accy.merge(next.accy);
+    accz.merge(next.accz);
+    gx.merge(next.gx);
+    gy.merge(next.gy);
+    gz.merge(next.gz);
+}
+
+void GnssStats::add(const GnssData& gnssData, size_t first, size_t last) {
+    for (size_t i = first; i < last; ++i) {
+        time.add(gnssData.time[i]);
+        x.add(gnssData.x[i]);
+        y.add(gnssData.y[i]);
+        z.add(gnssData.z[i]);
+        if (i < gnssData.alt.size()) {
+            alt.add(gnssData.alt[i]);
+        }
+        if (gnssData.fix[i] == 1) {
+            ++fixCount;
+        } else if (gnssData.fix[i] == 2) {
+            ++floatCount;
+        }
+    }
+}
+
+void GnssStats::add(const GnssColumns& columns, size_t first, size_t last) {
+    for (size_t i = first; i < last; ++i) {
+        time.add(columns.time[i]);
+        x.add(columns.x[i]);
+        y.add(columns.y[i]);
+        z.add(columns.z[i]);
+        alt.add(columns.alt[i]);
+        if (columns.fix[i] == 1) {
+            ++fixCount;
+        } else if (columns.fix[i] == 2) {
+            ++floatCount;
+        }
+    }
+}
+
+void GnssStats::append(const GnssStats& next) {
+    time.append(next.time);
+    x.merge(next.x);
+    y.merge(next.y);
+    z.merge(next.z);
+    alt.merge(next.alt);
+    fixCount += next.fixCount;
+    floatCount += next.floatCount;
+}
+
+namespace {
+
+std::string jsonNumber(double value) {
+    if (!std::isfinite(value)) {
+        return "null";
+    }
+    std::ostringstream oss;
+    oss << std::setprecision(17) << value;
+    return oss.str();
+}
+
+void writeJson(std::ostringstream& oss, const char* name, const RunningStats& stats) {
+    oss << "\"" << name << "\":{\"count\":" << stats.count << ",\"min\":" << jsonNumber(stats.min)
+        << ",\"max\":" << jsonNumber(stats.max) << ",\"mean\":" << jsonNumber(stats.mean)
+        << ",\"rms\":" << jsonNumber(stats.rms()) << ",\"std\":" << jsonNumber(std::sqrt(stats.variance())) << "}";
+}
+
+void writeJson(std::ostringstream& oss, const TimeSeriesStats& time) {
+    double median = time.medianInterval();
+    oss << "\"samples\":" << time.samples << ",\"duration\":" << jsonNumber(time.lastTime - time.firstTime)
+        << ",\"medianInterval\":" << jsonNumber(median) << ",\"frequency\":" << jsonNumber(1.0 / median)
+        << ",\"gaps\":" << time.gaps() << ",\"gapHistogram\":{\"edges\":[";
+    const std::vector<double>& edges = gapHistogramEdges();
+    for (size_t k = 0; k < edges.size(); ++k) {
+        oss << (k ? "," : "") << jsonNumber(edges[k]);
+    }
+    oss << "],\"counts\":[";
+    std::vector<uint64_t> counts = gapHistogram(time);
+    for (size_t k = 0; k < counts.size(); ++k) {
+        oss << (k ? "," : "") << counts[k];
+    }
+    oss << "]}";
+}
+
+} // namespace
+
+std::string ImuStats::toJson() const {
+    std::ostringstream oss;
+    oss << "{\"imuModel\":" << imuModel << ",";
+    writeJson(oss, time);
+    oss << ",";
+    writeJson(oss, "accx", accx);
+    oss << ",";
+    writeJson(oss, "accy", accy);
+    oss << ",";
+    writeJson(oss, "accz", accz);
+    oss << ",";
+    writeJson(oss, "gx", gx);
+    oss << ",";
+    writeJson(oss, "gy", gy);
+    oss << ",";
+    writeJson(oss, "gz", gz);
+    oss << "}";
+    return oss.str();
+}
+
+std::string GnssStats::toJson() const {
+    std::ostringstream oss;
+    oss << "{";
+    writeJson(oss, time);
+    oss << ",\"fix\":" << fixCount << ",\"float\":" << floatCount << ",";
+    writeJson(oss, "x", x);
+    oss << ",";
+    writeJson(oss, "y", y);
+    oss << ",";
+    writeJson(oss, "z", z);
+    oss << ",";
+    writeJson(oss, "alt", alt);
+    oss << "}";
+    return oss.str();
+}
+
+ImuStats computeImuStats(const ImuData& imuData, int imuModel, unsigned numThreads) {
+    if (numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t numSamples = imuData.timeStamp.size();
+    size_t numParts = std::max<size_t>(1, std::min<size_t>(numThreads, numSamples / 65536));
+
+    // Cada thread resume um trecho contíguo; os trechos são unidos em ordem
+    std::vector<ImuStats> parts(numParts);
+    std::vector<std::thread> workers;
+    for (size_t p = 0; p < numParts; ++p) {
+        size_t first = numSamples * p / numParts;
+        size_t last = numSamples * (p + 1) / numParts;
+        if (numParts == 1) {
+            parts[p].add(imuData, first, last);
+        } else {
+            workers.emplace_back([&, p, first, last]() { parts[p].add(imuData, first, last); });
+        }
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    ImuStats stats;
+    stats.imuModel = imuModel;
+    for (const ImuStats& part : parts) {
+        stats.append(part);
+    }
+    stats.time.setExactIntervals(imuData.timeStamp);
+    return stats;
+}
+
+GnssStats computeGnssStats(const GnssData& gnssData) {
+    GnssStats stats;
+    stats.add(gnssData, 0, gnssData.time.size());
+    stats.time.setExactIntervals(gnssData.time);
+    return stats;
+}
+
+std::string getLogStream(const ImuStats& stats) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+
+    if (stats.time.samples > 0) {
+        uint64_t imuSamples = stats.time.samples;
+
+        // Verificar se há dados suficientes para calcular diferenças
+        if (imuSamples < 2) {
+            oss << "Not enough IMU data to calculate statistics.\n";
+            return oss.str();
+        }
+
+        double imuFreq = 1.0 / stats.time.medianInterval();
+        uint64_t imuGaps = stats.time.gaps();
+
+        // Gerar a string de log
+        oss << "IMU Model: " << stats.imuModel << "\n";
+        oss << "IMU Samples: " << imuSamples << " (" << (stats.time.lastTime - stats.time.firstTime) / 60.0 << " minutes)\n";
+        oss << "IMU Freq: " << imuFreq << " Hz\n";
+        oss << "IMU Gaps: " << imuGaps << " (" << (static_cast<double>(imuGaps) / imuSamples * 100.0) << "%)\n\n";
+    } else {
+        oss << "No IMU data available.\n";
+    }
+
+    return oss.str();
+}
+
+std::string getLogStream(const GnssStats& stats) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+
+    if (stats.time.samples > 0) {
+        uint64_t gnssSamples = stats.time.samples;
+
+        // Verificar se há dados suficientes para calcular diferenças
+        if (gnssSamples < 2) {
+            oss << "Not enough GNSS data to calculate statistics.\n";
+            return oss.str();
+        }
+
+        double gnssFreq = 1.0 / stats.time.medianInterval();
+        uint64_t gnssGaps = stats.time.gaps();
+
+        // Gerar a string de log
+        oss << "GNSS Samples: " << gnssSamples << " (" << (stats.time.lastTime - stats.time.firstTime) / 60.0 << " minutes)\n";
+        oss << "GNSS Freq: " << gnssFreq << " Hz\n";
+        oss << "GNSS Gaps: " << gnssGaps << " (" << (static_cast<double>(gnssGaps) / gnssSamples * 100.0) << "%)\n";
+        oss << "GNSS Quality: " << stats.fixCount / static_cast<double>(gnssSamples) * 100.0 << "%\n\n";
+    } else {
+        oss << "No GNSS data available.\n";
+    }
+
+    return oss.str();
+}
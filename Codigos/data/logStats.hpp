@@ -0,0 +1,237 @@
+#ifndef LOG_STATS_HPP
+#define LOG_STATS_HPP
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <limits>
+#include "columnSink.hpp"
+
+struct ImuData;
+struct GnssData;
+
+/**
+ * @brief Running count, min, max, mean and RMS of a channel (Welford).
+ */
+struct RunningStats {
+    uint64_t count = 0; ///< Number of values
+    double min = std::numeric_limits<double>::infinity(); ///< Smallest value
+    double max = -std::numeric_limits<double>::infinity(); ///< Largest value
+    double mean = 0.0; ///< Mean value
+    double m2 = 0.0; ///< Sum of squared deviations from the mean
+
+    void add(double value);
+    void merge(const RunningStats& other);
+    double variance() const { return count > 1 ? m2 / (count - 1) : 0.0; } ///< Sample variance
+    double rms() const; ///< Root mean square
+};
+
+/**
+ * @brief Histogram of positive values with log-spaced bins (128 per octave).
+ *
+ * Each bin keeps the count, sum, minimum and maximum of its values, so quantiles
+ * are the mean of the bin that holds them: exact when the bin holds a single
+ * distinct value (a constant sampling interval) and within 0.6% otherwise.
+ * Values below 2^-30 (including zero and negative values) and above 2^20 go
+ * to two extra bins. Memory is fixed and histograms can be merged.
+ */
+class LogHistogram {
+public:
+    static constexpr int binsPerOctave = 128;
+    static constexpr int minOctave = -30;
+    static constexpr int maxOctave = 20;
+    static constexpr size_t numBins = (maxOctave - minOctave) * binsPerOctave + 2;
+
+    LogHistogram()
+        : counts_(numBins, 0), sums_(numBins, 0.0), mins_(numBins, std::numeric_limits<double>::infinity()),
+          maxs_(numBins, -std::numeric_limits<double>::infinity()) {}
+
+    static size_t binIndex(double value); ///< Bin that holds a value
+
+    void add(double value);
+    void merge(const LogHistogram& other);
+    uint64_t count() const { return total_; } ///< Number of values
+
+    /**
+     * @brief Gets the value of a given rank (0-based, in increasing order).
+     */
+    double valueAtRank(uint64_t rank) const;
+
+    /**
+     * @brief Gets the bin that holds a given rank and the number of values in the bins before it.
+     */
+    size_t binAtRank(uint64_t rank, uint64_t& below) const;
+
+    uint64_t binCount(size_t bin) const { return counts_[bin]; } ///< Number of values in a bin
+    double binMin(size_t bin) const { return mins_[bin]; } ///< Smallest value in a bin
+    double binMax(size_t bin) const { return maxs_[bin]; } ///< Largest value in a bin
+
+    /**
+     * @brief Counts the values outside [lo, hi], judging each bin by its mean.
+     */
+    uint64_t countOutside(double lo, double hi) const;
+
+    /**
+     * @brief Counts the values in [lo, hi), judging each bin by its mean.
+     */
+    uint64_t countBetween(double lo, double hi) const;
+
+private:
+    std::vector<uint64_t> counts_;
+    std::vector<double> sums_;
+    std::vector<double> mins_;
+    std::vector<double> maxs_;
+    uint64_t total_ = 0;
+};
+
+/**
+ * @brief Statistics of a sequence of timestamps: span and sampling intervals.
+ *
+ * Filled batch by batch (add, append), the median interval and the gaps come
+ * from the histogram: exact for a constant sampling interval, but with jitter
+ * the median is a bin mean (within 0.6%) and intervals near the 10% threshold
+ * may be classified on the wrong side. When all the timestamps are in memory,
+ * setExactIntervals makes both exactly those of the nth_element median.
+ */
+struct TimeSeriesStats {
+    uint64_t samples = 0; ///< Number of timestamps
+    double firstTime = 0.0; ///< First timestamp
+    double lastTime = 0.0; ///< Last timestamp
+    LogHistogram intervals; ///< Differences between consecutive timestamps
+    double exactMedian = std::numeric_limits<double>::quiet_NaN(); ///< Exact median interval (NaN = not computed)
+    std::vector<uint64_t> exactGapCounts; ///< Exact gapHistogram counts, valid with exactMedian
+
+    void add(double time);
+
+    /**
+     * @brief Appends the statistics of the timestamps that follow these ones.
+     *
+     * The interval between the last timestamp of this part and the first of the next is included.
+     */
+    void append(const TimeSeriesStats& next);
+
+    /**
+     * @brief Computes the exact median interval and gaps from all the timestamps added.
+     *
+     * The histogram locates the median; the timestamps are then scanned again
+     * only to narrow down the values in its bin (keeping at most 65536 of
+     * them) and to classify the intervals of bins that straddle a gap
+     * threshold. Memory stays bounded. Adding or appending more timestamps
+     * afterwards falls back to the histogram.
+     */
+    void setExactIntervals(const ColumnSink& timeStamp, size_t count);
+    void setExactIntervals(const std::vector<double>& timeStamp);
+
+    double medianInterval() const; ///< Median sampling interval (upper median)
+    uint64_t gaps() const; ///< Intervals more than 10% away from the median
+};
+
+/**
+ * @brief Ratios interval / median used as the edges of the gap histogram.
+ */
+const std::vector<double>& gapHistogramEdges();
+
+/**
+ * @brief Counts the gaps of a time series by length.
+ *
+ * Element 0 counts intervals shorter than 0.9 medians (including repeated or
+ * decreasing timestamps); element k counts intervals between edges k-1 and k
+ * of gapHistogramEdges(), the last element the longer ones. Intervals are
+ * judged by the mean of their histogram bin, unless the exact intervals were
+ * computed; either way the counts add up to gaps().
+ */
+std::vector<uint64_t> gapHistogram(const TimeSeriesStats& time);
+
+/**
+ * @brief Estimates the median interval between consecutive timestamps.
+ *
+ * Uses at most about 65536 intervals spread over the data, so it is cheap even
+ * for day-long logs.
+ *
+ * @param timeStamp The timestamps.
+ * @return double The median interval (0 if there are fewer than 2 timestamps).
+ */
+double medianSampleInterval(const std::vector<double>& timeStamp);
+
+/**
+ * @brief Summary statistics of IMU data; can be updated in batches and merged.
+ */
+struct ImuStats {
+    int imuModel = 0; ///< IMU model
+    TimeSeriesStats time; ///< Timestamps
+    RunningStats accx, accy, accz; ///< Accelerometer channels
+    RunningStats gx, gy, gz; ///< Gyroscope channels
+
+    /**
+     * @brief Adds samples [first, last) of IMU data.
+     */
+    void add(const ImuData& imuData, size_t first, size_t last);
+
+    /**
+     * @brief Adds samples [first, last) of IMU data held in caller-provided columns.
+     */
+    void add(const ImuColumns& columns, size_t first, size_t last);
+
+    /**
+     * @brief Appends the statistics of the samples that follow these ones (see TimeSeriesStats::append).
+     */
+    void append(const ImuStats& next);
+
+    std::string toJson() const; ///< Machine-readable summary
+};
+
+/**
+ * @brief Summary statistics of GNSS data; can be updated in batches and merged.
+ */
+struct GnssStats {
+    TimeSeriesStats time; ///< Timestamps
+    RunningStats x, y, z; ///< ECEF coordinates
+    RunningStats alt; ///< Altitude
+    uint64_t fixCount = 0; ///< Samples with fix status 1 (fix)
+    uint64_t floatCount = 0; ///< Samples with fix status 2 (float)
+
+    /**
+     * @brief Adds samples [first, last) of GNSS data.
+     */
+    void add(const GnssData& gnssData, size_t first, size_t last);
+
+    /**
+     * @brief Adds samples [first, last) of GNSS data held in caller-provided columns.
+     */
+    void add(const GnssColumns& columns, size_t first, size_t last);
+
+    /**
+     * @brief Appends the statistics of the samples that follow these ones (see TimeSeriesStats::append).
+     */
+    void append(const GnssStats& next);
+
+    std::string toJson() const; ///< Machine-readable summary
+};
+
+/**
+ * @brief Computes the statistics of IMU data, splitting it across threads.
+ *
+ * The median interval and the gaps are exact (see TimeSeriesStats::setExactIntervals).
+ *
+ * @param imuData The IMU data.
+ * @param imuModel The IMU model.
+ * @param numThreads Number of threads. If 0, all hardware threads are used.
+ */
+ImuStats computeImuStats(const ImuData& imuData, int imuModel, unsigned numThreads = 1);
+
+/**
+ * @brief Computes the statistics of GNSS data, with the exact median interval and gaps.
+ */
+GnssStats computeGnssStats(const GnssData& gnssData);
+
+/**
+ * @brief Formats IMU statistics as the text of logImuData.
+ */
+std::string getLogStream(const ImuStats& stats);
+
+/**
+ * @brief Formats GNSS statistics as the text of logGnss.
+ */
+std::string getLogStream(const GnssStats& stats);
+
+#endif // LOG_STATS_HPP
@@ -1,15 +1,19 @@
 #include "mex.h"
 #include "gnssData.hpp"
+#include "logStats.hpp"
 #include <string>
 #include <stdexcept>
 
 // Declaração da função logGnssMex
-void logGnssMex(const GnssData &gnssData);
+void logGnssMex(const GnssColumns &columns, size_t numSamples);
 
 // Implementação da função logGnssMex
-void logGnssMex(const GnssData &gnssData) {
+void logGnssMex(const GnssColumns &columns, size_t numSamples) {
     // Obter a string de log
-    std::string logStr = getLogStream(gnssData);
+    GnssStats stats;
+    stats.add(columns, 0, numSamples);
+    stats.time.setExactIntervals(columns.time, numSamples);
+    std::string logStr = getLogStream(stats);
 
     // Exibir a string usando mexPrintf
     mexPrintf("%s", logStr.c_str());
@@ -40,45 +44,31 @@ void mexFunction(int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[]) {
     std::string filename(filename_c);
     mxFree(filename_c);
 
-    // Carregar os dados GNSS
-    GnssData gnssData;
+    // Carregar os dados GNSS direto na matriz de saída
+    // Colunas: time, x, y, z, lat, lon, alt, fix
+    size_t numSamples = 0;
+    GnssColumns columns;
     try {
-        gnssData = loadGnssData(filename, false);
-        logGnssMex(gnssData);
+        numSamples = loadGnssData(filename, [&](size_t n) {
+            mwSize dims[2] = { static_cast<mwSize>(n), 8 };
+            plhs[0] = mxCreateNumericArray(2, dims, mxDOUBLE_CLASS, mxREAL);
+            double* outData = mxGetPr(plhs[0]);
+            columns.time = matrixColumn(outData, n, 0);
+            columns.x = matrixColumn(outData, n, 1);
+            columns.y = matrixColumn(outData, n, 2);
+            columns.z = matrixColumn(outData, n, 3);
+            columns.lat = matrixColumn(outData, n, 4);
+            columns.lon = matrixColumn(outData, n, 5);
+            columns.alt = matrixColumn(outData, n, 6);
+            columns.fix = matrixColumn(outData, n, 7);
+            return columns;
+        });
+        logGnssMex(columns, numSamples);
     } catch (const std::exception& e) {
         mexErrMsgIdAndTxt("gnssData_mex:runtimeError", e.what());
     }
 
-    // Número de amostras
-    size_t numSamples = gnssData.time.size();
-
-    // Verificar se os vetores têm o mesmo tamanho
-    if (numSamples == 0 ||
-        numSamples != gnssData.x.size() ||
-        numSamples != gnssData.y.size() ||
-        numSamples != gnssData.z.size() ||
-        numSamples != gnssData.lat.size() ||
-        numSamples != gnssData.lon.size() ||
-        numSamples != gnssData.alt.size() ||
-        numSamples != gnssData.fix.size()) {
-        mexErrMsgIdAndTxt("gnssData_mex:sizeMismatch", "Tamanhos dos vetores não correspondem.");
+    if (numSamples == 0) {
+        mexErrMsgIdAndTxt("gnssData_mex:noData", "O arquivo não contém soluções GNSS.");
     }
-
-    // Criar a matriz de saída com 8 colunas
-    // Colunas: time, x, y, z, lat, lon, alt, fix
-    mwSize dims[2] = { static_cast<mwSize>(numSamples), 8 };
-    plhs[0] = mxCreateNumericArray(2, dims, mxDOUBLE_CLASS, mxREAL);
-    double* outData = mxGetPr(plhs[0]);
-
-    // Copiar dados para a matriz de saída
-    for (size_t i = 0; i < numSamples; ++i) {
-        outData[i] = gnssData.time[i];
-        outData[i + numSamples] = gnssData.x[i];
-        outData[i + 2 * numSamples] = gnssData.y[i];
-        outData[i + 3 * numSamples] = gnssData.z[i];
-        outData[i + 4 * numSamples] = gnssData.lat[i];
-        outData[i + 5 * numSamples] = gnssData.lon[i];
-        outData[i + 6 * numSamples] = gnssData.alt[i];
-        outData[i + 7 * numSamples] = static_cast<double>(gnssData.fix[i]);
-    }
-}
\ No newline at end of file
+}
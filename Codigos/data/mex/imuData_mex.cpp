@@ -1,15 +1,20 @@
 #include "mex.h"
 #include "imuData.hpp"
+#include "logStats.hpp"
 #include <string>
 #include <stdexcept>
 
 // Declaração da função logImuMex
-void logImuMex(const ImuData &imuData, int imuModel);
+void logImuMex(const ImuColumns &columns, size_t numSamples, int imuModel);
 
 // Implementação da função logImuMex
-void logImuMex(const ImuData &imuData, int imuModel) {
+void logImuMex(const ImuColumns &columns, size_t numSamples, int imuModel) {
     // Obter a string de log
-    std::string logStr = getLogStream(imuData, imuModel);
+    ImuStats stats;
+    stats.imuModel = imuModel;
+    stats.add(columns, 0, numSamples);
+    stats.time.setExactIntervals(columns.timeStamp, numSamples);
+    std::string logStr = getLogStream(stats);
 
     // Exibir a string usando mexPrintf
     mexPrintf("%s", logStr.c_str());
@@ -39,46 +44,28 @@ void mexFunction(int nlhs, mxArray* plhs[], int nrhs, const mxArray* prhs[]) {
     std::string filename(filename_c);
     mxFree(filename_c);
 
-    // Carregar os dados IMU
+    // Carregar os dados IMU direto na matriz de saída (colunas: tempo, acc, giro)
     int imuModel = 0;
-    ImuData imuData;
+    size_t numSamples = 0;
+    ImuColumns columns;
     try {
-        imuData = loadImuData(filename, imuModel, false);
-        logImuMex(imuData, imuModel);
+        numSamples = loadImuData(filename, imuModel, [&](size_t n) {
+            mwSize dims[2] = { static_cast<mwSize>(n), 7 };
+            plhs[0] = mxCreateNumericArray(2, dims, mxDOUBLE_CLASS, mxREAL);
+            double* outData = mxGetPr(plhs[0]);
+            columns.timeStamp = matrixColumn(outData, n, 0);
+            columns.accx = matrixColumn(outData, n, 1);
+            columns.accy = matrixColumn(outData, n, 2);
+            columns.accz = matrixColumn(outData, n, 3);
+            columns.gx = matrixColumn(outData, n, 4);
+            columns.gy = matrixColumn(outData, n, 5);
+            columns.gz = matrixColumn(outData, n, 6);
+            return columns;
+        });
+        logImuMex(columns, numSamples, imuModel);
     } catch (const std::exception& e) {
         mexErrMsgIdAndTxt("imuData_mex:runtimeError", e.what());
     }
 
-    // Número de amostras
-    size_t numSamples = imuData.timeStamp.size();
-
-    mexPrintf("Número de amostras: %d\n", numSamples);
-    mexPrintf("Sizes: %d %d %d %d %d %d\n", imuData.accx.size(), imuData.accy.size(), imuData.accz.size(), imuData.gx.size(), imuData.gy.size(), imuData.gz.size());
-
-    // Verificar se os vetores têm o mesmo tamanho
-    if (numSamples == 0 ||
-        numSamples != imuData.accx.size() ||
-        numSamples != imuData.accy.size() ||
-        numSamples != imuData.accz.size() ||
-        numSamples != imuData.gx.size() ||
-        numSamples != imuData.gy.size() ||
-        numSamples != imuData.gz.size()) {
-        mexErrMsgIdAndTxt("imuData_mex:sizeMismatch", "Tamanhos dos vetores não correspondem.");
-    }
-
-    // Criar a matriz de saída com 7 colunas
-    mwSize dims[2] = { static_cast<mwSize>(numSamples), 7 };
-    plhs[0] = mxCreateNumericArray(2, dims, mxDOUBLE_CLASS, mxREAL);
-    double* outData = mxGetPr(plhs[0]);
-
-    // Copiar dados para a matriz de saída
-    for (size_t i = 0; i < numSamples; ++i) {
-        outData[i] = imuData.timeStamp[i];
-        outData[i + numSamples] = imuData.accx[i];
-        outData[i + 2 * numSamples] = imuData.accy[i];
-        outData[i + 3 * numSamples] = imuData.accz[i];
-        outData[i + 4 * numSamples] = imuData.gx[i];
-        outData[i + 5 * numSamples] = imuData.gy[i];
-        outData[i + 6 * numSamples] = imuData.gz[i];
-    }
-}
\ No newline at end of file
+    mexPrintf("Número de amostras: %llu\n", static_cast<unsigned long long>(numSamples));
+}
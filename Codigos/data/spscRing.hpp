@@ -0,0 +1,89 @@
+#ifndef SPSC_RING_HPP
+#define SPSC_RING_HPP
+
+#include <vector>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief Lock-free ring buffer for one producer thread and one consumer thread.
+ *
+ * The capacity is rounded up to a power of two. Each side keeps a cached copy
+ * of the other side's index on its own cache line, so the shared indices are
+ * only read when the ring looks full (producer) or empty (consumer).
+ */
+template <typename T>
+class SpscRing {
+public:
+    /**
+     * @brief Allocates the ring.
+     *
+     * @param capacity Minimum number of elements the ring can hold.
+     */
+    explicit SpscRing(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        slots_.resize(size);
+        mask_ = size - 1;
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    /**
+     * @brief Appends an element (producer thread only).
+     *
+     * @return bool False if the ring is full.
+     */
+    bool push(const T& value) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cachedHead_ == slots_.size()) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail - cachedHead_ == slots_.size()) {
+                return false;
+            }
+        }
+        slots_[tail & mask_] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest element (consumer thread only).
+     *
+     * @return bool False if the ring is empty.
+     */
+    bool pop(T& value) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cachedTail_) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head == cachedTail_) {
+                return false;
+            }
+        }
+        value = slots_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Gets the number of elements (exact only when called from one of the two threads while the other is idle).
+     */
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const { return slots_.size(); } ///< Maximum number of elements
+
+private:
+    std::vector<T> slots_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<size_t> tail_{0}; ///< Next slot to write (producer)
+    size_t cachedHead_ = 0; ///< Producer's copy of head_
+    alignas(64) std::atomic<size_t> head_{0}; ///< Next slot to read (consumer)
+    size_t cachedTail_ = 0; ///< Consumer's copy of tail_
+};
+
+#endif // SPSC_RING_HPP
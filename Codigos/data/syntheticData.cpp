@@ -0,0 +1,135 @@
+#include "syntheticData.hpp"
+#include "imuData.hpp"
+#include <charconv>
+
+namespace {
+
+// splitmix64: mesma sequência em qualquer compilador, ao contrário das
+// distribuições da biblioteca padrão
+class Random {
+public:
+    explicit Random(uint64_t seed) : state_(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state_ += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    double uniform() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+
+    // Aproximação gaussiana pela soma de 4 uniformes (variância unitária)
+    double gaussian() { return (uniform() + uniform() + uniform() + uniform() - 2.0) * std::sqrt(3.0); }
+
+private:
+    uint64_t state_;
+};
+
+const size_t writeChunk = 1 << 16;
+
+} // namespace
+
+void writeSyntheticImuLog(const std::string& fileName, size_t numSamples, const SyntheticImuOptions& options) {
+    double anglfak, accelfak;
+    if (!imuScaleFactors(options.imuModel, anglfak, accelfak)) {
+        throw std::runtime_error("Modelo não implementado.");
+    }
+
+    std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Error opening output file: " + fileName);
+    }
+
+    Random random(options.seed);
+    double period = 1e9 / options.rate;
+    uint64_t tick = 0;
+    std::vector<ImuRecord> buffer;
+    buffer.reserve(writeChunk);
+    for (size_t i = 0; i < numSamples; ++i) {
+        if (i > 0) {
+            // A lacuna vem antes da repetição: com os valores padrão todo índice de lacuna também é de repetição
+            bool gap = options.gapEvery && i % options.gapEvery == 0;
+            bool duplicate = options.duplicateEvery && i % options.duplicateEvery == 0;
+            if (gap) {
+                tick += options.gapSamples;
+            } else if (!duplicate) {
+                ++tick;
+            }
+        }
+        uint64_t t = options.startTime + static_cast<uint64_t>(tick * period);
+
+        ImuRecord r;
+        r.timeLow = static_cast<uint32_t>(t);
+        r.timeHigh = static_cast<uint32_t>(t >> 32);
+        r.gx = static_cast<int32_t>(options.gyroNoise * random.gaussian() / anglfak);
+        r.gy = static_cast<int32_t>(options.gyroNoise * random.gaussian() / anglfak);
+        r.gz = static_cast<int32_t>(options.gyroNoise * random.gaussian() / anglfak);
+        r.accx = static_cast<int32_t>(options.accNoise * random.gaussian() / accelfak);
+        r.accy = static_cast<int32_t>(options.accNoise * random.gaussian() / accelfak);
+        r.accz = static_cast<int32_t>((1.0 + options.accNoise * random.gaussian()) / accelfak);
+        buffer.push_back(r);
+
+        if (buffer.size() == writeChunk || i + 1 == numSamples) {
+            out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(ImuRecord));
+            buffer.clear();
+        }
+    }
+    if (!out) {
+        throw std::runtime_error("Error writing output file: " + fileName);
+    }
+}
+
+void writeSyntheticPosFile(const std::string& fileName, size_t numEpochs, const SyntheticGnssOptions& options) {
+    std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Error opening output file: " + fileName);
+    }
+
+    out << "% program   : synthetic RTKLIB solution\n"
+        << "% (x/y/z-ecef=WGS84,Q=1:fix,2:float,3:sbas,4:dgps,5:single,6:ppp,ns=# of satellites)\n"
+        << "%  GPST                   x-ecef(m)      y-ecef(m)      z-ecef(m)   Q  ns   sdx(m)   sdy(m)   sdz(m)\n";
+
+    Random random(options.seed);
+    size_t epoch = 0;
+    std::string buffer;
+    // to_chars para não depender do locale
+    auto append = [&buffer](auto value, auto... format) {
+        char field[64];
+        buffer.push_back(' ');
+        buffer.append(field, std::to_chars(field, field + sizeof(field), value, format...).ptr);
+    };
+    for (size_t i = 0; i < numEpochs; ++i) {
+        if (i > 0) {
+            epoch += options.gapEvery && i % options.gapEvery == 0 ? options.gapEpochs + 1 : 1;
+        }
+        double tow = options.startTow + epoch / options.rate;
+        double angle = 2 * M_PI * epoch / (60.0 * options.rate);
+        int q = random.uniform() < options.floatRatio ? 2 : 1;
+        double sd = q == 1 ? 0.01 : 0.2;
+        double x = options.x0 + options.radius * std::cos(angle) + sd * random.gaussian();
+        double y = options.y0 + options.radius * std::sin(angle) + sd * random.gaussian();
+        double z = options.z0 + sd * random.gaussian();
+        int ns = 8 + static_cast<int>(random.next() % 10);
+
+        buffer += std::to_string(options.week);
+        append(tow, std::chars_format::fixed, 3);
+        for (double v : {x, y, z}) {
+            append(v, std::chars_format::fixed, 4);
+        }
+        append(q);
+        append(ns);
+        for (double v : {sd, sd, 2 * sd}) {
+            append(v, std::chars_format::fixed, 4);
+        }
+        buffer.push_back('\n');
+
+        if (buffer.size() > (1 << 20) || i + 1 == numEpochs) {
+            out.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+    if (!out) {
+        throw std::runtime_error("Error writing output file: " + fileName);
+    }
+}
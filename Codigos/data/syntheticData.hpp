@@ -0,0 +1,65 @@
+#ifndef SYNTHETIC_DATA_HPP
+#define SYNTHETIC_DATA_HPP
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Options of the synthetic IMU log generator.
+ */
+struct SyntheticImuOptions {
+    int imuModel = 16495; ///< IMU model whose scaling is used (16495 or 16490)
+    double rate = 2000.0; ///< Sampling rate in Hz
+    uint64_t startTime = 1722997962000000000ULL; ///< First timestamp in nanoseconds
+    size_t duplicateEvery = 1000; ///< Repeat the previous timestamp every this many samples (0 = never)
+    size_t gapEvery = 100000; ///< Insert a gap every this many samples (0 = never; replaces a repetition at the same sample)
+    size_t gapSamples = 20; ///< Length of each gap in sampling intervals
+    double accNoise = 2e-3; ///< Accelerometer noise in g
+    double gyroNoise = 0.1; ///< Gyroscope noise in deg/s
+    uint64_t seed = 1; ///< Seed of the pseudo-random generator
+};
+
+/**
+ * @brief Options of the synthetic RTKLIB .pos generator.
+ */
+struct SyntheticGnssOptions {
+    double rate = 5.0; ///< Solution rate in Hz
+    int week = 2326; ///< GPS week
+    double startTow = 268362.0; ///< First time of week in seconds
+    double x0 = 3330604.0836; ///< Centre of the trajectory, X (ECEF, m)
+    double y0 = 4774361.8260; ///< Centre of the trajectory, Y (ECEF, m)
+    double z0 = 2597886.0697; ///< Centre of the trajectory, Z (ECEF, m)
+    double radius = 50.0; ///< Radius of the circular trajectory in meters
+    double floatRatio = 0.2; ///< Fraction of float (Q=2) solutions
+    size_t gapEvery = 5000; ///< Skip epochs every this many epochs (0 = never)
+    size_t gapEpochs = 10; ///< Number of epochs skipped in each gap
+    uint64_t seed = 1; ///< Seed of the pseudo-random generator
+};
+
+/**
+ * @brief Writes a synthetic IMU binary log in the 32-byte record format of loadImuData.
+ *
+ * The IMU is static: the accelerometers measure 1g on Z plus noise, so the model
+ * detection of loadImuData succeeds. The output only depends on the options.
+ *
+ * @param fileName The name of the file to write.
+ * @param numSamples The number of records.
+ * @param options The generator options.
+ * @throws std::runtime_error If the file cannot be written.
+ */
+void writeSyntheticImuLog(const std::string& fileName, size_t numSamples,
+                          const SyntheticImuOptions& options = SyntheticImuOptions());
+
+/**
+ * @brief Writes a synthetic RTKLIB solution file (ECEF, GPST week and time of week).
+ *
+ * @param fileName The name of the file to write.
+ * @param numEpochs The number of solution lines.
+ * @param options The generator options.
+ * @throws std::runtime_error If the file cannot be written.
+ */
+void writeSyntheticPosFile(const std::string& fileName, size_t numEpochs,
+                           const SyntheticGnssOptions& options = SyntheticGnssOptions());
+
+#endif // SYNTHETIC_DATA_HPP
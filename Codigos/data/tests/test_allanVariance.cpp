@@ -0,0 +1,177 @@
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include "allanVariance.hpp"
+#include "syntheticData.hpp"
+
+namespace {
+
+bool near(double a, double b, double tolerance) {
+    return std::abs(a - b) <= tolerance * std::abs(b);
+}
+
+// Definição direta por médias de cluster, com inícios a cada step amostras
+void bruteForce(const std::vector<double>& y, size_t m, size_t step,
+                double& allan, double& overlapping, double& hadamard) {
+    size_t n = y.size();
+    std::vector<double> prefix(n + 1, 0.0);
+    for (size_t i = 0; i < n; ++i) {
+        prefix[i + 1] = prefix[i] + y[i];
+    }
+    auto average = [&](size_t k) { return (prefix[k + m] - prefix[k]) / m; };
+
+    double sum = 0.0;
+    size_t count = 0;
+    for (size_t k = 0; k + 2 * m <= n; k += m) {
+        double d = average(k + m) - average(k);
+        sum += d * d;
+        ++count;
+    }
+    allan = sum / (2.0 * count);
+
+    sum = 0.0;
+    count = 0;
+    for (size_t k = 0; k + 2 * m <= n; k += step) {
+        double d = average(k + m) - average(k);
+        sum += d * d;
+        ++count;
+    }
+    overlapping = sum / (2.0 * count);
+
+    sum = 0.0;
+    count = 0;
+    for (size_t k = 0; k + 3 * m <= n; k += step) {
+        double d = average(k + 2 * m) - 2.0 * average(k + m) + average(k);
+        sum += d * d;
+        ++count;
+    }
+    hadamard = count ? sum / (6.0 * count) : std::nan("");
+}
+
+bool compareWithBruteForce(const std::vector<double>& y, double tau0, size_t overlaps) {
+    AllanOptions options;
+    options.overlapsPerCluster = overlaps;
+    options.numThreads = 2;
+    AllanCurve curve = computeAllanVariance(y.data(), y.size(), tau0, options);
+    for (size_t p = 0; p < curve.tau.size(); ++p) {
+        size_t m = curve.clusterSize[p];
+        size_t step = 1;
+        if (overlaps != 0) {
+            while (2 * step * overlaps <= m) {
+                step *= 2;
+            }
+        }
+        double allan, overlapping, hadamard;
+        bruteForce(y, m, step, allan, overlapping, hadamard);
+        bool hadamardOk = std::isnan(hadamard) ? std::isnan(curve.hadamard[p]) : near(curve.hadamard[p], hadamard, 1e-8);
+        if (!near(curve.allan[p], allan, 1e-8) || !near(curve.overlappingAllan[p], overlapping, 1e-8) || !hadamardOk) {
+            std::cerr << "m=" << m << " (step " << step << "): " << curve.allan[p] << "/" << allan << " "
+                      << curve.overlappingAllan[p] << "/" << overlapping << " " << curve.hadamard[p] << "/"
+                      << hadamard << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    std::mt19937_64 rng(7);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    const double tau0 = 1.0 / 2000.0;
+
+    // Contra a definição direta, com e sem dizimação
+    {
+        std::vector<double> y(5000);
+        double drift = 0.0;
+        for (double& v : y) {
+            drift += 0.01 * normal(rng);
+            v = 3.0 + normal(rng) + drift;
+        }
+        ok = compareWithBruteForce(y, tau0, 0) && ok;
+        ok = compareWithBruteForce(y, tau0, 4) && ok;
+    }
+
+    // Ruído branco (ARW) mais passeio aleatório da taxa (RRW) com coeficientes conhecidos
+    const size_t n = 10000000;
+    const double arw = 0.004; // unidade * sqrt(s)
+    const double rrw = 2e-4; // unidade / sqrt(s)
+    std::vector<double> y(n);
+    double rate = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        rate += rrw * std::sqrt(tau0) * normal(rng);
+        y[i] = 0.5 + rate + arw / std::sqrt(tau0) * normal(rng);
+    }
+
+    AllanOptions options;
+    auto start = std::chrono::steady_clock::now();
+    AllanCurve curve = computeAllanVariance(y.data(), n, tau0, options);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Allan curve of " << n << " samples (" << curve.tau.size() << " cluster times): " << seconds
+              << " s, " << n / seconds / 1e6 << " M samples/s" << std::endl;
+
+    AllanNoise noise = fitAllanNoise(curve);
+    std::cout << "ARW " << noise.angleRandomWalk.value << " (" << arw << "), RRW " << noise.rateRandomWalk.value
+              << " (" << rrw << "), bias instability " << noise.biasInstability.value << " at "
+              << noise.biasInstability.tau << " s" << std::endl;
+    if (!noise.angleRandomWalk.ok() || !near(noise.angleRandomWalk.value, arw, 0.05)) {
+        std::cerr << "Wrong angle random walk." << std::endl;
+        ok = false;
+    }
+    if (!noise.rateRandomWalk.ok() || !near(noise.rateRandomWalk.value, rrw, 0.3)) {
+        std::cerr << "Wrong rate random walk." << std::endl;
+        ok = false;
+    }
+
+    // Ruído branco puro: Hadamard e Allan coincidem com sigma^2 tau0 / tau
+    for (size_t p = 0; p < curve.tau.size() && curve.clusterSize[p] <= 64; ++p) {
+        double expected = arw * arw / curve.tau[p];
+        if (!near(curve.overlappingAllan[p], expected, 0.05) || !near(curve.hadamard[p], expected, 0.05)) {
+            std::cerr << "White noise level wrong at tau " << curve.tau[p] << std::endl;
+            ok = false;
+            break;
+        }
+    }
+
+    // O resultado não depende do número de threads
+    options.numThreads = 1;
+    AllanCurve single = computeAllanVariance(y.data(), 1000000, tau0, options);
+    options.numThreads = 3;
+    AllanCurve multi = computeAllanVariance(y.data(), 1000000, tau0, options);
+    if (single.overlappingAllan != multi.overlappingAllan || single.allan != multi.allan) {
+        std::cerr << "Result depends on the number of threads." << std::endl;
+        ok = false;
+    }
+
+    // Log sintético: o ARW do giroscópio é o ruído branco configurado
+    const std::string fileName = "test_allan.bin";
+    try {
+        SyntheticImuOptions imuOptions;
+        writeSyntheticImuLog(fileName, 400000, imuOptions);
+        int imuModel = 0;
+        ImuData imuData = loadImuData(fileName, imuModel, false, CacheMode::Off);
+        ImuAllanResult result = imuAllanVariance(imuData);
+        std::cout << getLogStream(result);
+        double expected = imuOptions.gyroNoise * std::sqrt(1.0 / imuOptions.rate);
+        const NoiseFit& gyroArw = result.noiseOf(ImuChannel::Gz).angleRandomWalk;
+        if (!near(result.sampleInterval, 1.0 / imuOptions.rate, 1e-6) || !gyroArw.ok() ||
+            !near(gyroArw.value, expected, 0.05)) {
+            std::cerr << "Synthetic gyro ARW " << gyroArw.value << ", expected " << expected << std::endl;
+            ok = false;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        ok = false;
+    }
+    std::remove(fileName.c_str());
+
+    if (!ok) {
+        return 1;
+    }
+    std::cout << "Allan variance test passed." << std::endl;
+    return 0;
+}
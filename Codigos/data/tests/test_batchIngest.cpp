@@ -0,0 +1,127 @@
+#include <iostream>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <cstdio>
+#include <stdexcept>
+#include "batchIngest.hpp"
+#include "workStealingPool.hpp"
+#include "syntheticData.hpp"
+
+int main() {
+    const size_t numSessions = 6;
+    std::vector<IngestSession> sessions(numSessions);
+    std::vector<std::string> files;
+    try {
+        // O pool executa tarefas criadas por outras tarefas
+        {
+            WorkStealingPool pool(4);
+            std::atomic<int> count{0};
+            for (int i = 0; i < 50; ++i) {
+                pool.submit([&]() {
+                    ++count;
+                    for (int j = 0; j < 10; ++j) {
+                        pool.submit([&]() { ++count; });
+                    }
+                });
+            }
+            pool.wait();
+            if (count != 550) {
+                std::cerr << "Pool ran " << count << " tasks instead of 550." << std::endl;
+                return 1;
+            }
+        }
+
+        // Tarefas de fora começam na ordem de submissão (as maiores primeiro em ingestSessions)
+        {
+            std::vector<int> started;
+            std::mutex startedMutex;
+            {
+                WorkStealingPool pool(1);
+                for (int i = 0; i < 12; ++i) {
+                    pool.submit([&, i]() {
+                        std::lock_guard<std::mutex> lock(startedMutex);
+                        started.push_back(i);
+                    });
+                }
+                pool.wait();
+            }
+            for (int i = 0; i < 12; ++i) {
+                if (started.size() != 12 || started[i] != i) {
+                    std::cerr << "Pool did not start the tasks in submission order." << std::endl;
+                    return 1;
+                }
+            }
+        }
+
+        // Sessões sintéticas de tamanhos diferentes; a última tem um arquivo GNSS inexistente
+        for (size_t s = 0; s < numSessions; ++s) {
+            sessions[s].imuFile = "test_batch_" + std::to_string(s) + ".bin";
+            sessions[s].gnssFile = "test_batch_" + std::to_string(s) + ".pos";
+            SyntheticImuOptions imuOptions;
+            imuOptions.seed = s + 1;
+            SyntheticGnssOptions gnssOptions;
+            gnssOptions.seed = s + 1;
+            writeSyntheticImuLog(sessions[s].imuFile, 20000 * (s + 1), imuOptions);
+            files.push_back(sessions[s].imuFile);
+            if (s + 1 < numSessions) {
+                writeSyntheticPosFile(sessions[s].gnssFile, 3000 * (s + 1), gnssOptions);
+                files.push_back(sessions[s].gnssFile);
+            }
+        }
+
+        IngestOptions options;
+        options.numThreads = 4;
+        options.maxInFlightBytes = 4 << 20;
+        options.logData = true;
+        options.cache = CacheMode::Off;
+        std::vector<IngestResult> results = ingestSessions(sessions, options);
+
+        for (size_t s = 0; s < numSessions; ++s) {
+            const IngestResult& result = results[s];
+            int model = 0;
+            ImuData imuData = loadImuData(sessions[s].imuFile, model, false, CacheMode::Off);
+            if (!result.imuError.empty() || result.imuModel != model || result.imuData.timeStamp != imuData.timeStamp ||
+                result.imuData.accz != imuData.accz || result.imuData.gx != imuData.gx) {
+                std::cerr << "IMU data of session " << s << " does not match." << std::endl;
+                return 1;
+            }
+            // Cada log fala apenas do seu próprio arquivo
+            if (result.log.find("Loading GNSS data from " + sessions[s].gnssFile) == std::string::npos ||
+                result.log.find("test_batch_" + std::to_string((s + 1) % numSessions)) != std::string::npos) {
+                std::cerr << "Log of session " << s << " is wrong:\n" << result.log << std::endl;
+                return 1;
+            }
+            if (s + 1 < numSessions) {
+                GnssData gnssData = loadGnssData(sessions[s].gnssFile, false, 1, CacheMode::Off);
+                if (!result.ok() || result.gnssData.time != gnssData.time || result.gnssData.lat != gnssData.lat) {
+                    std::cerr << "GNSS data of session " << s << " does not match." << std::endl;
+                    return 1;
+                }
+            } else if (result.ok() || result.gnssError.empty()) {
+                std::cerr << "Missing GNSS file was not reported." << std::endl;
+                return 1;
+            }
+        }
+
+        // Cada carga maior que o limite roda sozinha, sem prender os outros workers
+        options.maxInFlightBytes = 1;
+        std::vector<IngestResult> alone = ingestSessions(sessions, options);
+        for (size_t s = 0; s < numSessions; ++s) {
+            if (alone[s].ok() != results[s].ok() || alone[s].imuData.timeStamp != results[s].imuData.timeStamp ||
+                alone[s].gnssData.time != results[s].gnssData.time) {
+                std::cerr << "Session " << s << " differs when every load runs alone." << std::endl;
+                return 1;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    for (const std::string& file : files) {
+        std::remove(file.c_str());
+    }
+
+    std::cout << "Batch ingest matches the serial loaders." << std::endl;
+    return 0;
+}
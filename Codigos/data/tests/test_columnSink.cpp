@@ -0,0 +1,96 @@
+#include <iostream>
+#include <vector>
+#include <stdexcept>
+#include "imuData.hpp"
+#include "gnssData.hpp"
+
+namespace {
+
+// Compara uma coluna com passo com a coluna do loader de vetores
+bool sameColumn(const ColumnSink& column, const std::vector<double>& expected) {
+    for (size_t i = 0; i < expected.size(); ++i) {
+        if (column[i] != expected[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool sameImu(const ImuColumns& columns, size_t numSamples, const ImuData& imuData) {
+    return numSamples == imuData.timeStamp.size() && sameColumn(columns.timeStamp, imuData.timeStamp) &&
+           sameColumn(columns.accx, imuData.accx) && sameColumn(columns.accy, imuData.accy) &&
+           sameColumn(columns.accz, imuData.accz) && sameColumn(columns.gx, imuData.gx) &&
+           sameColumn(columns.gy, imuData.gy) && sameColumn(columns.gz, imuData.gz);
+}
+
+bool sameGnss(const GnssColumns& columns, size_t numSamples, const GnssData& gnssData) {
+    std::vector<double> fix(gnssData.fix.begin(), gnssData.fix.end());
+    return numSamples == gnssData.time.size() && sameColumn(columns.time, gnssData.time) &&
+           sameColumn(columns.x, gnssData.x) && sameColumn(columns.y, gnssData.y) &&
+           sameColumn(columns.z, gnssData.z) && sameColumn(columns.lat, gnssData.lat) &&
+           sameColumn(columns.lon, gnssData.lon) && sameColumn(columns.alt, gnssData.alt) &&
+           sameColumn(columns.fix, fix);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <filename.bin> <filename.pos>" << std::endl;
+        return 1;
+    }
+
+    try {
+        int model = 0;
+        ImuData imuData = loadImuData(argv[1], model, false, CacheMode::Off);
+        GnssData gnssData = loadGnssData(argv[2], false, 1, CacheMode::Off);
+
+        for (CacheMode cache : {CacheMode::Rebuild, CacheMode::Use}) {
+            // Matriz column-major, como a do MATLAB
+            std::vector<double> imuMatrix;
+            ImuColumns imuColumns;
+            int sinkModel = 0;
+            size_t numImu = loadImuData(argv[1], sinkModel, [&](size_t n) {
+                imuMatrix.assign(n * 7, 0.0);
+                imuColumns.timeStamp = matrixColumn(imuMatrix.data(), n, 0);
+                imuColumns.accx = matrixColumn(imuMatrix.data(), n, 1);
+                imuColumns.accy = matrixColumn(imuMatrix.data(), n, 2);
+                imuColumns.accz = matrixColumn(imuMatrix.data(), n, 3);
+                imuColumns.gx = matrixColumn(imuMatrix.data(), n, 4);
+                imuColumns.gy = matrixColumn(imuMatrix.data(), n, 5);
+                imuColumns.gz = matrixColumn(imuMatrix.data(), n, 6);
+                return imuColumns;
+            }, cache);
+            if (sinkModel != model || !sameImu(imuColumns, numImu, imuData)) {
+                std::cerr << "IMU columns do not match ImuData." << std::endl;
+                return 1;
+            }
+
+            // Linhas intercaladas (passo igual ao número de canais)
+            std::vector<double> gnssRows;
+            GnssColumns gnssColumns;
+            size_t numGnss = loadGnssData(argv[2], [&](size_t n) {
+                gnssRows.assign(n * 8, 0.0);
+                ColumnSink* sinks[] = {&gnssColumns.time, &gnssColumns.x, &gnssColumns.y, &gnssColumns.z,
+                                       &gnssColumns.lat, &gnssColumns.lon, &gnssColumns.alt, &gnssColumns.fix};
+                for (size_t c = 0; c < 8; ++c) {
+                    *sinks[c] = ColumnSink{gnssRows.data() + c, 8};
+                }
+                return gnssColumns;
+            }, 0, cache);
+            if (!sameGnss(gnssColumns, numGnss, gnssData)) {
+                std::cerr << "GNSS columns do not match GnssData." << std::endl;
+                return 1;
+            }
+        }
+
+        invalidateCache(argv[1]);
+        invalidateCache(argv[2]);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Column sinks match the vector loaders." << std::endl;
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include <iostream>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "imuData.hpp"
+#include "gnssData.hpp"
+
+namespace {
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <filename.bin> <filename.pos>" << std::endl;
+        return 1;
+    }
+
+    try {
+        // Decode from the source and write the cache
+        auto start = std::chrono::steady_clock::now();
+        int model = 0;
+        ImuData imuData = loadImuData(argv[1], model, false, CacheMode::Rebuild);
+        GnssData gnssData = loadGnssData(argv[2], false, 1, CacheMode::Rebuild);
+        std::cout << "Decode and write cache: " << elapsedMs(start) << " ms\n";
+
+        // Load from the cache
+        start = std::chrono::steady_clock::now();
+        int cachedModel = 0;
+        ImuData imuCached;
+        GnssData gnssCached;
+        if (!readImuCache(argv[1], cachedModel, imuCached) || !readGnssCache(argv[2], gnssCached)) {
+            std::cerr << "Cache was not written or is not valid." << std::endl;
+            return 1;
+        }
+        std::cout << "Load from cache: " << elapsedMs(start) << " ms\n";
+
+        if (cachedModel != model || imuCached.timeStamp != imuData.timeStamp || imuCached.accx != imuData.accx ||
+            imuCached.accy != imuData.accy || imuCached.accz != imuData.accz || imuCached.gx != imuData.gx ||
+            imuCached.gy != imuData.gy || imuCached.gz != imuData.gz) {
+            std::cerr << "Cached IMU data does not match." << std::endl;
+            return 1;
+        }
+        if (gnssCached.time != gnssData.time || gnssCached.x != gnssData.x || gnssCached.y != gnssData.y ||
+            gnssCached.z != gnssData.z || gnssCached.lat != gnssData.lat || gnssCached.lon != gnssData.lon ||
+            gnssCached.alt != gnssData.alt || gnssCached.fix != gnssData.fix) {
+            std::cerr << "Cached GNSS data does not match." << std::endl;
+            return 1;
+        }
+
+        // A different model must not be served from the cache
+        int otherModel = model == 16495 ? 16490 : 16495;
+        if (readImuCache(argv[1], otherModel, imuCached)) {
+            std::cerr << "Cache accepted a different IMU model." << std::endl;
+            return 1;
+        }
+
+        // Several loads of the same file writing the cache at once must leave a valid cache
+        invalidateCache(argv[1]);
+        std::vector<std::thread> writers;
+        for (int w = 0; w < 4; ++w) {
+            writers.emplace_back([&]() {
+                int writerModel = 0;
+                loadImuData(argv[1], writerModel, false, CacheMode::Rebuild);
+            });
+        }
+        for (std::thread& writer : writers) {
+            writer.join();
+        }
+        if (!readImuCache(argv[1], cachedModel, imuCached) || imuCached.timeStamp != imuData.timeStamp ||
+            imuCached.gz != imuData.gz) {
+            std::cerr << "Cache written by concurrent loads is not valid." << std::endl;
+            return 1;
+        }
+
+        // After invalidation the cache must not be used
+        invalidateCache(argv[1]);
+        invalidateCache(argv[2]);
+        if (readImuCache(argv[1], cachedModel, imuCached) || readGnssCache(argv[2], gnssCached)) {
+            std::cerr << "Cache still valid after invalidation." << std::endl;
+            return 1;
+        }
+        std::cout << "Cache round trip OK." << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include "imuData.hpp"
+
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " <filename.bin>" << std::endl;
+        return 1;
+    }
+
+    std::string inputFileName = argv[1];
+    std::string baseName = inputFileName.substr(0, inputFileName.find_last_of('.'));
+    // Remove the path from the output file name
+    baseName = baseName.substr(baseName.find_last_of("\\/") + 1);
+
+    try {
+        int model = 0;
+        ImuData imuData = loadImuData(inputFileName, model, false);
+        size_t numSamples = imuData.timeStamp.size();
+
+        exportImuData(imuData, baseName + ".txt", 0, numSamples, ExportFormat::Text);
+        exportImuData(imuData, baseName + ".csv", 0, numSamples, ExportFormat::Csv);
+        exportImuData(imuData, baseName + ".dat", 0, numSamples, ExportFormat::Binary);
+
+        // The binary file must give back the exact columns
+        std::ifstream in(baseName + ".dat", std::ios::binary);
+        std::vector<double> row(7);
+        for (size_t i = 0; i < numSamples; ++i) {
+            if (!in.read(reinterpret_cast<char*>(row.data()), row.size() * sizeof(double)) ||
+                row[0] != imuData.timeStamp[i] || row[1] != imuData.accx[i] || row[2] != imuData.accy[i] ||
+                row[3] != imuData.accz[i] || row[4] != imuData.gx[i] || row[5] != imuData.gy[i] ||
+                row[6] != imuData.gz[i]) {
+                std::cerr << "Binary export differs at row " << i << std::endl;
+                return 1;
+            }
+        }
+
+        // The text file must match the operator<< layout
+        std::ifstream text(baseName + ".txt");
+        std::string line;
+        std::getline(text, line);
+        for (size_t i = 0; i < std::min<size_t>(numSamples, 1000); ++i) {
+            std::ostringstream expected;
+            expected << std::fixed << std::setprecision(9) << imuData.timeStamp[i] << "\t" << imuData.accx[i]
+                     << "\t" << imuData.accy[i] << "\t" << imuData.accz[i] << "\t" << imuData.gx[i] << "\t"
+                     << imuData.gy[i] << "\t" << imuData.gz[i];
+            std::getline(text, line);
+            if (line != expected.str()) {
+                std::cerr << "Text export differs at row " << i << std::endl;
+                return 1;
+            }
+        }
+        std::cout << "IMU data exported to " << baseName << ".txt, .csv and .dat" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,148 @@
+// Compilar com -DDATA_PROFILE (sem ele os carregadores não registram etapas)
+#include <iostream>
+#include <cstdio>
+#include <stdexcept>
+#include <sstream>
+#include <thread>
+#include "dataProfile.hpp"
+#include "imuData.hpp"
+#include "gnssData.hpp"
+#include "syntheticData.hpp"
+#include "dataLog.hpp"
+
+DATA_PROFILE_COUNT_NEW
+
+namespace {
+
+const StageProfile* findStage(const std::vector<StageProfile>& report, const std::string& name) {
+    for (const StageProfile& s : report) {
+        if (s.name == name) {
+            return &s;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+int main() {
+    if (!dataProfileEnabled) {
+        std::cerr << "Build this test with -DDATA_PROFILE." << std::endl;
+        return 1;
+    }
+
+    const std::string imuFile = "test_profile.bin";
+    const std::string posFile = "test_profile.pos";
+    const std::string bigPosFile = "test_profile_big.pos";
+    const size_t numSamples = 20000;
+    bool ok = true;
+    try {
+        SyntheticImuOptions imuOptions;
+        imuOptions.duplicateEvery = 100;
+        writeSyntheticImuLog(imuFile, numSamples, imuOptions);
+        writeSyntheticPosFile(posFile, numSamples);
+
+        resetDataProfile();
+        int imuModel = 0;
+        ImuData imuData = loadImuData(imuFile, imuModel, false, CacheMode::Off);
+        GnssData gnssData = loadGnssData(posFile, false, 1, CacheMode::Off);
+
+        std::vector<StageProfile> report = dataProfileReport();
+        std::cout << formatDataProfile(report);
+
+        const char* expected[] = {"imu.read", "imu.detectModel", "imu.decode", "imu.duplicates",
+                                  "gnss.read", "gnss.parse", "gnss.llaFromEcef"};
+        for (const char* name : expected) {
+            if (!findStage(report, name)) {
+                std::cerr << "Missing stage " << name << std::endl;
+                ok = false;
+            }
+        }
+        if (!ok) {
+            return 1;
+        }
+
+        const StageProfile* read = findStage(report, "imu.read");
+        const StageProfile* decode = findStage(report, "imu.decode");
+        const StageProfile* duplicates = findStage(report, "imu.duplicates");
+        if (read->records != numSamples || read->bytes != numSamples * sizeof(ImuRecord) ||
+            decode->records != numSamples || duplicates->records != numSamples - imuData.timeStamp.size()) {
+            std::cerr << "Wrong IMU counters." << std::endl;
+            ok = false;
+        }
+        // As 7 colunas de saída são alocadas na decodificação
+        if (decode->allocations < 7 || decode->allocatedBytes < 7 * imuData.timeStamp.size() * sizeof(double)) {
+            std::cerr << "Decode allocations not counted: " << decode->allocations << std::endl;
+            ok = false;
+        }
+        const StageProfile* parse = findStage(report, "gnss.parse");
+        if (parse->records != gnssData.time.size() || findStage(report, "gnss.llaFromEcef")->records != parse->records) {
+            std::cerr << "Wrong GNSS counters." << std::endl;
+            ok = false;
+        }
+        if (dataProfileReport("imu.").size() + dataProfileReport("gnss.").size() != report.size()) {
+            std::cerr << "Prefix filter failed." << std::endl;
+            ok = false;
+        }
+
+        std::string json = dataProfileJson(report);
+        if (json.compare(0, 12, "{\"stages\": [") != 0 || json.find("\"name\": \"imu.decode\"") == std::string::npos) {
+            std::cerr << "Unexpected JSON: " << json << std::endl;
+            ok = false;
+        }
+
+        // Os contadores acumulam entre cargas até resetDataProfile
+        loadImuData(imuFile, imuModel, false, CacheMode::Off);
+        if (findStage(dataProfileReport(), "imu.decode")->calls != 2) {
+            std::cerr << "Stage calls did not accumulate." << std::endl;
+            ok = false;
+        }
+        // O log de cada carga mostra só as suas etapas, mesmo depois de outras ou ao mesmo tempo que elas;
+        // o GNSS maior é lido em dois blocos, cada um na sua thread
+        const size_t bigEpochs = 3 * numSamples;
+        writeSyntheticPosFile(bigPosFile, bigEpochs);
+        std::ostringstream imuLog, gnssLog;
+        std::thread imuLoad([&]() {
+            ScopedDataLog redirect(imuLog);
+            int model = 0;
+            loadImuData(imuFile, model, true, CacheMode::Off);
+        });
+        std::thread gnssLoad([&]() {
+            ScopedDataLog redirect(gnssLog);
+            loadGnssData(bigPosFile, true, 2, CacheMode::Off);
+        });
+        imuLoad.join();
+        gnssLoad.join();
+        std::string parseLine = "Stage gnss.parse: 2 calls";
+        size_t parseAt = gnssLog.str().find(parseLine);
+        if (imuLog.str().find("Stage imu.decode: 1 calls") == std::string::npos ||
+            imuLog.str().find("gnss.") != std::string::npos || parseAt == std::string::npos ||
+            gnssLog.str().find("Stage imu.") != std::string::npos ||
+            gnssLog.str().find(std::to_string(bigEpochs) + " records", parseAt) == std::string::npos) {
+            std::cerr << "Load logs do not hold only their own stages:\n" << imuLog.str() << gnssLog.str();
+            ok = false;
+        }
+        if (findStage(dataProfileReport(), "imu.decode")->calls != 3) {
+            std::cerr << "Process-wide report lost a load." << std::endl;
+            ok = false;
+        }
+
+        resetDataProfile();
+        if (!dataProfileReport().empty()) {
+            std::cerr << "Reset failed." << std::endl;
+            ok = false;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        ok = false;
+    }
+    std::remove(imuFile.c_str());
+    std::remove(posFile.c_str());
+    std::remove(bigPosFile.c_str());
+
+    if (!ok) {
+        return 1;
+    }
+    std::cout << "Data profile test passed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include <iostream>
+#include <stdexcept>
+#include "dataWaiter.hpp"
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <filename.bin> <filename.pos>" << std::endl;
+        return 1;
+    }
+
+    try {
+        int model = 0;
+        ImuData imuData = loadImuData(argv[1], model, false);
+        GnssData gnssData = loadGnssData(argv[2], false);
+
+        DataWaiter dw;
+        dw.addImu(imuData);
+        dw.addGnss(gnssData);
+
+        // Get the first 270000 oldest measurements (skip gnss gap)
+        std::vector<Measurement> measurements;
+        dw.popSorted(270000, measurements);
+
+        // Display the next oldest measurements
+        std::cout << std::fixed << std::setprecision(3);
+        for (int i = 1; i <= 120; ++i) {
+            dw.popSorted(1, measurements);
+            if (measurements.empty()) {
+                break;
+            }
+            const Measurement& m = measurements[0];
+            if (m.type == SensorType::Imu && i % 10 == 0) {
+                std::cout << "IMU: dataPtr = " << dw.dataPtr(m.sensor) << ", timestamp = " << m.time << "\n";
+            } else if (m.type == SensorType::Gnss) {
+                std::cout << "GNSS: dataPtr = " << dw.dataPtr(m.sensor) << ", timestamp = " << m.time << "\n";
+            }
+        }
+
+        // The whole playback must be in time order and visit every sample once
+        dw.reset();
+        Measurement m, previous;
+        size_t count = 0;
+        while (dw.popNext(m)) {
+            if (count > 0 && m.time < previous.time) {
+                std::cerr << "Measurements out of order at " << count << std::endl;
+                return 1;
+            }
+            previous = m;
+            ++count;
+        }
+        if (count != imuData.timeStamp.size() + gnssData.time.size()) {
+            std::cerr << "Wrong number of measurements: " << count << std::endl;
+            return 1;
+        }
+        std::cout << "Played back " << count << " measurements in time order." << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
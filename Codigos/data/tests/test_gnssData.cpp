@@ -1,8 +1,46 @@
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
+#include <string>
 #include "gnssData.hpp"
 
+// Campos que o operator>> rejeita (inf, nan, com ou sem sinal) invalidam a linha também no leitor rápido
+bool rejectsNonFiniteTokens() {
+    const char* tokens[] = {"inf", "-inf", "+inf", "nan", "-nan", "+nan", "infinity", "-infinity", "-INF", "-NaN"};
+    for (const char* token : tokens) {
+        for (int column = 0; column < 4; ++column) {
+            std::ostringstream line;
+            line << "2200";
+            for (int c = 0; c < 4; ++c) {
+                line << ' ' << (c == column ? token : "-1.5");
+            }
+            line << " 1\n";
+            std::string text = line.str();
+            GnssData gnssData;
+            parseGnssText(text.data(), text.data() + text.size(), gnssData);
+            if (!gnssData.time.empty()) {
+                std::cerr << "Line accepted with '" << token << "' in column " << column + 1 << ": " << text;
+                return false;
+            }
+        }
+    }
+    // Os números com sinal continuam aceitos
+    std::string valid = "2200 -.5 -1.5e3 +2 -0 1\n";
+    GnssData gnssData;
+    parseGnssText(valid.data(), valid.data() + valid.size(), gnssData);
+    if (gnssData.time.size() != 1 || gnssData.time[0] != -0.5 || gnssData.x[0] != -1500.0 || gnssData.y[0] != 2.0) {
+        std::cerr << "Signed numbers are not parsed." << std::endl;
+        return false;
+    }
+    return true;
+}
+
 int main(int argc, char* argv[]) {
+    if (!rejectsNonFiniteTokens()) {
+        return 1;
+    }
+    std::cout << "Non-finite tokens are rejected." << std::endl;
+
     if (argc != 2) {
         std::cerr << "Usage: " << argv[0] << " <filename.pos>" << std::endl;
         return 1;
@@ -17,6 +55,17 @@ int main(int argc, char* argv[]) {
         GnssData gnssData = loadGnssData(inputFileName, true);
         std::cout << "GNSS data loaded successfully." << std::endl;
 
+        // The multi-threaded loader must give exactly the same columns
+        GnssData gnssParallel = loadGnssData(inputFileName, false, 0, CacheMode::Off);
+        if (gnssParallel.time != gnssData.time || gnssParallel.x != gnssData.x ||
+            gnssParallel.y != gnssData.y || gnssParallel.z != gnssData.z ||
+            gnssParallel.lat != gnssData.lat || gnssParallel.lon != gnssData.lon ||
+            gnssParallel.alt != gnssData.alt || gnssParallel.fix != gnssData.fix) {
+            std::cerr << "Multi-threaded GNSS loading does not match the serial loader." << std::endl;
+            return 1;
+        }
+        std::cout << "Multi-threaded GNSS loading matches." << std::endl;
+
         outputGnss(gnssData, outputFileName, 1100, 1140);
         std::cout << "GNSS data has been written to " << outputFileName << std::endl;
     } catch (const std::exception& e) {
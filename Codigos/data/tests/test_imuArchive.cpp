@@ -0,0 +1,138 @@
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include "imuArchive.hpp"
+
+namespace {
+
+bool sameRecords(const std::vector<ImuRecord>& a, const ImuRecord* b, size_t n) {
+    return a.size() == n && (n == 0 || std::memcmp(a.data(), b, n * sizeof(ImuRecord)) == 0);
+}
+
+std::vector<char> readFile(const std::string& fileName) {
+    std::ifstream file(fileName, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// Registros com casos extremos: saltos de tempo, tempo decrescente e canais nos limites de int32
+std::vector<ImuRecord> edgeRecords(size_t n) {
+    std::vector<ImuRecord> records(n);
+    uint64_t t = 1722997962000000000ULL;
+    uint64_t state = 12345;
+    for (size_t i = 0; i < n; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        if (i % 1000 == 999) {
+            t += 3600000000000ULL;
+        } else if (i % 777 == 0) {
+            t -= 5000000;
+        } else if (i % 50 != 0) {
+            t += 500000;
+        }
+        if (i == n / 2) {
+            t = std::numeric_limits<uint64_t>::max() - 3;
+        }
+        ImuRecord& r = records[i];
+        r.timeLow = static_cast<uint32_t>(t);
+        r.timeHigh = static_cast<uint32_t>(t >> 32);
+        r.gx = i % 2 ? std::numeric_limits<int32_t>::min() : std::numeric_limits<int32_t>::max();
+        r.gy = static_cast<int32_t>(state >> 32);
+        r.gz = static_cast<int32_t>(i);
+        r.accx = 0;
+        r.accy = static_cast<int32_t>(state >> 40) - (1 << 23);
+        r.accz = 262144000 + static_cast<int32_t>(state >> 50);
+    }
+    return records;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::string archiveName = "test_imuArchive.imuz";
+    try {
+        // Casos extremos com vários tamanhos de bloco e de grupo
+        for (size_t n : {1, 2, 128, 129, 130, 5000}) {
+            std::vector<ImuRecord> records = edgeRecords(n);
+            for (size_t blockRecords : {1, 127, 1000, 65536}) {
+                writeImuArchive(records.data(), records.size(), archiveName, blockRecords, 3);
+                std::vector<char> archive = readFile(archiveName);
+                if (!sameRecords(decodeImuArchive(archive.data(), archive.size(), 2), records.data(), n)) {
+                    std::cerr << "Round trip failed for " << n << " records, blocks of " << blockRecords << std::endl;
+                    return 1;
+                }
+            }
+        }
+
+        // Um arquivo vazio de registros
+        writeImuArchive(nullptr, 0, archiveName);
+        std::vector<char> empty = readFile(archiveName);
+        if (!decodeImuArchive(empty.data(), empty.size()).empty()) {
+            std::cerr << "Empty archive is not empty." << std::endl;
+            return 1;
+        }
+
+        // Arquivo corrompido deve ser rejeitado
+        std::vector<ImuRecord> records = edgeRecords(3000);
+        writeImuArchive(records.data(), records.size(), archiveName, 1000);
+        std::vector<char> archive = readFile(archiveName);
+        archive[200] ^= 0x5a;
+        archive[archive.size() / 2] ^= 0x33;
+        bool rejected = false;
+        try {
+            rejected = !sameRecords(decodeImuArchive(archive.data(), archive.size()), records.data(), records.size());
+        } catch (const std::runtime_error&) {
+            rejected = true;
+        }
+        if (!rejected) {
+            std::cerr << "Corrupted archive was accepted." << std::endl;
+            return 1;
+        }
+
+        // Log real: bytes idênticos e mesmo resultado de loadImuData
+        if (argc == 2) {
+            MappedFile log(argv[1]);
+            size_t numRecords = 0;
+            const ImuRecord* raw = imuRecords(log, argv[1], numRecords);
+
+            auto start = std::chrono::steady_clock::now();
+            compressImuLog(argv[1], archiveName);
+            double encodeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            MappedFile compressed(archiveName);
+            start = std::chrono::steady_clock::now();
+            std::vector<ImuRecord> decoded = decodeImuArchive(compressed.data(), compressed.size(), 1);
+            double decodeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (!sameRecords(decoded, raw, numRecords)) {
+                std::cerr << "Decoded archive differs from " << argv[1] << std::endl;
+                return 1;
+            }
+
+            int rawModel = 0, archiveModel = 0;
+            ImuData fromRaw = loadImuData(argv[1], rawModel, false, CacheMode::Off);
+            ImuData fromArchive = loadImuData(archiveName, archiveModel, false, CacheMode::Off);
+            if (rawModel != archiveModel || fromRaw.timeStamp != fromArchive.timeStamp ||
+                fromRaw.accx != fromArchive.accx || fromRaw.accy != fromArchive.accy ||
+                fromRaw.accz != fromArchive.accz || fromRaw.gx != fromArchive.gx || fromRaw.gy != fromArchive.gy ||
+                fromRaw.gz != fromArchive.gz) {
+                std::cerr << "loadImuData differs between the log and its archive." << std::endl;
+                return 1;
+            }
+
+            double rawBytes = static_cast<double>(log.size());
+            std::cout << "Compression ratio: " << rawBytes / compressed.size() << "\n"
+                      << "Encode: " << rawBytes / encodeSeconds / 1e6 << " MB/s\n"
+                      << "Decode (1 thread): " << rawBytes / decodeSeconds / 1e6 << " MB/s\n";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        std::remove(archiveName.c_str());
+        return 1;
+    }
+    std::remove(archiveName.c_str());
+
+    std::cout << "IMU archive round trip is bit-exact." << std::endl;
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <stdexcept>
+#include "imuData.hpp"
+
+// Regression test: duplicate timestamps must be removed from all channels
+// together, keeping the first sample of each run.
+int main() {
+    const std::string fileName = "test_imuDuplicates.bin";
+    const int32_t oneG = static_cast<int32_t>(1.0 / (2.5e-4 / (1 << 16))); // ADIS16495
+
+    // Record i carries i in every channel; runs of 2 and 3 equal timestamps
+    std::vector<ImuRecord> records;
+    std::vector<uint64_t> times = {1000, 1500, 1500, 2000, 2500, 2500, 2500, 3000, 3500, 3500};
+    for (size_t i = 0; i < times.size(); ++i) {
+        uint64_t t = 1700000000000000000ULL + times[i] * 1000;
+        int32_t v = static_cast<int32_t>(i);
+        records.push_back({static_cast<uint32_t>(t), static_cast<uint32_t>(t >> 32), v, v, v, v, v, oneG + v});
+    }
+    {
+        std::ofstream out(fileName, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(ImuRecord));
+    }
+
+    const std::vector<size_t> expected = {0, 1, 3, 4, 7, 8};
+    int failures = 0;
+    try {
+        int model = 0;
+        ImuData imuData = loadImuData(fileName, model, false, CacheMode::Off);
+        double anglfak, accelfak;
+        imuScaleFactors(model, anglfak, accelfak);
+
+        if (model != 16495 || imuData.timeStamp.size() != expected.size()) {
+            std::cerr << "Expected model 16495 and " << expected.size() << " samples, got " << model << " and "
+                      << imuData.timeStamp.size() << std::endl;
+            ++failures;
+        } else {
+            for (size_t k = 0; k < expected.size(); ++k) {
+                size_t i = expected[k];
+                double v = static_cast<double>(i);
+                if (imuData.timeStamp[k] != imuRecordTime(records[i]) || imuData.gx[k] != v * anglfak ||
+                    imuData.gy[k] != v * anglfak || imuData.gz[k] != v * anglfak ||
+                    imuData.accx[k] != v * accelfak || imuData.accy[k] != v * accelfak ||
+                    imuData.accz[k] != static_cast<double>(oneG + static_cast<int32_t>(i)) * accelfak) {
+                    std::cerr << "loadImuData: sample " << k << " does not come from record " << i << std::endl;
+                    ++failures;
+                }
+            }
+        }
+
+        // removeDuplicateTimestamps on data that still has duplicates
+        ImuData raw;
+        for (size_t i = 0; i < records.size(); ++i) {
+            double v = static_cast<double>(i);
+            raw.timeStamp.push_back(imuRecordTime(records[i]));
+            raw.accx.push_back(v);
+            raw.accy.push_back(v);
+            raw.accz.push_back(v);
+            raw.gx.push_back(v);
+            raw.gy.push_back(v);
+            raw.gz.push_back(v);
+        }
+        removeDuplicateTimestamps(raw);
+        if (raw.timeStamp.size() != expected.size() || raw.gz.size() != expected.size()) {
+            std::cerr << "removeDuplicateTimestamps: wrong number of samples" << std::endl;
+            ++failures;
+        } else {
+            for (size_t k = 0; k < expected.size(); ++k) {
+                double v = static_cast<double>(expected[k]);
+                if (raw.accx[k] != v || raw.accy[k] != v || raw.accz[k] != v || raw.gx[k] != v ||
+                    raw.gy[k] != v || raw.gz[k] != v) {
+                    std::cerr << "removeDuplicateTimestamps: channels misaligned at " << k << std::endl;
+                    ++failures;
+                }
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        ++failures;
+    }
+
+    std::remove(fileName.c_str());
+    if (failures) {
+        return 1;
+    }
+    std::cout << "Duplicate timestamps removed consistently." << std::endl;
+    return 0;
+}
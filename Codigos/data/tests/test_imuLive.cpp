@@ -0,0 +1,269 @@
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+#include "imuLive.hpp"
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+double steadySeconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Registro estático do modelo 16495 com o instante de escrita como timestamp
+ImuRecord makeRecord(uint64_t ns, int i) {
+    ImuRecord r;
+    r.timeLow = static_cast<uint32_t>(ns);
+    r.timeHigh = static_cast<uint32_t>(ns >> 32);
+    r.gx = 1000 * (i % 7);
+    r.gy = -500 * (i % 5);
+    r.gz = 250;
+    r.accx = 1000 * (i % 3);
+    r.accy = -2000;
+    r.accz = static_cast<int32_t>(65536 / 2.5e-4);
+    return r;
+}
+
+// Escreve numSamples registros a 2 kHz; alguns são divididos em duas escritas
+// e alguns repetem o timestamp anterior
+template <typename Write>
+void writeLive(size_t numSamples, Write write) {
+    auto period = std::chrono::microseconds(500);
+    auto next = std::chrono::steady_clock::now();
+    uint64_t lastNs = 0;
+    for (size_t i = 0; i < numSamples; ++i) {
+        std::this_thread::sleep_until(next);
+        next += period;
+        uint64_t ns = static_cast<uint64_t>(steadySeconds() * 1e9);
+        if (i % 50 == 49) {
+            ns = lastNs;
+        }
+        lastNs = ns;
+        ImuRecord r = makeRecord(ns, static_cast<int>(i));
+        const char *bytes = reinterpret_cast<const char*>(&r);
+        if (i % 7 == 3) {
+            write(bytes, 13);
+            write(bytes + 13, sizeof(r) - 13);
+        } else {
+            write(bytes, sizeof(r));
+        }
+    }
+}
+
+// Consome até o fim do fluxo (ou expected amostras) e mede a latência de cada amostra
+size_t consume(ImuLiveReader &reader, size_t expected, std::vector<ImuSample> &samples, std::vector<double> &latency) {
+    ImuSample s;
+    while (samples.size() < expected) {
+        if (!reader.pop(s, std::chrono::seconds(2))) {
+            break;
+        }
+        latency.push_back(steadySeconds() - s.timeStamp);
+        samples.push_back(s);
+    }
+    return samples.size();
+}
+
+// Limite de p99: 1 ms a 2 kHz; IMU_LIVE_MAX_P99_US (em microssegundos) pode afrouxá-lo em CI sobrecarregada
+double latencyLimit() {
+    const char *limit = std::getenv("IMU_LIVE_MAX_P99_US");
+    return limit ? std::max(std::atof(limit) * 1e-6, 1e-3) : 1e-3;
+}
+
+bool checkLatency(const char *name, std::vector<double> latency) {
+    if (latency.empty()) {
+        std::cerr << name << ": no samples." << std::endl;
+        return false;
+    }
+    std::sort(latency.begin(), latency.end());
+    double median = latency[latency.size() / 2];
+    double p99 = latency[latency.size() * 99 / 100];
+    std::cout << name << ": " << latency.size() << " samples, latency median " << median * 1e6
+              << " us, p99 " << p99 * 1e6 << " us, max " << latency.back() * 1e6 << " us" << std::endl;
+    double limit = latencyLimit();
+    if (p99 > limit) {
+        std::cerr << name << ": p99 latency above " << limit * 1e6 << " us." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool sameSamples(const std::vector<ImuSample> &samples, const ImuData &data) {
+    if (samples.size() != data.timeStamp.size()) {
+        std::cerr << "Live reader gave " << samples.size() << " samples, loadImuData " << data.timeStamp.size() << std::endl;
+        return false;
+    }
+    for (size_t i = 0; i < samples.size(); ++i) {
+        const ImuSample &s = samples[i];
+        if (s.timeStamp != data.timeStamp[i] || s.accx != data.accx[i] || s.accy != data.accy[i] ||
+            s.accz != data.accz[i] || s.gx != data.gx[i] || s.gy != data.gy[i] || s.gz != data.gz[i]) {
+            std::cerr << "Sample " << i << " differs from loadImuData." << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    const size_t numSamples = 4000;
+    const size_t numUnique = numSamples - numSamples / 50;
+    const std::string fileName = "test_imu_live.bin";
+    bool ok = true;
+    try {
+        // Arquivo em crescimento
+        std::remove(fileName.c_str());
+        FILE *out = std::fopen(fileName.c_str(), "wb");
+        if (!out) {
+            throw std::runtime_error("Unable to create " + fileName);
+        }
+        {
+            ImuLiveReader reader(fileName);
+            std::thread writer([&]() {
+                writeLive(numSamples, [&](const char *bytes, size_t size) {
+                    std::fwrite(bytes, 1, size, out);
+                    std::fflush(out);
+                });
+            });
+            std::vector<ImuSample> samples;
+            std::vector<double> latency;
+            consume(reader, numUnique, samples, latency);
+            writer.join();
+            std::fclose(out);
+            // O último registro é uma duplicata, que não gera amostra
+            for (int i = 0; i < 1000 && reader.numRecords() < numSamples; ++i) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            reader.stop();
+
+            ok = checkLatency("file", latency) && ok;
+            if (reader.imuModel() != 16495 || reader.numDuplicates() != numSamples / 50 || !reader.error().empty()) {
+                std::cerr << "Unexpected reader state: model " << reader.imuModel() << ", duplicates "
+                          << reader.numDuplicates() << ", error '" << reader.error() << "'" << std::endl;
+                ok = false;
+            }
+            int imuModel = 0;
+            ImuData data = loadImuData(fileName, imuModel, false, CacheMode::Off);
+            ok = sameSamples(samples, data) && ok;
+        }
+
+        // Sem follow, um arquivo pronto é lido até o fim
+        {
+            ImuLiveOptions options;
+            options.follow = false;
+            options.ringCapacity = 64; // força o leitor a esperar pelo consumidor
+            ImuLiveReader reader(fileName, 16495, options);
+            std::vector<ImuSample> samples;
+            std::vector<double> latency;
+            consume(reader, numSamples, samples, latency);
+            if (!reader.finished() || samples.size() != numUnique) {
+                std::cerr << "Replay gave " << samples.size() << " samples." << std::endl;
+                ok = false;
+            }
+        }
+
+        // Registro truncado no fim
+        {
+            FILE *truncated = std::fopen(fileName.c_str(), "ab");
+            std::fputc(0, truncated);
+            std::fclose(truncated);
+            ImuLiveOptions options;
+            options.follow = false;
+            ImuLiveReader reader(fileName, 0, options);
+            std::vector<ImuSample> samples;
+            std::vector<double> latency;
+            consume(reader, numSamples, samples, latency);
+            if (reader.error().empty()) {
+                std::cerr << "Truncated stream was not reported." << std::endl;
+                ok = false;
+            }
+        }
+        std::remove(fileName.c_str());
+
+#ifndef _WIN32
+        // FIFO: termina quando o escritor fecha
+        const std::string fifoName = "test_imu_live.fifo";
+        std::remove(fifoName.c_str());
+        if (mkfifo(fifoName.c_str(), 0600) != 0) {
+            throw std::runtime_error("Unable to create " + fifoName);
+        }
+        {
+            ImuLiveReader reader(fifoName);
+            std::thread writer([&]() {
+                FILE *pipe = std::fopen(fifoName.c_str(), "wb");
+                writeLive(numSamples, [&](const char *bytes, size_t size) {
+                    std::fwrite(bytes, 1, size, pipe);
+                    std::fflush(pipe);
+                });
+                std::fclose(pipe);
+            });
+            std::vector<ImuSample> samples;
+            std::vector<double> latency;
+            consume(reader, numSamples, samples, latency);
+            writer.join();
+            ok = checkLatency("fifo", latency) && ok;
+            if (samples.size() != numUnique || !reader.finished()) {
+                std::cerr << "FIFO gave " << samples.size() << " samples." << std::endl;
+                ok = false;
+            }
+        }
+        std::remove(fifoName.c_str());
+
+        // Socket Unix: o escritor escuta e o leitor conecta
+        const std::string socketName = "test_imu_live.sock";
+        std::remove(socketName.c_str());
+        int server = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::strcpy(address.sun_path, socketName.c_str());
+        if (server < 0 || bind(server, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            listen(server, 1) != 0) {
+            throw std::runtime_error("Unable to listen on " + socketName);
+        }
+        {
+            ImuLiveReader reader(socketName);
+            std::thread writer([&]() {
+                int client = accept(server, nullptr, nullptr);
+                writeLive(numSamples, [&](const char *bytes, size_t size) {
+                    if (write(client, bytes, size) != static_cast<ssize_t>(size)) {
+                        std::cerr << "Socket write failed." << std::endl;
+                    }
+                });
+                close(client);
+            });
+            std::vector<ImuSample> samples;
+            std::vector<double> latency;
+            consume(reader, numSamples, samples, latency);
+            writer.join();
+            ok = checkLatency("socket", latency) && ok;
+            if (samples.size() != numUnique || !reader.finished()) {
+                std::cerr << "Socket gave " << samples.size() << " samples." << std::endl;
+                ok = false;
+            }
+        }
+        close(server);
+        std::remove(socketName.c_str());
+#endif
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (!ok) {
+        return 1;
+    }
+    std::cout << "Live ingest test passed." << std::endl;
+    return 0;
+}
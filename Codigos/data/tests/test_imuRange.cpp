@@ -0,0 +1,141 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cstdio>
+#include <cmath>
+#include <stdexcept>
+#include "imuRange.hpp"
+#include "syntheticData.hpp"
+
+namespace {
+
+// Amostras de loadImuData dentro da janela, para comparação
+ImuData filterWindow(const ImuData& imuData, double t0, double t1) {
+    ImuData window;
+    for (size_t i = 0; i < imuData.timeStamp.size(); ++i) {
+        double t = imuData.timeStamp[i];
+        if (t >= t0 && t <= t1) {
+            window.timeStamp.push_back(t);
+            window.accx.push_back(imuData.accx[i]);
+            window.accy.push_back(imuData.accy[i]);
+            window.accz.push_back(imuData.accz[i]);
+            window.gx.push_back(imuData.gx[i]);
+            window.gy.push_back(imuData.gy[i]);
+            window.gz.push_back(imuData.gz[i]);
+        }
+    }
+    return window;
+}
+
+bool sameData(const ImuData& a, const ImuData& b) {
+    return a.timeStamp == b.timeStamp && a.accx == b.accx && a.accy == b.accy && a.accz == b.accz &&
+           a.gx == b.gx && a.gy == b.gy && a.gz == b.gz;
+}
+
+// Sobrescreve o timestamp de um registro do arquivo
+void setTimestamp(const std::string& fileName, size_t record, uint64_t ns) {
+    std::fstream file(fileName, std::ios::in | std::ios::out | std::ios::binary);
+    uint32_t words[2] = {static_cast<uint32_t>(ns), static_cast<uint32_t>(ns >> 32)};
+    file.seekp(static_cast<std::streamoff>(record * sizeof(ImuRecord)));
+    file.write(reinterpret_cast<const char*>(words), sizeof(words));
+}
+
+uint64_t getTimestamp(const std::string& fileName, size_t record) {
+    std::ifstream file(fileName, std::ios::binary);
+    ImuRecord r;
+    file.seekg(static_cast<std::streamoff>(record * sizeof(ImuRecord)));
+    file.read(reinterpret_cast<char*>(&r), sizeof(r));
+    return imuRecordNanoseconds(r);
+}
+
+// Compara loadImuRange com a carga completa em várias janelas
+bool checkWindows(const std::string& fileName, const ImuTimeIndex* index) {
+    int model = 0;
+    ImuData full = loadImuData(fileName, model, false, CacheMode::Off);
+    double start = full.timeStamp.front();
+    double span = full.timeStamp.back() - start;
+    for (int k = 0; k <= 40; ++k) {
+        double t0 = start + span * (k * 0.0251) - 1e-3;
+        double t1 = t0 + span * 0.013 * (k % 7);
+        int rangeModel = 0;
+        ImuData window = loadImuRange(fileName, t0, t1, rangeModel, index);
+        if (rangeModel != model || !sameData(window, filterWindow(full, t0, t1))) {
+            std::cerr << "Window " << k << " [" << t0 << ", " << t1 << "] does not match ("
+                      << window.timeStamp.size() << " samples)." << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    const std::string fileName = "test_imuRange.bin";
+    try {
+        const size_t numSamples = 300000;
+        writeSyntheticImuLog(fileName, numSamples);
+
+        // O log padrão tem lacunas de 20 intervalos a cada 100000 amostras (as repetições o carregador descarta)
+        int fullModel = 0;
+        ImuData generated = loadImuData(fileName, fullModel, false, CacheMode::Off);
+        size_t gaps = 0;
+        for (size_t i = 1; i < generated.timeStamp.size(); ++i) {
+            double interval = generated.timeStamp[i] - generated.timeStamp[i - 1];
+            gaps += std::abs(interval - 20.0 / 2000.0) < 1e-6;
+        }
+        if (gaps != 2) {
+            std::cerr << "Synthetic log has " << gaps << " gaps instead of 2." << std::endl;
+            std::remove(fileName.c_str());
+            return 1;
+        }
+
+        // Timestamps isolados fora de ordem: zero e um valor muito à frente
+        setTimestamp(fileName, 1234, 0);
+        setTimestamp(fileName, 150000, getTimestamp(fileName, 150000) + 3600000000000ULL);
+        setTimestamp(fileName, 200001, getTimestamp(fileName, 199000));
+
+        ImuTimeIndex index(fileName, 1000);
+        if (!checkWindows(fileName, nullptr) || !checkWindows(fileName, &index)) {
+            std::remove(fileName.c_str());
+            return 1;
+        }
+
+        // Um trecho longo repetido: só o índice garante o resultado
+        for (size_t i = 0; i < 5000; ++i) {
+            setTimestamp(fileName, 100000 + i, getTimestamp(fileName, 60000 + i));
+        }
+        ImuTimeIndex replayIndex(fileName);
+        if (!checkWindows(fileName, &replayIndex)) {
+            std::remove(fileName.c_str());
+            return 1;
+        }
+
+        // Janela fora do arquivo e índice de outro arquivo
+        int model = 0;
+        if (!loadImuRange(fileName, 1.0, 2.0, model).timeStamp.empty()) {
+            std::cerr << "Window before the log is not empty." << std::endl;
+            return 1;
+        }
+        std::vector<ImuRecord> otherRecords(10, ImuRecord());
+        ImuTimeIndex other(otherRecords.data(), otherRecords.size());
+        bool rejected = false;
+        try {
+            loadImuRange(fileName, 0.0, 1.0, model, &other);
+        } catch (const std::invalid_argument&) {
+            rejected = true;
+        }
+        if (!rejected) {
+            std::cerr << "Index of another file was accepted." << std::endl;
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        std::remove(fileName.c_str());
+        return 1;
+    }
+    std::remove(fileName.c_str());
+
+    std::cout << "IMU range queries match the full load." << std::endl;
+    return 0;
+}
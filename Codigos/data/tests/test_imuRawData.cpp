@@ -0,0 +1,54 @@
+#include <iostream>
+#include <stdexcept>
+#include "imuRawData.hpp"
+
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " <filename.bin>" << std::endl;
+        return 1;
+    }
+
+    try {
+        int model = 0;
+        ImuData imuData = loadImuData(argv[1], model, false, CacheMode::Off);
+        int rawModel = 0;
+        ImuRawData raw = loadImuRawData(argv[1], rawModel);
+
+        // A conversão completa deve reproduzir loadImuData
+        ImuData scaled = raw.toImuData();
+        if (rawModel != model || scaled.timeStamp != imuData.timeStamp || scaled.accx != imuData.accx ||
+            scaled.accy != imuData.accy || scaled.accz != imuData.accz || scaled.gx != imuData.gx ||
+            scaled.gy != imuData.gy || scaled.gz != imuData.gz) {
+            std::cerr << "Scaled raw data does not match loadImuData." << std::endl;
+            return 1;
+        }
+
+        // Acessores amostra a amostra
+        for (size_t i = 0; i < raw.size(); i += 997) {
+            if (raw.timeStamp(i) != imuData.timeStamp[i] || raw.value(ImuChannel::AccZ, i) != imuData.accz[i] ||
+                raw.value(ImuChannel::Gx, i) != imuData.gx[i]) {
+                std::cerr << "Sample " << i << " does not match." << std::endl;
+                return 1;
+            }
+        }
+
+        // Trecho parcial
+        size_t first = raw.size() / 3;
+        size_t last = first + raw.size() / 4;
+        ImuData part = raw.toImuData(first, last);
+        if (part.timeStamp.size() != last - first || part.gy[0] != imuData.gy[first] ||
+            part.accy.back() != imuData.accy[last - 1]) {
+            std::cerr << "Partial conversion does not match." << std::endl;
+            return 1;
+        }
+
+        size_t rawBytes = sizeof(uint64_t) + 6 * sizeof(int32_t);
+        std::cout << "Bytes per sample: " << rawBytes << " (ImuData: " << 7 * sizeof(double) << ")\n";
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Raw IMU data matches loadImuData." << std::endl;
+    return 0;
+}
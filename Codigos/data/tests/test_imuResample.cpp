@@ -0,0 +1,210 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include "imuResample.hpp"
+
+namespace {
+
+// IMU a rate Hz desde t0, com accx = a + b t + c t^2, gx constante por amostra e uma lacuna opcional
+ImuData makeImu(double t0, double rate, size_t numSamples, double a, double b, double c, size_t gapAt = 0,
+                size_t gapSamples = 0) {
+    ImuData imu;
+    for (size_t i = 0; i < numSamples; ++i) {
+        size_t tick = i + (gapAt && i >= gapAt ? gapSamples : 0);
+        double t = t0 + tick / rate;
+        imu.timeStamp.push_back(t);
+        double u = t - t0;
+        imu.accx.push_back(a + b * u + c * u * u);
+        imu.accy.push_back(std::sin(3.0 * u));
+        imu.accz.push_back(-1.0);
+        imu.gx.push_back(static_cast<double>(i % 7) - 3.0);
+        imu.gy.push_back(0.5 * std::cos(u));
+        imu.gz.push_back(0.0);
+    }
+    return imu;
+}
+
+double maxError(const std::vector<double>& values, const std::vector<uint8_t>& flags,
+                const std::vector<double>& expected) {
+    double error = 0.0;
+    for (size_t k = 0; k < values.size(); ++k) {
+        if (flags[k] == resampleOk) {
+            error = std::max(error, std::abs(values[k] - expected[k]));
+        }
+    }
+    return error;
+}
+
+bool sameValues(const std::vector<double>& a, const std::vector<double>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t k = 0; k < a.size(); ++k) {
+        if (!(a[k] == b[k] || (std::isnan(a[k]) && std::isnan(b[k])))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    const double t0 = 1000.0, rate = 100.0;
+    ImuData imu = makeImu(t0, rate, 1000, 0.3, 0.7, 0.0);
+
+    // Alvos fora das amostras, e fora dos dados nas pontas
+    std::vector<double> targets = uniformTimes(t0 - 0.0137, t0 + 10.05, 0.0173);
+    std::vector<double> line(targets.size()), quadratic(targets.size());
+    for (size_t k = 0; k < targets.size(); ++k) {
+        double u = targets[k] - t0;
+        line[k] = 0.3 + 0.7 * u;
+        quadratic[k] = 0.3 + 0.7 * u - 0.2 * u * u;
+    }
+
+    // Linear e cúbico reproduzem uma reta; o cúbico também uma parábola em amostras uniformes
+    ResampleOptions options;
+    ResampledImu linear = resampleImu(imu, targets, options);
+    options.mode = ResampleMode::Cubic;
+    ResampledImu cubic = resampleImu(imu, targets, options);
+    ImuData curved = makeImu(t0, rate, 1000, 0.3, 0.7, -0.2);
+    ResampledImu cubicCurved = resampleImu(curved, targets, options);
+    double linearError = maxError(linear.data.accx, linear.flags, line);
+    double cubicError = maxError(cubic.data.accx, cubic.flags, line);
+    // Nos intervalos das pontas a inclinação é a secante
+    std::vector<uint8_t> interior = cubicCurved.flags;
+    for (size_t k = 0; k < targets.size(); ++k) {
+        if (targets[k] < curved.timeStamp[1] || targets[k] > curved.timeStamp[998]) {
+            interior[k] = resampleOutside;
+        }
+    }
+    double curvedError = maxError(cubicCurved.data.accx, interior, quadratic);
+    std::cout << "Line: linear error " << linearError << ", cubic error " << cubicError << "; parabola: cubic error "
+              << curvedError << std::endl;
+    if (linearError > 1e-12 || cubicError > 1e-12 || curvedError > 1e-11) {
+        std::cerr << "Interpolation is not exact." << std::endl;
+        ok = false;
+    }
+    size_t expectedOutside = 1 + static_cast<size_t>(std::count_if(targets.begin(), targets.end(), [&](double t) {
+                                     return t > imu.timeStamp.back();
+                                 }));
+    if (linear.numFlagged != expectedOutside || linear.flags[0] != resampleOutside ||
+        !std::isnan(linear.data.accx[0]) || linear.flags[1] != resampleOk || cubic.numFlagged != expectedOutside) {
+        std::cerr << "Targets outside the data not flagged." << std::endl;
+        ok = false;
+    }
+
+    // Integrar e despejar a 10 Hz sobre 100 Hz é a média dos 10 valores de cada janela
+    options.mode = ResampleMode::IntegrateAndDump;
+    std::vector<double> grid = uniformTimes(imu.timeStamp[0], imu.timeStamp.back(), 0.1);
+    ResampledImu dumped = resampleImu(imu, grid, options);
+    double dumpError = 0.0;
+    for (size_t k = 1; k < grid.size(); ++k) {
+        double sum = 0.0;
+        for (size_t i = 10 * (k - 1) + 1; i <= 10 * k; ++i) {
+            sum += imu.gx[i];
+        }
+        dumpError = std::max(dumpError, std::abs(dumped.data.gx[k] - sum / 10.0));
+    }
+    // Janelas fora das amostras: integral exata do sinal constante por partes
+    std::vector<double> odd = {t0 + 0.0031, t0 + 0.1234, t0 + 0.1299, t0 + 0.5077};
+    ResampledImu oddDumped = resampleImu(imu, odd, options);
+    for (size_t k = 1; k < odd.size(); ++k) {
+        double integral = 0.0;
+        for (size_t i = 1; i < imu.timeStamp.size(); ++i) {
+            double lo = std::max(imu.timeStamp[i - 1], odd[k - 1]), hi = std::min(imu.timeStamp[i], odd[k]);
+            if (hi > lo) {
+                integral += imu.gx[i] * (hi - lo);
+            }
+        }
+        dumpError = std::max(dumpError, std::abs(oddDumped.data.gx[k] - integral / (odd[k] - odd[k - 1])));
+    }
+    std::cout << "Integrate-and-dump error " << dumpError << std::endl;
+    if (dumpError > 1e-11 || dumped.flags[0] != resampleOutside || dumped.numFlagged != 1) {
+        std::cerr << "Integrate-and-dump is wrong." << std::endl;
+        ok = false;
+    }
+
+    // Lacuna de 0,5 s depois da amostra 300: nada é interpolado através dela
+    ImuData gappy = makeImu(t0, rate, 1000, 0.3, 0.7, 0.0, 300, 50);
+    double gapStart = gappy.timeStamp[299], gapEnd = gappy.timeStamp[300];
+    for (ResampleMode mode : {ResampleMode::Linear, ResampleMode::Cubic, ResampleMode::IntegrateAndDump}) {
+        options.mode = mode;
+        ResampledImu r = resampleImu(gappy, grid, options);
+        for (size_t k = 1; k < grid.size(); ++k) {
+            double windowStart = mode == ResampleMode::IntegrateAndDump ? grid[k - 1] : grid[k];
+            bool inGap = grid[k] > gapStart && windowStart < gapEnd;
+            if (grid[k] > gappy.timeStamp.back()) {
+                continue;
+            }
+            if (inGap != (r.flags[k] == resampleGap) || inGap != std::isnan(r.data.accx[k])) {
+                std::cerr << "Gap flag wrong at " << grid[k] - t0 << " s in mode " << static_cast<int>(mode)
+                          << std::endl;
+                ok = false;
+                break;
+            }
+        }
+    }
+    // Perto da lacuna o cúbico usa a secante: continua exato para uma reta
+    options.mode = ResampleMode::Cubic;
+    std::vector<double> nearGap = {gapStart - 0.005, gapEnd + 0.005};
+    ResampledImu edge = resampleImu(gappy, nearGap, options);
+    if (std::abs(edge.data.accx[0] - (0.3 + 0.7 * (nearGap[0] - t0))) > 1e-12 ||
+        std::abs(edge.data.accx[1] - (0.3 + 0.7 * (nearGap[1] - t0))) > 1e-12) {
+        std::cerr << "Cubic interpolation next to the gap is wrong." << std::endl;
+        ok = false;
+    }
+
+    // Alvos decrescentes são rejeitados
+    try {
+        resampleImu(imu, std::vector<double>{t0 + 1.0, t0 + 0.5}, options);
+        std::cerr << "Decreasing targets accepted." << std::endl;
+        ok = false;
+    } catch (const std::invalid_argument&) {
+    }
+
+    // Todos os conjuntos de instruções dão o mesmo resultado; dez minutos a 2 kHz para GNSS a 5 Hz e para 100 Hz
+    ImuData session = makeImu(0.0, 2000.0, 600 * 2000, 0.1, 0.0, 0.0, 500000, 40);
+    GnssData gnss;
+    for (size_t k = 0; k < 5 * 600; ++k) {
+        gnss.time.push_back(k * 0.2 + 0.0123 - 18.0);
+    }
+    std::vector<double> grid100 = uniformTimes(0.0, 600.0, 0.01);
+    for (ResampleMode mode : {ResampleMode::Linear, ResampleMode::Cubic, ResampleMode::IntegrateAndDump}) {
+        options.mode = mode;
+        options.timeOffset = 18.0;
+        options.level = SimdLevel::Scalar;
+        ResampledImu reference = resampleImu(session, gnss, options);
+        for (SimdLevel level : {SimdLevel::Sse2, SimdLevel::Avx2}) {
+            if (static_cast<int>(level) > static_cast<int>(detectSimdLevel())) {
+                continue;
+            }
+            options.level = level;
+            auto start = std::chrono::steady_clock::now();
+            ResampledImu r = resampleImu(session, gnss, options);
+            double gnssSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            options.timeOffset = 0.0;
+            start = std::chrono::steady_clock::now();
+            ResampledImu uniform = resampleImu(session, grid100, options);
+            double gridSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            options.timeOffset = 18.0;
+            std::cout << "Mode " << static_cast<int>(mode) << (level == SimdLevel::Avx2 ? " AVX2" : " SSE2")
+                      << ": 10 min at 2 kHz to 5 Hz in " << gnssSeconds << " s, to 100 Hz in " << gridSeconds
+                      << " s; " << uniform.numFlagged << " targets flagged" << std::endl;
+            if (!sameValues(r.data.accx, reference.data.accx) || !sameValues(r.data.gy, reference.data.gy) ||
+                r.flags != reference.flags) {
+                std::cerr << "SIMD result differs from the scalar one." << std::endl;
+                ok = false;
+            }
+        }
+    }
+
+    if (!ok) {
+        return 1;
+    }
+    std::cout << "IMU resampling test passed." << std::endl;
+    return 0;
+}
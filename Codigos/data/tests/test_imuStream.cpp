@@ -0,0 +1,50 @@
+#include <iostream>
+#include <stdexcept>
+#include "imuData.hpp"
+#include "imuStream.hpp"
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: " << argv[0] << " <filename.bin> [batchSize]" << std::endl;
+        return 1;
+    }
+
+    std::string inputFileName = argv[1];
+    size_t batchSize = argc == 3 ? std::stoul(argv[2]) : 4096;
+
+    try {
+        int model = 0;
+        ImuData imuData = loadImuData(inputFileName, model, false);
+
+        ImuStreamReader reader(inputFileName, 0, batchSize);
+        ImuData batch;
+        size_t numBatches = 0, index = 0, mismatches = 0;
+        while (reader.next(batch)) {
+            ++numBatches;
+            for (size_t i = 0; i < batch.timeStamp.size(); ++i, ++index) {
+                if (index >= imuData.timeStamp.size() ||
+                    batch.timeStamp[i] != imuData.timeStamp[index] ||
+                    batch.accx[i] != imuData.accx[index] || batch.accy[i] != imuData.accy[index] ||
+                    batch.accz[i] != imuData.accz[index] || batch.gx[i] != imuData.gx[index] ||
+                    batch.gy[i] != imuData.gy[index] || batch.gz[i] != imuData.gz[index]) {
+                    ++mismatches;
+                }
+            }
+        }
+
+        std::cout << "Model: " << reader.imuModel() << " (bulk: " << model << ")\n";
+        std::cout << "Batches: " << numBatches << ", samples: " << index
+                  << " (bulk: " << imuData.timeStamp.size() << ")\n";
+        std::cout << "Mismatches: " << mismatches << std::endl;
+
+        if (reader.imuModel() != model || index != imuData.timeStamp.size() || mismatches != 0) {
+            std::cerr << "Streaming reader does not match loadImuData." << std::endl;
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
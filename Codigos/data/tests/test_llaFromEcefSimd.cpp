@@ -0,0 +1,71 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <iomanip>
+#include <algorithm>
+#include "llaFromEcefSimd.hpp"
+
+int main(int argc, char* argv[]) {
+    size_t nPoints = argc > 1 ? std::stoul(argv[1]) : 1000003;
+
+    // Pontos aleatórios em todo o globo, de -1 km a 1000 km de altitude
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> latDist(-90.0, 90.0), lonDist(-180.0, 180.0), altDist(-1e3, 1e6);
+    const double a = 6.378137e6;
+    const double e2 = 0.0818191908425 * 0.0818191908425;
+    std::vector<double> x(nPoints), y(nPoints), z(nPoints);
+    for (size_t j = 0; j < nPoints; ++j) {
+        double lat = latDist(rng) * M_PI / 180.0, lon = lonDist(rng) * M_PI / 180.0, h = altDist(rng);
+        double N = a / std::sqrt(1 - e2 * std::sin(lat) * std::sin(lat));
+        x[j] = (N + h) * std::cos(lat) * std::cos(lon);
+        y[j] = (N + h) * std::cos(lat) * std::sin(lon);
+        z[j] = (N * (1 - e2) + h) * std::sin(lat);
+    }
+
+    std::vector<double> latRef, lonRef, altRef;
+    llaFromEcef(x, y, z, latRef, lonRef, altRef);
+
+    std::vector<double> lat(nPoints), lon(nPoints), alt(nPoints);
+    std::vector<double> latSse(nPoints), lonSse(nPoints), altSse(nPoints);
+    bool ok = true;
+    for (SimdLevel level : {SimdLevel::Sse2, SimdLevel::Avx2}) {
+        if (static_cast<int>(level) > static_cast<int>(detectSimdLevel())) {
+            std::cout << "Skipping unsupported SIMD level " << static_cast<int>(level) << "\n";
+            continue;
+        }
+        llaFromEcefBatch(x.data(), y.data(), z.data(), lat.data(), lon.data(), alt.data(), nPoints, level);
+
+        double maxLat = 0, maxLon = 0, maxAlt = 0;
+        for (size_t j = 0; j < nPoints; ++j) {
+            maxLat = std::max(maxLat, std::abs(lat[j] - latRef[j]));
+            double dLon = std::abs(lon[j] - lonRef[j]);
+            maxLon = std::max(maxLon, std::min(dLon, 360.0 - dLon));
+            maxAlt = std::max(maxAlt, std::abs(alt[j] - altRef[j]));
+        }
+
+        std::cout << std::scientific << std::setprecision(3);
+        std::cout << (level == SimdLevel::Avx2 ? "AVX2" : "SSE2") << ": max error lat " << maxLat
+                  << " deg, lon " << maxLon << " deg, alt " << maxAlt << " m\n";
+        if (maxLat > 1e-11 || maxLon > 1e-11 || maxAlt > 1e-4) {
+            ok = false;
+        }
+
+        // Os dois caminhos devem dar o mesmo resultado
+        if (level == SimdLevel::Sse2) {
+            latSse = lat;
+            lonSse = lon;
+            altSse = alt;
+        } else if (lat != latSse || lon != lonSse || alt != altSse) {
+            std::cout << "AVX2 and SSE2 results differ.\n";
+            ok = false;
+        }
+    }
+
+    if (!ok) {
+        std::cerr << "SIMD llaFromEcef exceeds the tolerance." << std::endl;
+        return 1;
+    }
+    std::cout << "SIMD llaFromEcef matches the scalar reference." << std::endl;
+    return 0;
+}
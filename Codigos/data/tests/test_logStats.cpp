@@ -0,0 +1,146 @@
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "imuData.hpp"
+#include "imuStream.hpp"
+#include "logStats.hpp"
+
+namespace {
+
+// Frequência e gaps calculados como o getLogStream original: nth_element e contagem direta
+std::string referenceLog(const std::vector<double>& timeStamp) {
+    std::vector<double> diffTime;
+    for (size_t i = 1; i < timeStamp.size(); ++i) {
+        diffTime.push_back(timeStamp[i] - timeStamp[i - 1]);
+    }
+    std::nth_element(diffTime.begin(), diffTime.begin() + diffTime.size() / 2, diffTime.end());
+    double median = diffTime[diffTime.size() / 2];
+    long gaps = std::count_if(diffTime.begin(), diffTime.end(), [median](double dt) {
+        return std::abs(dt - median) > median * 0.1;
+    });
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2) << "IMU Freq: " << 1.0 / median << " Hz\nIMU Gaps: " << gaps << " (";
+    return oss.str();
+}
+
+// Gaps por comprimento contados direto, com a mediana de nth_element
+std::vector<uint64_t> referenceGapHistogram(const std::vector<double>& timeStamp) {
+    std::vector<double> diffTime;
+    for (size_t i = 1; i < timeStamp.size(); ++i) {
+        diffTime.push_back(timeStamp[i] - timeStamp[i - 1]);
+    }
+    std::vector<double> sorted = diffTime;
+    std::nth_element(sorted.begin(), sorted.begin() + sorted.size() / 2, sorted.end());
+    double median = sorted[sorted.size() / 2];
+    const std::vector<double>& edges = gapHistogramEdges();
+    std::vector<uint64_t> counts(edges.size() + 1, 0);
+    for (double dt : diffTime) {
+        if (std::abs(dt - median) > median * 0.1) {
+            size_t k = dt < median ? 0 : 1;
+            while (dt >= median && k < edges.size() && dt >= edges[k] * median) {
+                ++k;
+            }
+            ++counts[k];
+        }
+    }
+    return counts;
+}
+
+// Com jitter nos instantes e intervalos perto do limite de 10%, o texto é o mesmo do cálculo direto
+bool matchesExactStatistics() {
+    for (unsigned seed = 0; seed < 20; ++seed) {
+        std::mt19937_64 rng(seed);
+        std::normal_distribution<double> jitter(0.0, 2.5e-7); // 0,05% do intervalo
+        std::uniform_real_distribution<double> nearEdge(0.895, 0.905);
+        ImuData imuData;
+        double t = 1000.0;
+        for (size_t i = 0; i < 200000; ++i) {
+            // Um intervalo a cada mil fica perto de 0,9 ou 1,1 medianas
+            double interval = 0.0005 * (i % 1000 == 999 ? nearEdge(rng) + (i % 2000 == 999 ? 0.2 : 0.0) : 1.0);
+            t += interval;
+            imuData.timeStamp.push_back(t + jitter(rng));
+            for (std::vector<double>* channel : {&imuData.accx, &imuData.accy, &imuData.accz, &imuData.gx,
+                                                 &imuData.gy, &imuData.gz}) {
+                channel->push_back(0.0);
+            }
+        }
+        std::string log = getLogStream(imuData, 1);
+        std::string expected = referenceLog(imuData.timeStamp);
+        if (log.find(expected) == std::string::npos) {
+            std::cerr << "Seed " << seed << ": log\n" << log << "differs from\n" << expected << std::endl;
+            return false;
+        }
+        // O histograma dos gaps do JSON soma o mesmo que os gaps
+        ImuStats stats = computeImuStats(imuData, 1, 4);
+        std::vector<uint64_t> counts = gapHistogram(stats.time);
+        uint64_t total = 0;
+        for (uint64_t count : counts) {
+            total += count;
+        }
+        if (counts != referenceGapHistogram(imuData.timeStamp) || total != stats.time.gaps()) {
+            std::cerr << "Seed " << seed << ": gap histogram differs from the exact one." << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (!matchesExactStatistics()) {
+        return 1;
+    }
+    std::cout << "Median interval and gaps match the exact computation." << std::endl;
+
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " <filename.bin>" << std::endl;
+        return 1;
+    }
+
+    try {
+        int model = 0;
+        ImuData imuData = loadImuData(argv[1], model, false);
+
+        ImuStats serial = computeImuStats(imuData, model, 1);
+        ImuStats parallel = computeImuStats(imuData, model, 4);
+
+        // Stats accumulated batch by batch while streaming
+        ImuStreamReader reader(argv[1], 0, 10000);
+        ImuData batch;
+        while (reader.next(batch)) {
+        }
+        const ImuStats& streamed = reader.stats();
+
+        std::cout << getLogStream(serial);
+        std::cout << serial.toJson() << std::endl;
+
+        // Merged partial statistics must give the same summary
+        std::string expected = getLogStream(serial);
+        if (getLogStream(parallel) != expected) {
+            std::cerr << "Merged statistics do not match the single-pass statistics." << std::endl;
+            return 1;
+        }
+        // Streaming only has the histogram: the median is within the width of a bin
+        if (streamed.time.samples != serial.time.samples ||
+            std::abs(streamed.time.medianInterval() / serial.time.medianInterval() - 1.0) > 0.006) {
+            std::cerr << "Streamed statistics do not match the exact statistics." << std::endl;
+            return 1;
+        }
+        if (parallel.accz.count != serial.accz.count || parallel.accz.min != serial.accz.min ||
+            parallel.accz.max != serial.accz.max || std::abs(parallel.accz.mean - serial.accz.mean) > 1e-12 ||
+            std::abs(parallel.accz.rms() - serial.accz.rms()) > 1e-12) {
+            std::cerr << "Merged channel statistics do not match." << std::endl;
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include "workStealingPool.hpp"
+
+namespace {
+
+// Pool e índice do worker da thread atual (nulo fora dos workers)
+thread_local const WorkStealingPool* currentPool = nullptr;
+thread_local unsigned currentWorker = 0;
+
+} // namespace
+
+WorkStealingPool::WorkStealingPool(unsigned numThreads) {
+    if (numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (unsigned i = 0; i < numThreads; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    workers_.reserve(numThreads);
+    for (unsigned i = 0; i < numThreads; ++i) {
+        workers_.emplace_back([this, i]() { run(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::unique_lock<std::mutex> lock(doneMutex_);
+        doneCondition_.wait(lock, [this]() { return unfinished_ == 0; });
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stop_ = true;
+    }
+    sleepCondition_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+void WorkStealingPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(doneMutex_);
+        ++unfinished_;
+    }
+    // Contada antes de entrar na fila: um worker pode tirá-la (e descontá-la) logo em seguida
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        ++queued_;
+    }
+    bool local = currentPool == this;
+    unsigned id = local ? currentWorker : nextQueue_++ % numThreads();
+    {
+        std::lock_guard<std::mutex> lock(queues_[id]->mutex);
+        (local ? queues_[id]->tasks : queues_[id]->external).push_back(std::move(task));
+    }
+    sleepCondition_.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(doneMutex_);
+    doneCondition_.wait(lock, [this]() { return unfinished_ == 0; });
+    if (error_) {
+        std::exception_ptr error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+bool WorkStealingPool::popLocal(unsigned id, std::function<void()>& task) {
+    Queue& queue = *queues_[id];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    // As próprias (LIFO) primeiro; as de fora na ordem em que chegaram
+    if (!queue.tasks.empty()) {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+    if (!queue.external.empty()) {
+        task = std::move(queue.external.front());
+        queue.external.pop_front();
+        return true;
+    }
+    return false;
+}
+
+bool WorkStealingPool::steal(unsigned id, std::function<void()>& task) {
+    // A partir do vizinho, para que os ladrões não disputem a mesma fila
+    for (unsigned k = 1; k < numThreads(); ++k) {
+        Queue& victim = *queues_[(id + k) % numThreads()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        std::deque<std::function<void()>>& tasks = victim.external.empty() ? victim.tasks : victim.external;
+        if (!tasks.empty()) {
+            task = std::move(tasks.front());
+            tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::finish() {
+    std::lock_guard<std::mutex> lock(doneMutex_);
+    if (--unfinished_ == 0) {
+        doneCondition_.notify_all();
+    }
+}
+
+void WorkStealingPool::run(unsigned id) {
+    currentPool = this;
+    currentWorker = id;
+    while (true) {
+        std::function<void()> task;
+        if (popLocal(id, task) || steal(id, task)) {
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex_);
+                --queued_;
+            }
+            try {
+                task();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(doneMutex_);
+                if (!error_) {
+                    error_ = std::current_exception();
+                }
+            }
+            finish();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        sleepCondition_.wait(lock, [this]() { return stop_ || queued_ > 0; });
+        if (stop_ && queued_ == 0) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,81 @@
+#ifndef WORK_STEALING_POOL_HPP
+#define WORK_STEALING_POOL_HPP
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+
+/**
+ * @brief Fixed set of worker threads with one task queue each.
+ *
+ * Tasks submitted from a worker go to its own queue and it runs the newest
+ * first, as in a recursive split. Tasks submitted from outside are dealt
+ * round-robin and each worker starts them in submission order, so a caller
+ * that submits the largest first gets them started first. A worker with
+ * nothing of its own steals from another worker, oldest outside task first.
+ */
+class WorkStealingPool {
+public:
+    /**
+     * @brief Starts the workers.
+     *
+     * @param numThreads Number of worker threads. If 0, all hardware threads are used.
+     */
+    explicit WorkStealingPool(unsigned numThreads = 0);
+
+    /**
+     * @brief Waits for the queued tasks and stops the workers.
+     */
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+     * @brief Queues a task.
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * @brief Blocks until every submitted task has finished. Must not be called from a task.
+     *
+     * @throws The first exception a task let escape since the last wait.
+     */
+    void wait();
+
+    unsigned numThreads() const { return static_cast<unsigned>(queues_.size()); } ///< Number of workers
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks; ///< Submitted by this worker (run newest first)
+        std::deque<std::function<void()>> external; ///< Submitted from outside (run oldest first)
+    };
+
+    void run(unsigned id);
+    bool popLocal(unsigned id, std::function<void()>& task);
+    bool steal(unsigned id, std::function<void()>& task);
+    void finish();
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<unsigned> nextQueue_{0};
+
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCondition_;
+    size_t queued_ = 0; ///< Tasks in the queues (guarded by sleepMutex_)
+    bool stop_ = false;
+
+    std::mutex doneMutex_;
+    std::condition_variable doneCondition_;
+    size_t unfinished_ = 0; ///< Tasks submitted and not finished (guarded by doneMutex_)
+    std::exception_ptr error_;
+};
+
+#endif // WORK_STEALING_POOL_HPP
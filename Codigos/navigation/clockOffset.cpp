@@ -0,0 +1,322 @@
+#include "clockOffset.hpp"
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "fft.hpp"
+#include "earthModel.hpp"
+#include "quaternion.hpp"
+#include "imuResample.hpp"
+#include "logStats.hpp"
+
+namespace {
+
+const double notAvailable = std::numeric_limits<double>::quiet_NaN();
+
+// Série em grade uniforme: values[i] no instante start + i * interval (NaN = sem valor)
+struct GridSeries {
+    double start = 0.0;
+    double interval = 0.0;
+    std::vector<double> values;
+};
+
+// Força específica da segunda diferença das posições GNSS com span épocas de distância
+GridSeries gnssSpecificForce(const GnssData& gnssData, double interval, size_t span) {
+    GridSeries series;
+    series.start = gnssData.time.front();
+    series.interval = interval;
+    size_t size = static_cast<size_t>(std::lround((gnssData.time.back() - series.start) / interval)) + 1;
+    series.values.assign(size, notAvailable);
+
+    // Época em cada ponto da grade (as que caem fora dela ficam de fora)
+    std::vector<long> epochAt(size, -1);
+    for (size_t k = 0; k < gnssData.time.size(); ++k) {
+        double u = (gnssData.time[k] - series.start) / interval;
+        long n = std::lround(u);
+        if (n >= 0 && static_cast<size_t>(n) < size && std::abs(u - n) < 0.1) {
+            epochAt[n] = static_cast<long>(k);
+        }
+    }
+
+    const double halfSpan = span * interval;
+    for (size_t n = span; n + span < size; ++n) {
+        long before = epochAt[n - span], centre = epochAt[n], after = epochAt[n + span];
+        if (before < 0 || centre < 0 || after < 0) {
+            continue;
+        }
+        Vec3 r0 = vec3(gnssData.x[before], gnssData.y[before], gnssData.z[before]);
+        Vec3 r1 = vec3(gnssData.x[centre], gnssData.y[centre], gnssData.z[centre]);
+        Vec3 r2 = vec3(gnssData.x[after], gnssData.y[after], gnssData.z[after]);
+        // Média triangular da aceleração em [t - span dt, t + span dt]
+        Vec3 acceleration = (r2 - 2.0 * r1 + r0) * (1.0 / (halfSpan * halfSpan));
+        Vec3 velocity = (r2 - r0) * (0.5 / halfSpan);
+        // f = a - g + 2 w x v em ECEF
+        Vec3 coriolis = vec3(-2.0 * earthRotationRate * velocity[1], 2.0 * earthRotationRate * velocity[0], 0.0);
+        series.values[n] = norm(acceleration - gravityEcef(r1) + coriolis);
+    }
+    return series;
+}
+
+// Médias móveis de window valores; NaN se faltar algum na janela
+std::vector<double> runningMean(const std::vector<double>& in, size_t window) {
+    std::vector<double> out(in.size(), notAvailable);
+    double sum = 0.0;
+    size_t missing = 0;
+    for (size_t i = 0; i < in.size(); ++i) {
+        if (std::isnan(in[i])) {
+            ++missing;
+        } else {
+            sum += in[i];
+        }
+        if (i >= window) {
+            if (std::isnan(in[i - window])) {
+                --missing;
+            } else {
+                sum -= in[i - window];
+            }
+        }
+        if (i + 1 >= window && missing == 0) {
+            out[i] = sum / window;
+        }
+    }
+    return out;
+}
+
+// Força específica no referencial do corpo da primeira amostra, com a atitude relativa dos giros: as médias ficam
+// comparáveis às do GNSS (em ECEF, que só gira a omega_ie). Cada amostra vale no intervalo que termina nela.
+ImuData inFirstFrame(const ImuData& imuData) {
+    ImuData rotated;
+    rotated.timeStamp = imuData.timeStamp;
+    rotated.accx.resize(imuData.timeStamp.size());
+    rotated.accy.resize(imuData.timeStamp.size());
+    rotated.accz.resize(imuData.timeStamp.size());
+    Quaternion attitude;
+    for (size_t i = 0; i < imuData.timeStamp.size(); ++i) {
+        double dt = i ? imuData.timeStamp[i] - imuData.timeStamp[i - 1] : 0.0;
+        Vec3 angle = vec3(imuData.gx[i], imuData.gy[i], imuData.gz[i]) * (degreesToRadians * dt);
+        // Rotação no meio do intervalo
+        Vec3 force = rotate(attitude * quaternionFromRotationVector(0.5 * angle),
+                            vec3(imuData.accx[i], imuData.accy[i], imuData.accz[i]));
+        attitude = normalize(attitude * quaternionFromRotationVector(angle));
+        rotated.accx[i] = force[0];
+        rotated.accy[i] = force[1];
+        rotated.accz[i] = force[2];
+    }
+    return rotated;
+}
+
+// A mesma média triangular da força específica do IMU, em passos de interval / fineSteps no relógio do IMU
+GridSeries imuSpecificForce(const ImuData& imuData, double interval, size_t span, size_t fineSteps) {
+    GridSeries series;
+    series.interval = interval / fineSteps;
+    ResampleOptions options;
+    options.mode = ResampleMode::IntegrateAndDump;
+    options.channels = {ImuChannel::AccX, ImuChannel::AccY, ImuChannel::AccZ};
+    std::vector<double> grid = uniformTimes(imuData.timeStamp.front(), imuData.timeStamp.back(), series.interval);
+    ResampledImu boxes = resampleImu(inFirstFrame(imuData), grid, options);
+
+    // Duas médias móveis de span intervalos: triângulo de meia largura span * interval; a caixa de cada valor termina
+    // no seu instante, então o centro fica span * interval - h / 2 antes
+    const size_t window = span * fineSteps;
+    std::vector<double> x = runningMean(runningMean(boxes.data.accx, window), window);
+    std::vector<double> y = runningMean(runningMean(boxes.data.accy, window), window);
+    std::vector<double> z = runningMean(runningMean(boxes.data.accz, window), window);
+    series.start = grid.front() - span * interval + 0.5 * series.interval;
+    series.values.resize(grid.size());
+    for (size_t i = 0; i < grid.size(); ++i) {
+        series.values[i] = standardGravity * std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+    }
+    return series;
+}
+
+// Valores sem a média e máscara dos válidos
+void centre(const std::vector<double>& values, std::vector<double>& centred, std::vector<double>& mask) {
+    double sum = 0.0;
+    size_t count = 0;
+    for (double v : values) {
+        if (!std::isnan(v)) {
+            sum += v;
+            ++count;
+        }
+    }
+    double mean = count ? sum / count : 0.0;
+    centred.resize(values.size());
+    mask.resize(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        bool valid = !std::isnan(values[i]);
+        centred[i] = valid ? values[i] - mean : 0.0;
+        mask[i] = valid ? 1.0 : 0.0;
+    }
+}
+
+// Pico da correlação normalizada direta nos atrasos finos [low, high]: x[lag + n * step] com y[n], n em [begin, end)
+struct Peak {
+    double lag = notAvailable; // Com a parábola pelos três melhores
+    double correlation = -1.0;
+};
+
+Peak finePeak(const std::vector<double>& x, const std::vector<double>& xMask, const std::vector<double>& y,
+              const std::vector<double>& yMask, size_t step, long low, long high, size_t begin, size_t end,
+              size_t minCount) {
+    std::vector<double> ncc(static_cast<size_t>(high - low + 1), notAvailable);
+    const long size = static_cast<long>(x.size());
+    for (long lag = low; lag <= high; ++lag) {
+        double sxy = 0.0, sxx = 0.0, syy = 0.0;
+        size_t count = 0;
+        for (size_t n = begin; n < end; ++n) {
+            long i = lag + static_cast<long>(n * step);
+            if (i < 0 || i >= size || xMask[i] == 0.0 || yMask[n] == 0.0) {
+                continue;
+            }
+            sxy += x[i] * y[n];
+            sxx += x[i] * x[i];
+            syy += y[n] * y[n];
+            ++count;
+        }
+        if (count >= minCount && sxx > 0.0 && syy > 0.0) {
+            ncc[lag - low] = sxy / std::sqrt(sxx * syy);
+        }
+    }
+
+    Peak peak;
+    size_t best = ncc.size();
+    for (size_t i = 0; i < ncc.size(); ++i) {
+        if (!std::isnan(ncc[i]) && (best == ncc.size() || ncc[i] > ncc[best])) {
+            best = i;
+        }
+    }
+    // O máximo precisa de vizinhos dos dois lados
+    if (best == ncc.size() || best == 0 || best + 1 == ncc.size() || std::isnan(ncc[best - 1]) ||
+        std::isnan(ncc[best + 1])) {
+        return peak;
+    }
+    double left = ncc[best - 1], centreValue = ncc[best], right = ncc[best + 1];
+    double curvature = left - 2.0 * centreValue + right;
+    double delta = curvature < 0.0 ? 0.5 * (left - right) / curvature : 0.0;
+    peak.lag = static_cast<double>(low + static_cast<long>(best)) + delta;
+    peak.correlation = centreValue;
+    return peak;
+}
+
+} // namespace
+
+ClockOffsetEstimate estimateClockOffset(const ImuData& imuData, const GnssData& gnssData,
+                                        const ClockOffsetOptions& options) {
+    const size_t span = std::max<size_t>(options.differenceSpan, 1);
+    const size_t fineSteps = std::max<size_t>(options.fineSteps, 1);
+    if (gnssData.time.size() < 2 * span + 1 || imuData.timeStamp.size() < 2) {
+        throw std::runtime_error("Not enough data to estimate the clock offset.");
+    }
+    const double interval = options.sampleInterval > 0.0 ? options.sampleInterval
+                                                         : medianSampleInterval(gnssData.time);
+    if (!(interval > 0.0)) {
+        throw std::runtime_error("GNSS data has no valid sampling interval.");
+    }
+
+    GridSeries gnss = gnssSpecificForce(gnssData, interval, span);
+    GridSeries imu = imuSpecificForce(imuData, interval, span, fineSteps);
+    std::vector<double> y, yMask, x, xMask;
+    centre(gnss.values, y, yMask);
+    centre(imu.values, x, xMask);
+    size_t numValid = 0;
+    for (double m : yMask) {
+        numValid += m != 0.0;
+    }
+    const size_t minCount = std::max<size_t>(3, static_cast<size_t>(options.minOverlap * numValid));
+
+    // Atrasos inteiros da grade: correlação normalizada com as somas só na sobreposição
+    std::vector<double> xCoarse, xCoarseMask, xSquared, ySquared;
+    for (size_t i = 0; i < x.size(); i += fineSteps) {
+        xCoarse.push_back(x[i]);
+        xCoarseMask.push_back(xMask[i]);
+        xSquared.push_back(x[i] * x[i]);
+    }
+    for (double v : y) {
+        ySquared.push_back(v * v);
+    }
+    std::vector<double> sxy = crossCorrelation(xCoarse, y);
+    std::vector<double> sxx = crossCorrelation(xSquared, yMask);
+    std::vector<double> syy = crossCorrelation(xCoarseMask, ySquared);
+    std::vector<double> count = crossCorrelation(xCoarseMask, yMask);
+    size_t best = sxy.size();
+    double bestCorrelation = -1.0;
+    for (size_t i = 0; i < sxy.size(); ++i) {
+        // As somas da FFT têm erro de arredondamento: contagens arredondadas, somas de quadrados positivas
+        if (std::lround(count[i]) < static_cast<long>(minCount) || sxx[i] <= 0.0 || syy[i] <= 0.0) {
+            continue;
+        }
+        double c = sxy[i] / std::sqrt(sxx[i] * syy[i]);
+        if (c > bestCorrelation) {
+            bestCorrelation = c;
+            best = i;
+        }
+    }
+    if (best == sxy.size()) {
+        throw std::runtime_error("IMU and GNSS data do not overlap.");
+    }
+    const long coarseLag = static_cast<long>(best) - static_cast<long>(y.size() - 1);
+
+    // x[lag + n * fineSteps] está no instante do IMU imu.start + lag * imu.interval + n * interval
+    auto offsetOfLag = [&](double lag) { return imu.start + lag * imu.interval - gnss.start; };
+    ClockOffsetEstimate estimate;
+    estimate.coarseOffset = offsetOfLag(static_cast<double>(coarseLag * static_cast<long>(fineSteps)));
+
+    const long centreLag = coarseLag * static_cast<long>(fineSteps);
+    const long radius = static_cast<long>(fineSteps);
+    Peak global = finePeak(x, xMask, y, yMask, fineSteps, centreLag - radius, centreLag + radius, 0, y.size(),
+                           minCount);
+    if (std::isnan(global.lag)) {
+        throw std::runtime_error("Correlation peak is at the edge of the overlap.");
+    }
+    estimate.offset = offsetOfLag(global.lag);
+    estimate.correlation = global.correlation;
+
+    // Instante central das amostras GNSS usadas
+    double timeSum = 0.0;
+    for (size_t n = 0; n < y.size(); ++n) {
+        timeSum += yMask[n] * n;
+    }
+    estimate.referenceTime = gnss.start + timeSum / numValid * interval;
+    if (!options.estimateDrift) {
+        return estimate;
+    }
+
+    // Pedaços da sessão refinados em torno do pico global; reta pelos seus atrasos
+    const size_t piece = std::max<size_t>(static_cast<size_t>(options.driftWindow / interval), 4 * span);
+    const long shift = static_cast<long>(std::ceil(options.maxDriftShift / imu.interval)) + 1;
+    const long globalLag = std::lround(global.lag);
+    for (size_t begin = 0; begin + piece <= y.size(); begin += piece) {
+        size_t valid = 0;
+        for (size_t n = begin; n < begin + piece; ++n) {
+            valid += yMask[n] != 0.0;
+        }
+        if (valid < piece / 2) {
+            continue;
+        }
+        Peak local = finePeak(x, xMask, y, yMask, fineSteps, globalLag - shift, globalLag + shift, begin,
+                              begin + piece, valid / 2);
+        if (std::isnan(local.lag) || local.correlation < options.minWindowCorrelation) {
+            continue;
+        }
+        estimate.windowTimes.push_back(gnss.start + (begin + 0.5 * (piece - 1)) * interval);
+        estimate.windowOffsets.push_back(offsetOfLag(local.lag));
+    }
+    const size_t numWindows = estimate.windowTimes.size();
+    if (numWindows < 2) {
+        throw std::runtime_error("Too few pieces with a clear correlation peak to estimate the drift.");
+    }
+    double meanTime = 0.0, meanOffset = 0.0;
+    for (size_t w = 0; w < numWindows; ++w) {
+        meanTime += estimate.windowTimes[w] / numWindows;
+        meanOffset += estimate.windowOffsets[w] / numWindows;
+    }
+    double stt = 0.0, sto = 0.0;
+    for (size_t w = 0; w < numWindows; ++w) {
+        double dt = estimate.windowTimes[w] - meanTime;
+        stt += dt * dt;
+        sto += dt * (estimate.windowOffsets[w] - meanOffset);
+    }
+    estimate.referenceTime = meanTime;
+    estimate.offset = meanOffset;
+    estimate.drift = sto / stt;
+    return estimate;
+}
@@ -0,0 +1,77 @@
+#ifndef CLOCK_OFFSET_HPP
+#define CLOCK_OFFSET_HPP
+
+#include <vector>
+#include <cstddef>
+#include <limits>
+#include "imuData.hpp"
+#include "gnssData.hpp"
+
+/**
+ * @brief Options of the IMU/GNSS clock offset estimation.
+ */
+struct ClockOffsetOptions {
+    double sampleInterval = 0.0; ///< Interval of the GNSS grid (s; 0 = median interval of the GNSS epochs)
+    size_t differenceSpan = 5; ///< Epochs m between the positions of the second difference (smoothing over m intervals)
+    size_t fineSteps = 20; ///< Lags per grid interval in the sub-sample search
+    double minOverlap = 0.5; ///< Smallest overlap of a lag, as a fraction of the valid GNSS samples
+    bool estimateDrift = false; ///< Also estimate a linear drift of the offset
+    double driftWindow = 120.0; ///< Length of the pieces of the session whose offsets are fitted with a line (s)
+    double maxDriftShift = 1.0; ///< Largest change of the offset over the session searched for the drift (s)
+    double minWindowCorrelation = 0.5; ///< Pieces with a weaker correlation peak are left out of the drift fit
+};
+
+/**
+ * @brief Estimated offset between the IMU clock and GNSS time.
+ */
+struct ClockOffsetEstimate {
+    double offset = std::numeric_limits<double>::quiet_NaN(); ///< IMU clock minus GNSS time at referenceTime (s), as GnssInsOptions::timeOffset
+    double drift = 0.0; ///< Rate of change of the offset (s per s of GNSS time; 0 unless estimated)
+    double referenceTime = 0.0; ///< GNSS time where offset applies (s)
+    double coarseOffset = std::numeric_limits<double>::quiet_NaN(); ///< Offset at the best whole grid lag (s)
+    double correlation = 0.0; ///< Normalized correlation at the peak
+    std::vector<double> windowTimes; ///< GNSS times of the pieces used in the drift fit
+    std::vector<double> windowOffsets; ///< Offsets of those pieces (s)
+
+    /**
+     * @brief Offset at a GNSS time (IMU clock = gnssTime + offsetAt(gnssTime)).
+     */
+    double offsetAt(double gnssTime) const { return offset + drift * (gnssTime - referenceTime); }
+};
+
+/**
+ * @brief Estimates the IMU clock offset by correlating specific force magnitudes.
+ *
+ * The magnitude of the specific force does not depend on the attitude, so it
+ * is computed from both sensors and the two series are aligned:
+ *
+ * - GNSS: the second difference of the ECEF positions m epochs apart, minus
+ *   gravity plus the Coriolis term, on the grid of the GNSS epochs. Epochs
+ *   without both neighbours are left out.
+ * - IMU: the same triangular average of the specific force (which is what a
+ *   second difference of positions measures), taken as two running means of
+ *   m grid intervals over integrate-and-dump resamples (resampleImu) at
+ *   fineSteps per grid interval of the IMU clock. The specific force is first
+ *   rotated into the body frame of the first sample with the gyros, so the
+ *   average is taken in a (nearly) non-rotating frame, as the GNSS one is;
+ *   averaging in the body frame would bias the offset when the vehicle turns.
+ *
+ * The normalized cross-correlation of the two (demeaned, gaps masked) at every
+ * whole grid lag comes from four FFT correlations, so the cost is O(N log N)
+ * over the whole session with no prior on the offset. The best lag is refined
+ * by direct correlation at the fine lags around it and a parabola through the
+ * three best. With estimateDrift the session is cut into pieces of
+ * driftWindow seconds, each piece is refined the same way around the global
+ * peak, and a line is fitted to their offsets.
+ *
+ * @param imuData The IMU data (timestamps on the IMU clock).
+ * @param gnssData The GNSS data, with ECEF positions (time in GPST).
+ * @param options The estimation options.
+ * @return ClockOffsetEstimate The offset (and drift) of the IMU clock.
+ * @throws std::runtime_error If the data is too short, does not overlap, or (with
+ *         estimateDrift) fewer than two pieces have a clear peak.
+ */
+ClockOffsetEstimate estimateClockOffset(const ImuData& imuData, const GnssData& gnssData,
+                                        const ClockOffsetOptions& options = ClockOffsetOptions());
+
+#endif // CLOCK_OFFSET_HPP
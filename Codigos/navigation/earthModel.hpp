@@ -0,0 +1,67 @@
+#ifndef EARTH_MODEL_HPP
+#define EARTH_MODEL_HPP
+
+#include <cmath>
+#include "fixedMatrix.hpp"
+#include "llaFromEcef.hpp"
+
+// Elipsoide WGS84 (os mesmos a e e de llaFromEcefPoint)
+constexpr double earthSemiMajorAxis = 6378137.0; ///< a (m)
+constexpr double earthEccentricity = 0.0818191908425; ///< e
+constexpr double earthRotationRate = 7.292115e-5; ///< omega_ie (rad/s)
+constexpr double earthGravitationalConstant = 3.986004418e14; ///< GM (m^3/s^2)
+constexpr double earthJ2 = 1.082627e-3; ///< Second zonal harmonic
+constexpr double standardGravity = 9.80665; ///< m/s^2 per g (unit of the accelerometer columns)
+constexpr double degreesToRadians = M_PI / 180.0;
+
+/**
+ * @brief Converts geodetic coordinates to an ECEF position.
+ *
+ * @param lat The latitude in degrees.
+ * @param lon The longitude in degrees.
+ * @param alt The altitude in meters.
+ * @return Vec3 The ECEF position in meters.
+ */
+inline Vec3 ecefFromLla(double lat, double lon, double alt) {
+    double sinLat = std::sin(lat * degreesToRadians), cosLat = std::cos(lat * degreesToRadians);
+    double sinLon = std::sin(lon * degreesToRadians), cosLon = std::cos(lon * degreesToRadians);
+    double e2 = earthEccentricity * earthEccentricity;
+    double radius = earthSemiMajorAxis / std::sqrt(1.0 - e2 * sinLat * sinLat); // Raio de curvatura transversal
+    return vec3((radius + alt) * cosLat * cosLon, (radius + alt) * cosLat * sinLon,
+                (radius * (1.0 - e2) + alt) * sinLat);
+}
+
+/**
+ * @brief Rotation C_n^e from the local North-East-Down frame to ECEF.
+ *
+ * @param lat The latitude in degrees.
+ * @param lon The longitude in degrees.
+ */
+inline Mat3 ecefFromNedRotation(double lat, double lon) {
+    double sinLat = std::sin(lat * degreesToRadians), cosLat = std::cos(lat * degreesToRadians);
+    double sinLon = std::sin(lon * degreesToRadians), cosLon = std::cos(lon * degreesToRadians);
+    return Mat3{{-sinLat * cosLon, -sinLon, -cosLat * cosLon,
+                 -sinLat * sinLon, cosLon, -cosLat * sinLon,
+                 cosLat, 0.0, -sinLat}};
+}
+
+/**
+ * @brief Gravity (gravitation with J2 plus centrifugal acceleration) in ECEF.
+ *
+ * This is the acceleration an accelerometer at rest on the Earth does not
+ * feel: a static IMU measures the specific force -gravityEcef(position).
+ *
+ * @param position The ECEF position in meters (away from the centre of the Earth).
+ * @return Vec3 The gravity vector in m/s^2.
+ */
+inline Vec3 gravityEcef(const Vec3& position) {
+    double r2 = dot(position, position);
+    double r = std::sqrt(r2);
+    double zr2 = position[2] * position[2] / r2;
+    double j2 = 1.5 * earthJ2 * earthSemiMajorAxis * earthSemiMajorAxis / r2;
+    double k = -earthGravitationalConstant / (r2 * r);
+    double horizontal = k * (1.0 + j2 * (1.0 - 5.0 * zr2)) + earthRotationRate * earthRotationRate;
+    return vec3(horizontal * position[0], horizontal * position[1], k * (1.0 + j2 * (3.0 - 5.0 * zr2)) * position[2]);
+}
+
+#endif // EARTH_MODEL_HPP
@@ -0,0 +1,94 @@
+#include "fft.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+size_t nextPowerOfTwo(size_t n) {
+    size_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+void fft(std::vector<std::complex<double>>& data, bool inverse) {
+    const size_t n = data.size();
+    if (n == 0 || (n & (n - 1)) != 0) {
+        throw std::invalid_argument("FFT length must be a power of two.");
+    }
+
+    // Permutação por inversão de bits
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(data[i], data[j]);
+        }
+    }
+
+    // Fatores exp(-+2 pi i k / n), k < n / 2; a etapa de tamanho len usa os de índice k n / len
+    const double sign = inverse ? 1.0 : -1.0;
+    std::vector<std::complex<double>> twiddle(n / 2);
+    for (size_t k = 0; k < n / 2; ++k) {
+        double angle = sign * 2.0 * M_PI * static_cast<double>(k) / static_cast<double>(n);
+        twiddle[k] = std::complex<double>(std::cos(angle), std::sin(angle));
+    }
+
+    for (size_t len = 2; len <= n; len <<= 1) {
+        size_t half = len >> 1, stride = n / len;
+        for (size_t start = 0; start < n; start += len) {
+            for (size_t k = 0; k < half; ++k) {
+                std::complex<double> u = data[start + k];
+                std::complex<double> v = data[start + k + half] * twiddle[k * stride];
+                data[start + k] = u + v;
+                data[start + k + half] = u - v;
+            }
+        }
+    }
+
+    if (inverse) {
+        double scale = 1.0 / static_cast<double>(n);
+        for (std::complex<double>& value : data) {
+            value *= scale;
+        }
+    }
+}
+
+std::vector<double> crossCorrelation(const std::vector<double>& x, const std::vector<double>& y) {
+    if (x.empty() || y.empty()) {
+        return {};
+    }
+    const size_t length = x.size() + y.size() - 1;
+    const size_t n = nextPowerOfTwo(length);
+
+    // z = x + i y; X_k = (Z_k + conj(Z_-k)) / 2, Y_k = (Z_k - conj(Z_-k)) / 2i
+    std::vector<std::complex<double>> z(n);
+    for (size_t i = 0; i < x.size(); ++i) {
+        z[i].real(x[i]);
+    }
+    for (size_t i = 0; i < y.size(); ++i) {
+        z[i].imag(y[i]);
+    }
+    fft(z);
+
+    // Espectro da correlação X_k conj(Y_k)
+    std::vector<std::complex<double>> spectrum(n);
+    for (size_t k = 0; k < n; ++k) {
+        std::complex<double> a = z[k], b = std::conj(z[(n - k) & (n - 1)]);
+        std::complex<double> xk = 0.5 * (a + b);
+        std::complex<double> yk = std::complex<double>(0.0, -0.5) * (a - b);
+        spectrum[k] = xk * std::conj(yk);
+    }
+    fft(spectrum, true);
+
+    // Atrasos negativos ficam no fim do resultado circular
+    std::vector<double> c(length);
+    for (size_t i = 0; i < length; ++i) {
+        long lag = static_cast<long>(i) - static_cast<long>(y.size() - 1);
+        c[i] = spectrum[lag >= 0 ? static_cast<size_t>(lag) : n - static_cast<size_t>(-lag)].real();
+    }
+    return c;
+}
@@ -0,0 +1,41 @@
+#ifndef FFT_HPP
+#define FFT_HPP
+
+#include <vector>
+#include <complex>
+#include <cstddef>
+
+/**
+ * @brief Smallest power of two not less than n (1 for n = 0).
+ */
+size_t nextPowerOfTwo(size_t n);
+
+/**
+ * @brief In-place iterative radix-2 FFT.
+ *
+ * Computes X_k = sum_n x_n exp(-2 pi i k n / N), or with inverse the inverse
+ * transform including the 1 / N factor. The twiddle factors are computed
+ * directly for each index (no recurrence), so the error stays near the
+ * rounding of one butterfly per stage.
+ *
+ * @param data The sequence, transformed in place; its length must be a power of two.
+ * @param inverse If true, computes the inverse transform.
+ * @throws std::invalid_argument If the length is not a power of two.
+ */
+void fft(std::vector<std::complex<double>>& data, bool inverse = false);
+
+/**
+ * @brief Linear (not circular) cross-correlation c_L = sum_n x_{n + L} y_n via FFT.
+ *
+ * Both real sequences are transformed with one complex FFT (x + i y), zero
+ * padded to a power of two not less than x.size() + y.size() - 1, so the cost
+ * is two FFTs of that size.
+ *
+ * @param x The first sequence.
+ * @param y The second sequence.
+ * @return std::vector<double> c_L for L from -(y.size() - 1) to x.size() - 1, at index L + y.size() - 1
+ *         (empty if a sequence is empty).
+ */
+std::vector<double> crossCorrelation(const std::vector<double>& x, const std::vector<double>& y);
+
+#endif // FFT_HPP
@@ -0,0 +1,230 @@
+#ifndef FIXED_MATRIX_HPP
+#define FIXED_MATRIX_HPP
+
+#include <cstddef>
+#include <cmath>
+#include <stdexcept>
+
+/**
+ * @brief Matrix of compile-time size stored row-major on the stack.
+ *
+ * Every operation is a loop over constant bounds, which the compiler unrolls
+ * for the small sizes of the navigation code (3x3 up to 15x15), and no
+ * operation allocates. Value-initialization (Matrix<R, C> m{}) gives zeros.
+ *
+ * @tparam R Number of rows.
+ * @tparam C Number of columns.
+ */
+template <size_t R, size_t C>
+struct Matrix {
+    static constexpr size_t rows = R;
+    static constexpr size_t cols = C;
+
+    double m[R * C]; ///< Elements, row after row
+
+    double& operator()(size_t r, size_t c) { return m[r * C + c]; }
+    const double& operator()(size_t r, size_t c) const { return m[r * C + c]; }
+
+    /// Element i of a vector (or of the row-major storage)
+    double& operator[](size_t i) { return m[i]; }
+    const double& operator[](size_t i) const { return m[i]; }
+
+    static Matrix zero() { return Matrix{}; }
+
+    static Matrix identity() {
+        Matrix a{};
+        for (size_t i = 0; i < (R < C ? R : C); ++i) {
+            a(i, i) = 1.0;
+        }
+        return a;
+    }
+
+    Matrix& operator+=(const Matrix& b) {
+        for (size_t i = 0; i < R * C; ++i) {
+            m[i] += b.m[i];
+        }
+        return *this;
+    }
+
+    Matrix& operator-=(const Matrix& b) {
+        for (size_t i = 0; i < R * C; ++i) {
+            m[i] -= b.m[i];
+        }
+        return *this;
+    }
+
+    Matrix& operator*=(double s) {
+        for (size_t i = 0; i < R * C; ++i) {
+            m[i] *= s;
+        }
+        return *this;
+    }
+};
+
+using Vec3 = Matrix<3, 1>;
+using Mat3 = Matrix<3, 3>;
+
+template <size_t R, size_t C>
+Matrix<R, C> operator+(Matrix<R, C> a, const Matrix<R, C>& b) {
+    return a += b;
+}
+
+template <size_t R, size_t C>
+Matrix<R, C> operator-(Matrix<R, C> a, const Matrix<R, C>& b) {
+    return a -= b;
+}
+
+template <size_t R, size_t C>
+Matrix<R, C> operator-(Matrix<R, C> a) {
+    return a *= -1.0;
+}
+
+template <size_t R, size_t C>
+Matrix<R, C> operator*(Matrix<R, C> a, double s) {
+    return a *= s;
+}
+
+template <size_t R, size_t C>
+Matrix<R, C> operator*(double s, Matrix<R, C> a) {
+    return a *= s;
+}
+
+template <size_t R, size_t K, size_t C>
+Matrix<R, C> operator*(const Matrix<R, K>& a, const Matrix<K, C>& b) {
+    Matrix<R, C> p{};
+    for (size_t r = 0; r < R; ++r) {
+        for (size_t k = 0; k < K; ++k) {
+            double ark = a(r, k);
+            for (size_t c = 0; c < C; ++c) {
+                p(r, c) += ark * b(k, c);
+            }
+        }
+    }
+    return p;
+}
+
+template <size_t R, size_t C>
+Matrix<C, R> transpose(const Matrix<R, C>& a) {
+    Matrix<C, R> t;
+    for (size_t r = 0; r < R; ++r) {
+        for (size_t c = 0; c < C; ++c) {
+            t(c, r) = a(r, c);
+        }
+    }
+    return t;
+}
+
+/**
+ * @brief Copies the BR x BC block of a that starts at row r0 and column c0.
+ */
+template <size_t BR, size_t BC, size_t R, size_t C>
+Matrix<BR, BC> block(const Matrix<R, C>& a, size_t r0, size_t c0) {
+    Matrix<BR, BC> b;
+    for (size_t r = 0; r < BR; ++r) {
+        for (size_t c = 0; c < BC; ++c) {
+            b(r, c) = a(r0 + r, c0 + c);
+        }
+    }
+    return b;
+}
+
+/**
+ * @brief Overwrites the block of a that starts at row r0 and column c0 with b.
+ */
+template <size_t BR, size_t BC, size_t R, size_t C>
+void setBlock(Matrix<R, C>& a, size_t r0, size_t c0, const Matrix<BR, BC>& b) {
+    for (size_t r = 0; r < BR; ++r) {
+        for (size_t c = 0; c < BC; ++c) {
+            a(r0 + r, c0 + c) = b(r, c);
+        }
+    }
+}
+
+/**
+ * @brief Inverse of a 3x3 matrix (adjugate over determinant).
+ *
+ * @throws std::runtime_error If the matrix is singular.
+ */
+inline Matrix<3, 3> inverse(const Matrix<3, 3>& a) {
+    Matrix<3, 3> adj{{a(1, 1) * a(2, 2) - a(1, 2) * a(2, 1), a(0, 2) * a(2, 1) - a(0, 1) * a(2, 2),
+                      a(0, 1) * a(1, 2) - a(0, 2) * a(1, 1),
+                      a(1, 2) * a(2, 0) - a(1, 0) * a(2, 2), a(0, 0) * a(2, 2) - a(0, 2) * a(2, 0),
+                      a(0, 2) * a(1, 0) - a(0, 0) * a(1, 2),
+                      a(1, 0) * a(2, 1) - a(1, 1) * a(2, 0), a(0, 1) * a(2, 0) - a(0, 0) * a(2, 1),
+                      a(0, 0) * a(1, 1) - a(0, 1) * a(1, 0)}};
+    double det = a(0, 0) * adj(0, 0) + a(0, 1) * adj(1, 0) + a(0, 2) * adj(2, 0);
+    if (det == 0.0 || !std::isfinite(det)) {
+        throw std::runtime_error("Singular matrix.");
+    }
+    return adj *= 1.0 / det;
+}
+
+/**
+ * @brief Solves a * x = b for a symmetric positive definite a (Cholesky factorization).
+ *
+ * @throws std::runtime_error If a is not positive definite.
+ */
+template <size_t N, size_t M>
+Matrix<N, M> solveSymmetric(const Matrix<N, N>& a, Matrix<N, M> b) {
+    Matrix<N, N> l{};
+    for (size_t j = 0; j < N; ++j) {
+        double d = a(j, j);
+        for (size_t k = 0; k < j; ++k) {
+            d -= l(j, k) * l(j, k);
+        }
+        if (!(d > 0.0)) {
+            throw std::runtime_error("Matrix is not positive definite.");
+        }
+        l(j, j) = std::sqrt(d);
+        for (size_t i = j + 1; i < N; ++i) {
+            double v = a(i, j);
+            for (size_t k = 0; k < j; ++k) {
+                v -= l(i, k) * l(j, k);
+            }
+            l(i, j) = v / l(j, j);
+        }
+    }
+    // L y = b e depois L' x = y, coluna por coluna de b
+    for (size_t c = 0; c < M; ++c) {
+        for (size_t i = 0; i < N; ++i) {
+            double v = b(i, c);
+            for (size_t k = 0; k < i; ++k) {
+                v -= l(i, k) * b(k, c);
+            }
+            b(i, c) = v / l(i, i);
+        }
+        for (size_t i = N; i-- > 0;) {
+            double v = b(i, c);
+            for (size_t k = i + 1; k < N; ++k) {
+                v -= l(k, i) * b(k, c);
+            }
+            b(i, c) = v / l(i, i);
+        }
+    }
+    return b;
+}
+
+inline Vec3 vec3(double x, double y, double z) {
+    return Vec3{{x, y, z}};
+}
+
+inline double dot(const Vec3& a, const Vec3& b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+inline Vec3 cross(const Vec3& a, const Vec3& b) {
+    return vec3(a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]);
+}
+
+inline double norm(const Vec3& a) {
+    return std::sqrt(dot(a, a));
+}
+
+/**
+ * @brief Skew-symmetric matrix [a x], such that skew(a) * b = cross(a, b).
+ */
+inline Mat3 skew(const Vec3& a) {
+    return Mat3{{0.0, -a[2], a[1], a[2], 0.0, -a[0], -a[1], a[0], 0.0}};
+}
+
+#endif // FIXED_MATRIX_HPP
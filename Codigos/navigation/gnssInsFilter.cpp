@@ -0,0 +1,249 @@
+#include "gnssInsFilter.hpp"
+#include <cmath>
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+#include "earthModel.hpp"
+
+namespace {
+
+// Gradiente da gravitação (modelo esférico) na posição r
+Mat3 gravityGradient(const Vec3& r) {
+    double r2 = dot(r, r);
+    double k = earthGravitationalConstant / (r2 * std::sqrt(r2));
+    Mat3 g = (3.0 * k / r2) * (r * transpose(r));
+    for (size_t i = 0; i < 3; ++i) {
+        g(i, i) -= k;
+    }
+    return g;
+}
+
+double measurementSigma(const GnssInsOptions& options, int fix) {
+    if (fix == 1) {
+        return options.fixSigma;
+    }
+    if (fix == 2) {
+        return options.floatSigma;
+    }
+    return options.otherSigma;
+}
+
+} // namespace
+
+GnssInsFilter::GnssInsFilter(const InsState& initial, const GnssInsOptions& options)
+    : options_(options), ins_(initial, options.strapdown), covariance_{} {
+    const double sigmas[] = {options.initialPositionSigma, options.initialVelocitySigma,
+                             options.initialAttitudeSigma, options.initialAccelBiasSigma,
+                             options.initialGyroBiasSigma};
+    for (size_t i = 0; i < numErrorStates; ++i) {
+        covariance_(i, i) = sigmas[i / 3] * sigmas[i / 3];
+    }
+    transition_.velocityVelocity = transition_.attitudeAttitude = Mat3::identity();
+}
+
+size_t GnssInsFilter::predict(const ImuData& imuData, size_t first, double time) {
+    const size_t numSamples = imuData.timeStamp.size();
+    size_t i = first;
+    while (i < numSamples && imuData.timeStamp[i] <= time) {
+        i = predictStep(imuData, i, time);
+    }
+    return i;
+}
+
+size_t GnssInsFilter::predictStep(const ImuData& imuData, size_t first, double time) {
+    const size_t numSamples = imuData.timeStamp.size();
+    const double* t = imuData.timeStamp.data();
+    double start = ins_.state().time;
+    // Folga de 1 us: timestamps da ordem de 1e9 s arredondam a ~2e-7 s, e um intervalo que
+    // deveria ter exatamente N amostras não pode perder a última por isso
+    double end = start + options_.covarianceInterval + 1e-6;
+    size_t j = first;
+    Vec3 force{};
+    while (j < numSamples && t[j] <= time && (j == first || t[j] <= end)) {
+        force += vec3(imuData.accx[j], imuData.accy[j], imuData.accz[j]);
+        ++j;
+    }
+    if (j == first) {
+        return first;
+    }
+    ins_.propagate(imuData, first, j);
+    double dt = ins_.state().time - start;
+    if (dt > 0.0) {
+        propagateCovariance(dt, force * (standardGravity / (j - first)) - ins_.accelBias());
+    } else {
+        // Só amostras já integradas: nada mudou
+        transition_ = TransitionBlocks();
+        transition_.velocityVelocity = transition_.attitudeAttitude = Mat3::identity();
+    }
+    return j;
+}
+
+// Phi * m por linhas de blocos 3x15: 6 produtos 3x3 por 3x15 em vez de um 15x15 por 15x15
+ErrorCovariance GnssInsFilter::applyTransition(const TransitionBlocks& phi, const ErrorCovariance& m) {
+    using Rows = Matrix<3, numErrorStates>;
+    Rows position = block<3, numErrorStates>(m, errorPosition, 0);
+    Rows velocity = block<3, numErrorStates>(m, errorVelocity, 0);
+    Rows attitude = block<3, numErrorStates>(m, errorAttitude, 0);
+    Rows accelBias = block<3, numErrorStates>(m, errorAccelBias, 0);
+    Rows gyroBias = block<3, numErrorStates>(m, errorGyroBias, 0);
+    ErrorCovariance out = m;
+    setBlock(out, errorPosition, 0, position + velocity * phi.dt);
+    setBlock(out, errorVelocity, 0, phi.velocityPosition * position + phi.velocityVelocity * velocity +
+                                        phi.velocityAttitude * attitude + phi.velocityAccelBias * accelBias);
+    setBlock(out, errorAttitude, 0, phi.attitudeAttitude * attitude + phi.attitudeGyroBias * gyroBias);
+    return out;
+}
+
+ErrorCovariance GnssInsFilter::transition() const {
+    return applyTransition(transition_, ErrorCovariance::identity());
+}
+
+void GnssInsFilter::propagateCovariance(double dt, const Vec3& meanForce) {
+    const InsState& s = ins_.state();
+    Mat3 c = dcmFromQuaternion(s.attitude);
+    TransitionBlocks& phi = transition_;
+    phi.dt = dt;
+    phi.velocityPosition = options_.strapdown.gravity ? gravityGradient(s.position) * dt : Mat3{};
+    phi.velocityVelocity = Mat3::identity();
+    phi.velocityAttitude = skew(c * meanForce) * -dt;
+    phi.velocityAccelBias = c * -dt;
+    phi.attitudeAttitude = Mat3::identity();
+    phi.attitudeGyroBias = c * -dt;
+    if (options_.strapdown.earthRotation) {
+        Mat3 omega = skew(vec3(0.0, 0.0, earthRotationRate));
+        phi.velocityVelocity -= omega * (2.0 * dt);
+        phi.attitudeAttitude -= omega * dt;
+    }
+
+    // Phi P Phi' = Phi (Phi P)'
+    ErrorCovariance p = applyTransition(phi, transpose(applyTransition(phi, covariance_)));
+    const double noise[] = {0.0, options_.accelNoise, options_.gyroNoise, options_.accelBiasNoise,
+                            options_.gyroBiasNoise};
+    for (size_t i = 0; i < numErrorStates; ++i) {
+        p(i, i) += noise[i / 3] * noise[i / 3] * dt;
+    }
+    // Mantém a simetria apesar dos arredondamentos
+    covariance_ = 0.5 * (p + transpose(p));
+}
+
+GnssUpdate GnssInsFilter::update(const Vec3& position, int fix, double time) {
+    GnssUpdate result;
+    result.sigma = measurementSigma(options_, fix);
+    if (!(result.sigma > 0.0)) {
+        return result;
+    }
+
+    // Posição da antena prevista para o instante da época
+    InsState s = ins_.state();
+    Vec3 lever = rotate(s.attitude, options_.leverArm);
+    result.innovation = position - (s.position + (time - s.time) * s.velocity + lever);
+
+    Matrix<3, numErrorStates> h{};
+    setBlock(h, 0, errorPosition, Mat3::identity());
+    setBlock(h, 0, errorAttitude, -skew(lever));
+    Matrix<numErrorStates, 3> pht = covariance_ * transpose(h);
+    Mat3 r = Mat3::identity() * (result.sigma * result.sigma);
+    Mat3 sInverse = inverse(h * pht + r);
+    result.normalizedInnovation = (transpose(result.innovation) * sInverse * result.innovation)[0];
+    if (options_.innovationGate > 0.0 && result.normalizedInnovation > options_.innovationGate) {
+        return result;
+    }
+    result.accepted = true;
+
+    Matrix<numErrorStates, 3> gain = pht * sInverse;
+    Matrix<numErrorStates, 1> dx = gain * result.innovation;
+    // Forma de Joseph (I - KH) P (I - KH)' + K R K', que continua simétrica e positiva com
+    // ganhos arredondados, sem produtos 15x15 por 15x15: A = P - K (HP) e A (I - KH)' = A - (A H') K'
+    ErrorCovariance a = covariance_ - gain * transpose(pht);
+    ErrorCovariance p = a - (a * transpose(h)) * transpose(gain) + gain * r * transpose(gain);
+    covariance_ = 0.5 * (p + transpose(p));
+
+    s.position += block<3, 1>(dx, errorPosition, 0);
+    s.velocity += block<3, 1>(dx, errorVelocity, 0);
+    s.attitude = normalize(quaternionFromRotationVector(block<3, 1>(dx, errorAttitude, 0)) * s.attitude);
+    ins_.setState(s);
+    ins_.setBiases(ins_.gyroBias() + block<3, 1>(dx, errorGyroBias, 0),
+                   ins_.accelBias() + block<3, 1>(dx, errorAccelBias, 0));
+    return result;
+}
+
+Vec3 GnssInsFilter::positionSigma() const {
+    return vec3(std::sqrt(covariance_(0, 0)), std::sqrt(covariance_(1, 1)), std::sqrt(covariance_(2, 2)));
+}
+
+std::vector<size_t> usableGnssEpochs(const ImuData& imuData, const GnssData& gnssData, const InsState& initial,
+                                     const GnssInsOptions& options) {
+    std::vector<size_t> epochs;
+    if (imuData.timeStamp.empty()) {
+        return epochs;
+    }
+    double firstImu = std::max(imuData.timeStamp.front(), initial.time);
+    double lastImu = imuData.timeStamp.back();
+    for (size_t k = 0; k < gnssData.time.size(); ++k) {
+        double time = gnssData.time[k] + options.timeOffset;
+        if (time >= firstImu && time <= lastImu) {
+            epochs.push_back(k);
+        }
+    }
+    return epochs;
+}
+
+std::vector<GnssInsEpoch> runGnssIns(const ImuData& imuData, const GnssData& gnssData, const InsState& initial,
+                                     const GnssInsOptions& options) {
+    std::vector<size_t> usable = usableGnssEpochs(imuData, gnssData, initial, options);
+    std::vector<GnssInsEpoch> epochs;
+    epochs.reserve(usable.size());
+    GnssInsFilter filter(initial, options);
+    size_t next = 0;
+    for (size_t k : usable) {
+        double time = gnssData.time[k] + options.timeOffset;
+        next = filter.predict(imuData, next, time);
+
+        GnssInsEpoch epoch;
+        epoch.time = gnssData.time[k];
+        epoch.fix = gnssData.fix[k];
+        epoch.update = filter.update(vec3(gnssData.x[k], gnssData.y[k], gnssData.z[k]), epoch.fix, time);
+        epoch.state = filter.state();
+        epoch.gyroBias = filter.gyroBias();
+        epoch.accelBias = filter.accelBias();
+        epoch.positionSigma = filter.positionSigma();
+        epochs.push_back(epoch);
+    }
+    return epochs;
+}
+
+std::string getLogStream(const std::vector<GnssInsEpoch>& epochs) {
+    // Por status: 0 = fix, 1 = float, 2 = outros
+    size_t used[3] = {0, 0, 0};
+    size_t rejected[3] = {0, 0, 0};
+    double sumSquares[3] = {0.0, 0.0, 0.0};
+    for (const GnssInsEpoch& e : epochs) {
+        size_t c = e.fix == 1 ? 0 : (e.fix == 2 ? 1 : 2);
+        if (e.update.accepted) {
+            ++used[c];
+            sumSquares[c] += dot(e.update.innovation, e.update.innovation);
+        } else {
+            ++rejected[c];
+        }
+    }
+
+    const char* names[] = {"Fix", "Float", "Other"};
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(4);
+    oss << "GNSS/INS epochs: " << epochs.size() << "\n";
+    for (size_t c = 0; c < 3; ++c) {
+        oss << names[c] << ": " << used[c] << " updates, " << rejected[c] << " not used";
+        if (used[c] > 0) {
+            oss << ", innovation RMS " << std::sqrt(sumSquares[c] / used[c]) << " m";
+        }
+        oss << "\n";
+    }
+    if (!epochs.empty()) {
+        const GnssInsEpoch& last = epochs.back();
+        oss << "Final position sigma: " << norm(last.positionSigma) << " m\n";
+        oss << "Final gyro bias: " << norm(last.gyroBias) / degreesToRadians * 3600.0 << " deg/h, accel bias: "
+            << norm(last.accelBias) / standardGravity * 1000.0 << " mg\n";
+    }
+    oss << "\n";
+    return oss.str();
+}
@@ -0,0 +1,185 @@
+#ifndef GNSS_INS_FILTER_HPP
+#define GNSS_INS_FILTER_HPP
+
+#include <vector>
+#include <string>
+#include <cstddef>
+#include "fixedMatrix.hpp"
+#include "strapdownIns.hpp"
+#include "imuData.hpp"
+#include "gnssData.hpp"
+
+// Índices do vetor de erro (verdadeiro menos estimado)
+constexpr size_t errorPosition = 0; ///< ECEF position error (m)
+constexpr size_t errorVelocity = 3; ///< ECEF velocity error (m/s)
+constexpr size_t errorAttitude = 6; ///< Attitude error psi in ECEF: C_true = (I + [psi x]) C (rad)
+constexpr size_t errorAccelBias = 9; ///< Accelerometer bias error (m/s^2)
+constexpr size_t errorGyroBias = 12; ///< Gyroscope bias error (rad/s)
+constexpr size_t numErrorStates = 15;
+
+using ErrorCovariance = Matrix<numErrorStates, numErrorStates>;
+
+/**
+ * @brief Options of the loosely coupled GNSS/INS filter.
+ *
+ * The noise densities are continuous-time (the Allan analysis of a static log
+ * gives them: angle and velocity random walk for the sensor noise, rate random
+ * walk for the bias noise).
+ */
+struct GnssInsOptions {
+    StrapdownOptions strapdown; ///< Options of the mechanization
+    double timeOffset = 0.0; ///< IMU clock minus GNSS time: an epoch at GNSS time t is at t + timeOffset on the IMU clock (s)
+    Vec3 leverArm{}; ///< Position of the GNSS antenna in the body frame (m)
+    double fixSigma = 0.02; ///< Position standard deviation per axis of fixed solutions, fix = 1 (m)
+    double floatSigma = 0.3; ///< Position standard deviation per axis of float solutions, fix = 2 (m)
+    double otherSigma = 0.0; ///< Position standard deviation per axis of other solutions (m, 0 = not used)
+    double innovationGate = 0.0; ///< Rejects updates whose normalized innovation squared exceeds it (0 = none)
+    double covarianceInterval = 0.05; ///< Longest interval of one covariance propagation (s)
+    double gyroNoise = 1e-4; ///< Gyroscope angle random walk (rad/sqrt(s))
+    double accelNoise = 1e-3; ///< Accelerometer velocity random walk (m/s/sqrt(s))
+    double gyroBiasNoise = 1e-6; ///< Gyroscope bias random walk (rad/s/sqrt(s))
+    double accelBiasNoise = 1e-4; ///< Accelerometer bias random walk (m/s^2/sqrt(s))
+    double initialPositionSigma = 1.0; ///< m
+    double initialVelocitySigma = 0.1; ///< m/s
+    double initialAttitudeSigma = 0.02; ///< rad
+    double initialAccelBiasSigma = 0.05; ///< m/s^2
+    double initialGyroBiasSigma = 1e-3; ///< rad/s
+};
+
+/**
+ * @brief Result of one GNSS position update.
+ */
+struct GnssUpdate {
+    Vec3 innovation{}; ///< Measured minus predicted antenna position (m)
+    double normalizedInnovation = 0.0; ///< Innovation squared, normalized by its covariance
+    double sigma = 0.0; ///< Standard deviation per axis used for the measurement (m)
+    bool accepted = false; ///< False if the fix status is not used or the gate rejected it
+};
+
+/**
+ * @brief Loosely coupled error-state EKF fusing GNSS positions into the strapdown INS.
+ *
+ * The 15 error states (position, velocity, attitude, accelerometer and
+ * gyroscope biases) are resolved in ECEF. The mechanization runs at the IMU
+ * rate with the estimated biases removed; the error covariance is propagated
+ * with a first-order transition matrix at most every covarianceInterval
+ * seconds, using the mean specific force of the interval. A GNSS position is
+ * weighted by its fix status (fixSigma, floatSigma or otherSigma) and is
+ * compared with the INS position extrapolated to the epoch and moved to the
+ * antenna by the lever arm. After an update the errors are fed back into the
+ * state and the biases.
+ *
+ * All matrices have compile-time size and live on the stack: predict and
+ * update do not allocate.
+ */
+class GnssInsFilter {
+public:
+    /**
+     * @param initial The initial state; its time must be at or just before the first IMU sample used.
+     * @param options The filter options (they also set the initial covariance).
+     */
+    explicit GnssInsFilter(const InsState& initial, const GnssInsOptions& options = GnssInsOptions());
+
+    /**
+     * @brief Propagates over the IMU samples from first whose timestamps are not later than time.
+     *
+     * @param imuData The IMU data.
+     * @param first The first sample to use.
+     * @param time The time to propagate to, on the IMU clock (s).
+     * @return size_t The index of the first sample not used.
+     */
+    size_t predict(const ImuData& imuData, size_t first, double time);
+
+    /**
+     * @brief Propagates over one covariance interval: the samples from first, up to
+     *        covarianceInterval seconds after the state (at least one) and not later than time.
+     *
+     * predict is a loop over it; the smoother uses it to stop after every interval.
+     *
+     * @return size_t The index of the first sample not used.
+     */
+    size_t predictStep(const ImuData& imuData, size_t first, double time);
+
+    /**
+     * @brief Transition matrix Phi of the error states over the last covariance interval.
+     */
+    ErrorCovariance transition() const;
+
+    /**
+     * @brief Updates the state with a GNSS antenna position.
+     *
+     * @param position The ECEF antenna position (m).
+     * @param fix The fix status (1 = fix, 2 = float).
+     * @param time The time of the position on the IMU clock (s), at or shortly after the state.
+     * @return GnssUpdate The innovation and whether it was used.
+     */
+    GnssUpdate update(const Vec3& position, int fix, double time);
+
+    const InsState& state() const { return ins_.state(); }
+    const Vec3& gyroBias() const { return ins_.gyroBias(); }
+    const Vec3& accelBias() const { return ins_.accelBias(); }
+    const ErrorCovariance& covariance() const { return covariance_; }
+    void setCovariance(const ErrorCovariance& covariance) { covariance_ = covariance; }
+    const GnssInsOptions& options() const { return options_; }
+
+    /**
+     * @brief Standard deviation of the position (m) per ECEF axis.
+     */
+    Vec3 positionSigma() const;
+
+private:
+    // Blocos não triviais da matriz de transição de primeira ordem I + F dt
+    struct TransitionBlocks {
+        double dt = 0.0;
+        Mat3 velocityPosition{}, velocityVelocity{}, velocityAttitude{}, velocityAccelBias{};
+        Mat3 attitudeAttitude{}, attitudeGyroBias{};
+    };
+
+    static ErrorCovariance applyTransition(const TransitionBlocks& phi, const ErrorCovariance& m);
+    void propagateCovariance(double dt, const Vec3& meanForce);
+
+    GnssInsOptions options_;
+    StrapdownIns ins_;
+    ErrorCovariance covariance_;
+    TransitionBlocks transition_;
+};
+
+/**
+ * @brief Filter output at one GNSS epoch.
+ */
+struct GnssInsEpoch {
+    double time = 0.0; ///< GNSS time of the epoch (GPST, s)
+    int fix = 0; ///< Fix status of the epoch
+    GnssUpdate update; ///< The update made at the epoch
+    InsState state; ///< State after the update (time on the IMU clock)
+    Vec3 gyroBias{}; ///< Estimated gyroscope bias after the update (rad/s)
+    Vec3 accelBias{}; ///< Estimated accelerometer bias after the update (m/s^2)
+    Vec3 positionSigma{}; ///< Position standard deviation after the update (m)
+};
+
+/**
+ * @brief Gets the indices of the GNSS epochs that fall inside the IMU data, after the initial state.
+ */
+std::vector<size_t> usableGnssEpochs(const ImuData& imuData, const GnssData& gnssData, const InsState& initial,
+                                     const GnssInsOptions& options);
+
+/**
+ * @brief Runs the filter over a whole flight.
+ *
+ * The GNSS epochs outside the IMU data (see usableGnssEpochs) are skipped.
+ *
+ * @param imuData The IMU data.
+ * @param gnssData The GNSS data, with ECEF positions and fix status.
+ * @param initial The initial state, at or just before the first IMU sample used.
+ * @param options The filter options.
+ * @return std::vector<GnssInsEpoch> One entry per GNSS epoch processed.
+ */
+std::vector<GnssInsEpoch> runGnssIns(const ImuData& imuData, const GnssData& gnssData, const InsState& initial,
+                                     const GnssInsOptions& options = GnssInsOptions());
+
+/**
+ * @brief Summarizes a filter run: updates used per fix status and innovation RMS.
+ */
+std::string getLogStream(const std::vector<GnssInsEpoch>& epochs);
+
+#endif // GNSS_INS_FILTER_HPP
@@ -0,0 +1,185 @@
+#include "gnssInsSmoother.hpp"
+#include <algorithm>
+#include <cmath>
+#include "workStealingPool.hpp"
+
+namespace {
+
+using ErrorVector = Matrix<numErrorStates, 1>;
+
+// Estado nominal do filtro (o que as correções de erro modificam)
+struct Nominal {
+    InsState state;
+    Vec3 gyroBias{};
+    Vec3 accelBias{};
+};
+
+Nominal nominalOf(const GnssInsFilter& filter) {
+    return Nominal{filter.state(), filter.gyroBias(), filter.accelBias()};
+}
+
+// Erro de b em relação a a (b = a + erro), na convenção do filtro
+ErrorVector difference(const Nominal& a, const Nominal& b) {
+    ErrorVector dx;
+    setBlock(dx, errorPosition, 0, b.state.position - a.state.position);
+    setBlock(dx, errorVelocity, 0, b.state.velocity - a.state.velocity);
+    setBlock(dx, errorAttitude, 0, rotationVectorFromQuaternion(b.state.attitude * conjugate(a.state.attitude)));
+    setBlock(dx, errorAccelBias, 0, b.accelBias - a.accelBias);
+    setBlock(dx, errorGyroBias, 0, b.gyroBias - a.gyroBias);
+    return dx;
+}
+
+// Aplica um erro como a atualização do filtro
+Nominal correct(Nominal n, const ErrorVector& dx) {
+    n.state.position += block<3, 1>(dx, errorPosition, 0);
+    n.state.velocity += block<3, 1>(dx, errorVelocity, 0);
+    n.state.attitude = normalize(quaternionFromRotationVector(block<3, 1>(dx, errorAttitude, 0)) * n.state.attitude);
+    n.accelBias += block<3, 1>(dx, errorAccelBias, 0);
+    n.gyroBias += block<3, 1>(dx, errorGyroBias, 0);
+    return n;
+}
+
+// Um intervalo de covariância recalculado
+struct Step {
+    Nominal filtered; // No início do intervalo (depois da atualização, se houve)
+    Nominal predicted; // No fim do intervalo, antes de qualquer atualização
+    ErrorCovariance covariance;
+    ErrorCovariance predictedCovariance;
+    ErrorCovariance gain; // C_k
+};
+
+struct Checkpoint {
+    GnssInsFilter filter;
+    size_t nextSample; // Primeira amostra do IMU ainda não usada
+    size_t firstEpoch; // Posição em epochs da primeira época do segmento
+    size_t firstStep; // Índice global do primeiro intervalo do segmento
+};
+
+// Leva o filtro pelas épocas [begin, end) de epochs. Conta os intervalos e, se steps
+// não for nulo, guarda cada um; se output não for nulo, guarda a saída de cada época.
+size_t runEpochs(GnssInsFilter& filter, size_t& next, const ImuData& imuData, const GnssData& gnssData,
+                 const std::vector<size_t>& epochs, size_t begin, size_t end, std::vector<Step>* steps,
+                 std::vector<GnssInsEpoch>* output) {
+    const size_t numSamples = imuData.timeStamp.size();
+    const double timeOffset = filter.options().timeOffset;
+    size_t count = 0;
+    for (size_t e = begin; e < end; ++e) {
+        size_t k = epochs[e];
+        double time = gnssData.time[k] + timeOffset;
+        while (next < numSamples && imuData.timeStamp[next] <= time) {
+            if (steps) {
+                steps->emplace_back();
+                Step& step = steps->back();
+                step.filtered = nominalOf(filter);
+                step.covariance = filter.covariance();
+                next = filter.predictStep(imuData, next, time);
+                step.predicted = nominalOf(filter);
+                step.predictedCovariance = filter.covariance();
+                // C' = P_{k+1|k}^-1 Phi P_k (as covariâncias são simétricas)
+                step.gain = transpose(solveSymmetric(step.predictedCovariance, filter.transition() * step.covariance));
+            } else {
+                next = filter.predictStep(imuData, next, time);
+            }
+            ++count;
+        }
+
+        GnssUpdate update = filter.update(vec3(gnssData.x[k], gnssData.y[k], gnssData.z[k]), gnssData.fix[k], time);
+        if (output) {
+            GnssInsEpoch epoch;
+            epoch.time = gnssData.time[k];
+            epoch.fix = gnssData.fix[k];
+            epoch.update = update;
+            epoch.state = filter.state();
+            epoch.gyroBias = filter.gyroBias();
+            epoch.accelBias = filter.accelBias();
+            epoch.positionSigma = filter.positionSigma();
+            output->push_back(epoch);
+        }
+    }
+    return count;
+}
+
+SmoothedState smoothedState(const Nominal& n, const ErrorCovariance& p) {
+    SmoothedState s;
+    s.state = n.state;
+    s.gyroBias = n.gyroBias;
+    s.accelBias = n.accelBias;
+    for (size_t i = 0; i < 3; ++i) {
+        s.positionSigma[i] = std::sqrt(p(errorPosition + i, errorPosition + i));
+        s.velocitySigma[i] = std::sqrt(p(errorVelocity + i, errorVelocity + i));
+        s.attitudeSigma[i] = std::sqrt(p(errorAttitude + i, errorAttitude + i));
+    }
+    return s;
+}
+
+} // namespace
+
+SmoothedTrajectory smoothGnssIns(const ImuData& imuData, const GnssData& gnssData, const InsState& initial,
+                                 const GnssInsOptions& options, const SmootherOptions& smootherOptions) {
+    SmoothedTrajectory result;
+    std::vector<size_t> epochs = usableGnssEpochs(imuData, gnssData, initial, options);
+    const size_t every = std::max<size_t>(smootherOptions.checkpointEvery, 1);
+
+    // Passo direto: só uma cópia do filtro a cada checkpointEvery épocas
+    std::vector<Checkpoint> checkpoints;
+    checkpoints.reserve(epochs.size() / every + 1);
+    result.epochs.reserve(epochs.size());
+    GnssInsFilter filter(initial, options);
+    size_t next = 0;
+    size_t numSteps = 0;
+    for (size_t begin = 0; begin < epochs.size(); begin += every) {
+        checkpoints.push_back(Checkpoint{filter, next, begin, numSteps});
+        numSteps += runEpochs(filter, next, imuData, gnssData, epochs, begin, std::min(begin + every, epochs.size()),
+                              nullptr, &result.epochs);
+    }
+    result.numCheckpoints = checkpoints.size();
+    result.checkpointBytes = checkpoints.size() * sizeof(Checkpoint);
+
+    // O último nó suavizado é o último filtrado
+    result.states.resize(numSteps + 1);
+    Nominal smoothed = nominalOf(filter);
+    ErrorCovariance smoothedCovariance = filter.covariance();
+    result.states[numSteps] = smoothedState(smoothed, smoothedCovariance);
+
+    // Passo reverso, em lotes de segmentos recalculados em paralelo
+    WorkStealingPool pool(smootherOptions.numThreads);
+    size_t batch = smootherOptions.segmentsPerBatch ? smootherOptions.segmentsPerBatch : 8 * pool.numThreads();
+    for (size_t high = checkpoints.size(); high > 0;) {
+        size_t low = high > batch ? high - batch : 0;
+        std::vector<std::vector<Step>> segments(high - low);
+        for (size_t c = low; c < high; ++c) {
+            pool.submit([&, c]() {
+                const Checkpoint& checkpoint = checkpoints[c];
+                GnssInsFilter segmentFilter = checkpoint.filter;
+                size_t segmentNext = checkpoint.nextSample;
+                size_t end = c + 1 < checkpoints.size() ? checkpoints[c + 1].firstEpoch : epochs.size();
+                std::vector<Step>& steps = segments[c - low];
+                steps.reserve((c + 1 < checkpoints.size() ? checkpoints[c + 1].firstStep : numSteps) -
+                              checkpoint.firstStep);
+                runEpochs(segmentFilter, segmentNext, imuData, gnssData, epochs, checkpoint.firstEpoch, end, &steps,
+                          nullptr);
+            });
+        }
+        pool.wait();
+
+        size_t bytes = 0;
+        for (const std::vector<Step>& steps : segments) {
+            bytes += steps.capacity() * sizeof(Step);
+        }
+        result.peakSegmentBytes = std::max(result.peakSegmentBytes, bytes);
+
+        for (size_t c = high; c-- > low;) {
+            const std::vector<Step>& steps = segments[c - low];
+            for (size_t k = steps.size(); k-- > 0;) {
+                const Step& step = steps[k];
+                smoothed = correct(step.filtered, step.gain * difference(step.predicted, smoothed));
+                ErrorCovariance p = step.covariance +
+                                    step.gain * (smoothedCovariance - step.predictedCovariance) * transpose(step.gain);
+                smoothedCovariance = 0.5 * (p + transpose(p));
+                result.states[checkpoints[c].firstStep + k] = smoothedState(smoothed, smoothedCovariance);
+            }
+        }
+        high = low;
+    }
+    return result;
+}
@@ -0,0 +1,74 @@
+#ifndef GNSS_INS_SMOOTHER_HPP
+#define GNSS_INS_SMOOTHER_HPP
+
+#include <vector>
+#include <cstddef>
+#include "gnssInsFilter.hpp"
+
+/**
+ * @brief Options of the checkpointed smoother.
+ */
+struct SmootherOptions {
+    size_t checkpointEvery = 5; ///< GNSS epochs between stored filter states (memory against recomputation)
+    size_t segmentsPerBatch = 0; ///< Segments recomputed together in the backward pass (0 = 8 per thread)
+    unsigned numThreads = 0; ///< Worker threads (0 = all hardware threads)
+};
+
+/**
+ * @brief Smoothed navigation solution at one node (the end of a covariance interval).
+ */
+struct SmoothedState {
+    InsState state; ///< Smoothed state (time on the IMU clock)
+    Vec3 gyroBias{}; ///< Smoothed gyroscope bias (rad/s)
+    Vec3 accelBias{}; ///< Smoothed accelerometer bias (m/s^2)
+    Vec3 positionSigma{}; ///< Smoothed position standard deviation per ECEF axis (m)
+    Vec3 velocitySigma{}; ///< Smoothed velocity standard deviation (m/s)
+    Vec3 attitudeSigma{}; ///< Smoothed attitude standard deviation (rad)
+};
+
+/**
+ * @brief Output of the smoother.
+ */
+struct SmoothedTrajectory {
+    std::vector<SmoothedState> states; ///< One per covariance interval plus the initial state, in time order
+    std::vector<GnssInsEpoch> epochs; ///< Forward filter output at the GNSS epochs
+    size_t numCheckpoints = 0; ///< Filter states stored by the forward pass
+    size_t checkpointBytes = 0; ///< Memory of those states
+    size_t peakSegmentBytes = 0; ///< Largest memory of the segments recomputed at once
+};
+
+/**
+ * @brief Forward GNSS/INS filter plus Rauch-Tung-Striebel backward pass, with bounded memory.
+ *
+ * The forward pass is runGnssIns, except that it only keeps a copy of the
+ * filter every checkpointEvery GNSS epochs. The backward pass takes the
+ * segments between checkpoints from the last to the first, segmentsPerBatch
+ * at a time: the segments of a batch are recomputed from their checkpoints in
+ * parallel (the recomputation is the same code, so it reproduces the forward
+ * pass exactly), keeping for every covariance interval k the filtered and
+ * predicted states and covariances and the smoother gain
+ * C_k = P_k Phi_k' P_{k+1|k}^-1, and then the RTS recursion
+ *
+ *   dx_k = C_k (x_{k+1}^s - x_{k+1|k}),  x_k^s = x_k + dx_k,
+ *   P_k^s = P_k + C_k (P_{k+1}^s - P_{k+1|k}) C_k'
+ *
+ * runs over them sequentially. The memory is that of the checkpoints (about
+ * 3 KB each) plus one batch of segments (about 6 KB per covariance interval),
+ * instead of the covariances of the whole flight (a segment spans
+ * checkpointEvery epochs, so a GNSS outage makes its segment longer); the
+ * result does not depend on checkpointEvery, segmentsPerBatch or the number
+ * of threads.
+ *
+ * @param imuData The IMU data.
+ * @param gnssData The GNSS data, with ECEF positions and fix status.
+ * @param initial The initial state, at or just before the first IMU sample used.
+ * @param options The filter options.
+ * @param smootherOptions The checkpoint and parallelism options.
+ * @return SmoothedTrajectory The smoothed states up to the last GNSS epoch and the forward filter output.
+ * @throws std::runtime_error If a predicted covariance is not positive definite.
+ */
+SmoothedTrajectory smoothGnssIns(const ImuData& imuData, const GnssData& gnssData, const InsState& initial,
+                                 const GnssInsOptions& options = GnssInsOptions(),
+                                 const SmootherOptions& smootherOptions = SmootherOptions());
+
+#endif // GNSS_INS_SMOOTHER_HPP
@@ -0,0 +1,214 @@
+#include "imuPreintegration.hpp"
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "earthModel.hpp"
+#include "workStealingPool.hpp"
+
+namespace {
+
+using Matrix9 = Matrix<9, 9>;
+
+// Pré-integração em andamento de um intervalo
+struct Delta {
+    Quaternion rotation;
+    Vec3 velocity{};
+    Vec3 position{};
+    Matrix9 covariance{};
+    Mat3 rotationGyro{}, velocityAccel{}, velocityGyro{}, positionAccel{}, positionGyro{};
+};
+
+// Jacobiana à direita de SO(3): I - (1 - cos t) / t^2 [phi x] + (t - sin t) / t^3 [phi x]^2
+Mat3 rightJacobian(const Vec3& phi) {
+    double t2 = dot(phi, phi);
+    double a, b;
+    if (t2 < 1e-4) {
+        a = 0.5 - t2 / 24.0;
+        b = 1.0 / 6.0 - t2 / 120.0;
+    } else {
+        double t = std::sqrt(t2);
+        a = (1.0 - std::cos(t)) / t2;
+        b = (t - std::sin(t)) / (t2 * t);
+    }
+    Mat3 k = skew(phi);
+    return Mat3::identity() - a * k + b * (k * k);
+}
+
+// A * m, com A = [E 0 0; X I 0; X dt/2 dt I I] a transição do erro [dphi, dv, dp]
+Matrix9 applyTransition(const Mat3& e, const Mat3& x, double dt, const Matrix9& m) {
+    Matrix<3, 9> rotation = block<3, 9>(m, 0, 0);
+    Matrix<3, 9> velocity = block<3, 9>(m, 3, 0);
+    Matrix<3, 9> position = block<3, 9>(m, 6, 0);
+    Matrix<3, 9> xr = x * rotation;
+    Matrix9 out;
+    setBlock(out, 0, 0, e * rotation);
+    setBlock(out, 3, 0, xr + velocity);
+    setBlock(out, 6, 0, xr * (0.5 * dt) + velocity * dt + position);
+    return out;
+}
+
+// Integra dt segundos de taxas constantes (Forster et al., pré-integração em SO(3))
+void integrate(Delta& d, double dt, const Vec3& omega, const Vec3& accel, double gyroVariance, double accelVariance) {
+    Vec3 phi = omega * dt;
+    Quaternion step = quaternionFromRotationVector(phi);
+    Mat3 r = dcmFromQuaternion(d.rotation);
+    Mat3 e = transpose(dcmFromQuaternion(step));
+    Mat3 jr = rightJacobian(phi);
+    Mat3 ra = r * skew(accel);
+    Mat3 raRotationGyro = ra * d.rotationGyro;
+    double halfDt2 = 0.5 * dt * dt;
+
+    // Jacobianas dos vieses, com os valores do início do passo
+    d.positionAccel += d.velocityAccel * dt - r * halfDt2;
+    d.positionGyro += d.velocityGyro * dt - raRotationGyro * halfDt2;
+    d.velocityAccel -= r * dt;
+    d.velocityGyro -= raRotationGyro * dt;
+    d.rotationGyro = e * d.rotationGyro - jr * dt;
+
+    // A P A' = A (A P)', pois P é simétrica
+    Mat3 x = ra * -dt;
+    Matrix9 p = applyTransition(e, x, dt, transpose(applyTransition(e, x, dt, d.covariance)));
+    Mat3 gyroNoise = (jr * transpose(jr)) * (gyroVariance * dt);
+    for (size_t i = 0; i < 3; ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            p(i, j) += gyroNoise(i, j);
+        }
+        p(3 + i, 3 + i) += accelVariance * dt;
+        p(3 + i, 6 + i) += accelVariance * halfDt2;
+        p(6 + i, 3 + i) += accelVariance * halfDt2;
+        p(6 + i, 6 + i) += accelVariance * halfDt2 * dt * 0.5;
+    }
+    d.covariance = p;
+
+    Vec3 rotated = r * accel;
+    d.position += d.velocity * dt + rotated * halfDt2;
+    d.velocity += rotated * dt;
+    d.rotation = normalize(d.rotation * step);
+}
+
+void storeMatrix(std::vector<double>& column, size_t i, const double* m, size_t count) {
+    std::copy(m, m + count, column.begin() + i * count);
+}
+
+} // namespace
+
+void PreintegratedImu::resize(size_t numIntervals) {
+    for (std::vector<double>* c : {&startTime, &deltaTime, &qw, &qx, &qy, &qz, &dvx, &dvy, &dvz, &dpx, &dpy, &dpz}) {
+        c->resize(numIntervals);
+    }
+    numSamples.resize(numIntervals);
+    complete.resize(numIntervals);
+    covariance.resize(81 * numIntervals);
+    for (std::vector<double>* c : {&rotationGyro, &velocityAccel, &velocityGyro, &positionAccel, &positionGyro}) {
+        c->resize(9 * numIntervals);
+    }
+}
+
+Matrix<9, 9> PreintegratedImu::covarianceOf(size_t i) const {
+    Matrix<9, 9> m;
+    std::copy(covariance.begin() + 81 * i, covariance.begin() + 81 * (i + 1), m.m);
+    return m;
+}
+
+Mat3 PreintegratedImu::jacobian(const std::vector<double>& column, size_t i) const {
+    Mat3 m;
+    std::copy(column.begin() + 9 * i, column.begin() + 9 * (i + 1), m.m);
+    return m;
+}
+
+PreintegratedImu preintegrateImu(const ImuData& imuData, const std::vector<double>& epochTimes,
+                                 const PreintegrationOptions& options) {
+    for (size_t e = 1; e < epochTimes.size(); ++e) {
+        if (!(epochTimes[e] > epochTimes[e - 1])) {
+            throw std::invalid_argument("Epoch times must be increasing.");
+        }
+    }
+    PreintegratedImu result;
+    if (epochTimes.size() < 2) {
+        return result;
+    }
+    const size_t numIntervals = epochTimes.size() - 1;
+    result.resize(numIntervals);
+
+    // Caminhada única pelas duas sequências: primeira amostra depois de cada época
+    const double* t = imuData.timeStamp.data();
+    const size_t n = imuData.timeStamp.size();
+    std::vector<size_t> firstSample(epochTimes.size());
+    size_t j = 0;
+    for (size_t e = 0; e < epochTimes.size(); ++e) {
+        while (j < n && t[j] <= epochTimes[e]) {
+            ++j;
+        }
+        firstSample[e] = j;
+    }
+
+    const double gyroVariance = options.gyroNoise * options.gyroNoise;
+    const double accelVariance = options.accelNoise * options.accelNoise;
+    auto integrateInterval = [&](size_t i) {
+        double t0 = epochTimes[i], t1 = epochTimes[i + 1];
+        Delta d;
+        bool complete = firstSample[i] > 0 && firstSample[i] < n;
+        size_t count = 0;
+        // Cada amostra vale de t[s - 1] até t[s]; a primeira amostra do log não tem começo
+        for (size_t s = std::max<size_t>(firstSample[i], 1); s < n && t[s - 1] < t1; ++s) {
+            if (t[s] - t[s - 1] > options.maxGap) {
+                complete = false;
+            }
+            double dt = std::min(t[s], t1) - std::max(t[s - 1], t0);
+            if (dt > 0.0) {
+                Vec3 omega = vec3(imuData.gx[s], imuData.gy[s], imuData.gz[s]) * degreesToRadians - options.gyroBias;
+                Vec3 accel = vec3(imuData.accx[s], imuData.accy[s], imuData.accz[s]) * standardGravity -
+                             options.accelBias;
+                integrate(d, dt, omega, accel, gyroVariance, accelVariance);
+                ++count;
+            }
+        }
+        if (n == 0 || t[n - 1] < t1) {
+            complete = false;
+        }
+
+        result.startTime[i] = t0;
+        result.deltaTime[i] = t1 - t0;
+        result.numSamples[i] = count;
+        result.complete[i] = complete ? 1 : 0;
+        result.qw[i] = d.rotation.w;
+        result.qx[i] = d.rotation.x;
+        result.qy[i] = d.rotation.y;
+        result.qz[i] = d.rotation.z;
+        result.dvx[i] = d.velocity[0];
+        result.dvy[i] = d.velocity[1];
+        result.dvz[i] = d.velocity[2];
+        result.dpx[i] = d.position[0];
+        result.dpy[i] = d.position[1];
+        result.dpz[i] = d.position[2];
+        storeMatrix(result.covariance, i, d.covariance.m, 81);
+        storeMatrix(result.rotationGyro, i, d.rotationGyro.m, 9);
+        storeMatrix(result.velocityAccel, i, d.velocityAccel.m, 9);
+        storeMatrix(result.velocityGyro, i, d.velocityGyro.m, 9);
+        storeMatrix(result.positionAccel, i, d.positionAccel.m, 9);
+        storeMatrix(result.positionGyro, i, d.positionGyro.m, 9);
+    };
+
+    // Blocos de intervalos por tarefa; cada intervalo escreve só as suas posições
+    WorkStealingPool pool(options.numThreads);
+    const size_t chunk = std::max<size_t>(1, numIntervals / (16 * pool.numThreads()));
+    for (size_t begin = 0; begin < numIntervals; begin += chunk) {
+        size_t end = std::min(begin + chunk, numIntervals);
+        pool.submit([&, begin, end]() {
+            for (size_t i = begin; i < end; ++i) {
+                integrateInterval(i);
+            }
+        });
+    }
+    pool.wait();
+    return result;
+}
+
+PreintegratedImu preintegrateImu(const ImuData& imuData, const GnssData& gnssData,
+                                 const PreintegrationOptions& options) {
+    std::vector<double> epochTimes(gnssData.time.size());
+    for (size_t k = 0; k < epochTimes.size(); ++k) {
+        epochTimes[k] = gnssData.time[k] + options.timeOffset;
+    }
+    return preintegrateImu(imuData, epochTimes, options);
+}
@@ -0,0 +1,98 @@
+#ifndef IMU_PREINTEGRATION_HPP
+#define IMU_PREINTEGRATION_HPP
+
+#include <vector>
+#include <cstddef>
+#include "fixedMatrix.hpp"
+#include "quaternion.hpp"
+#include "imuData.hpp"
+#include "gnssData.hpp"
+
+/**
+ * @brief Options of the IMU preintegration.
+ */
+struct PreintegrationOptions {
+    Vec3 gyroBias{}; ///< Gyroscope bias removed before integrating, the linearization point (rad/s)
+    Vec3 accelBias{}; ///< Accelerometer bias removed before integrating (m/s^2)
+    double gyroNoise = 1e-4; ///< Gyroscope angle random walk (rad/sqrt(s))
+    double accelNoise = 1e-3; ///< Accelerometer velocity random walk (m/s/sqrt(s))
+    double timeOffset = 0.0; ///< IMU clock minus GNSS time (s), as in GnssInsOptions
+    double maxGap = 0.1; ///< Longer intervals between IMU samples mark the preintegration incomplete (s)
+    unsigned numThreads = 0; ///< Worker threads (0 = all hardware threads)
+};
+
+/**
+ * @brief IMU measurements preintegrated between consecutive epochs, one column per interval.
+ *
+ * Interval i goes from epoch i to epoch i + 1. The deltas are in the body frame
+ * at the start of the interval and exclude gravity and the Earth rotation, as
+ * usual in optimization back ends:
+ *
+ *   R_j = R_i dR,  v_j = v_i + g dt + R_i dv,  p_j = p_i + v_i dt + g dt^2 / 2 + R_i dp.
+ *
+ * The covariance is that of the error [dphi, dv, dp] (rotation error dR Exp(dphi)),
+ * and the bias Jacobians give the first-order correction for a change of the
+ * biases db from the linearization point:
+ *
+ *   dR(b) = dR Exp(J_R,g dbg),  dv(b) = dv + J_v,a dba + J_v,g dbg,  dp(b) = dp + J_p,a dba + J_p,g dbg.
+ *
+ * Each column is a separate array; the matrices of an interval are stored
+ * row-major and contiguous (81 doubles for the covariance, 9 for each Jacobian).
+ */
+struct PreintegratedImu {
+    std::vector<double> startTime; ///< Start of the interval on the IMU clock (s)
+    std::vector<double> deltaTime; ///< Length of the interval (s)
+    std::vector<size_t> numSamples; ///< IMU samples overlapping the interval
+    std::vector<unsigned char> complete; ///< 0 if the IMU data does not cover the interval or has a gap in it
+    std::vector<double> qw, qx, qy, qz; ///< Delta rotation dR as a quaternion
+    std::vector<double> dvx, dvy, dvz; ///< Delta velocity (m/s)
+    std::vector<double> dpx, dpy, dpz; ///< Delta position (m)
+    std::vector<double> covariance; ///< 9x9 covariance of [dphi, dv, dp] per interval
+    std::vector<double> rotationGyro; ///< J_R,g per interval
+    std::vector<double> velocityAccel; ///< J_v,a per interval
+    std::vector<double> velocityGyro; ///< J_v,g per interval
+    std::vector<double> positionAccel; ///< J_p,a per interval
+    std::vector<double> positionGyro; ///< J_p,g per interval
+
+    size_t size() const { return deltaTime.size(); } ///< Number of intervals
+    void resize(size_t numIntervals);
+
+    Quaternion deltaRotation(size_t i) const { return Quaternion{qw[i], qx[i], qy[i], qz[i]}; }
+    Vec3 deltaVelocity(size_t i) const { return vec3(dvx[i], dvy[i], dvz[i]); }
+    Vec3 deltaPosition(size_t i) const { return vec3(dpx[i], dpy[i], dpz[i]); }
+    Matrix<9, 9> covarianceOf(size_t i) const;
+    Mat3 jacobian(const std::vector<double>& column, size_t i) const; ///< E.g. jacobian(velocityGyro, i)
+};
+
+/**
+ * @brief Preintegrates the IMU samples between consecutive epochs.
+ *
+ * The rates of a sample are taken as constant over the interval between the
+ * previous sample and it, and an epoch inside that interval splits it between
+ * the two GNSS intervals, so no IMU data is lost or counted twice. Each step is
+ * integrated as the strapdown mechanization without coning and sculling
+ * compensation (the rotation exactly, velocity and position with the rotation
+ * at the start of the step), so the preintegrations of adjacent intervals
+ * compose exactly into that of their union when the epoch falls on a sample.
+ * The samples are assigned to the intervals by one merge walk over both time
+ * lines; the intervals are then integrated in parallel, each writing only its
+ * own columns.
+ *
+ * @param imuData The IMU data.
+ * @param epochTimes The epochs on the IMU clock, increasing.
+ * @param options The preintegration options (options.timeOffset is ignored).
+ * @return PreintegratedImu One interval per pair of consecutive epochs.
+ * @throws std::invalid_argument If the epochs are not increasing.
+ */
+PreintegratedImu preintegrateImu(const ImuData& imuData, const std::vector<double>& epochTimes,
+                                 const PreintegrationOptions& options = PreintegrationOptions());
+
+/**
+ * @brief Preintegrates the IMU samples between consecutive GNSS epochs.
+ *
+ * The epochs are gnssData.time + options.timeOffset.
+ */
+PreintegratedImu preintegrateImu(const ImuData& imuData, const GnssData& gnssData,
+                                 const PreintegrationOptions& options = PreintegrationOptions());
+
+#endif // IMU_PREINTEGRATION_HPP
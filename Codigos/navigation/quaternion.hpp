@@ -0,0 +1,116 @@
+#ifndef QUATERNION_HPP
+#define QUATERNION_HPP
+
+#include <cmath>
+#include "fixedMatrix.hpp"
+
+/**
+ * @brief Unit quaternion (Hamilton convention, scalar first) of a frame rotation.
+ *
+ * A quaternion q_b^e represents the rotation from frame b to frame e:
+ * rotate(q_b^e, v_b) = v_e, and q_b^e * q_c^b = q_c^e.
+ */
+struct Quaternion {
+    double w = 1.0;
+    double x = 0.0;
+    double y = 0.0;
+    double z = 0.0;
+};
+
+inline Quaternion operator*(const Quaternion& a, const Quaternion& b) {
+    return Quaternion{a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+                      a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                      a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+                      a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w};
+}
+
+inline Quaternion conjugate(const Quaternion& q) {
+    return Quaternion{q.w, -q.x, -q.y, -q.z};
+}
+
+/**
+ * @brief Scales the quaternion back to unit norm, with the scalar part non-negative.
+ */
+inline Quaternion normalize(const Quaternion& q) {
+    double s = 1.0 / std::sqrt(q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z);
+    if (q.w < 0.0) {
+        s = -s;
+    }
+    return Quaternion{q.w * s, q.x * s, q.y * s, q.z * s};
+}
+
+/**
+ * @brief Quaternion of the rotation by the angle |phi| (rad) about the axis phi.
+ */
+inline Quaternion quaternionFromRotationVector(const Vec3& phi) {
+    double angle2 = dot(phi, phi);
+    double c, s;
+    if (angle2 < 1e-4) {
+        // Séries de cos(a/2) e sin(a/2)/a; para a < 0.01 rad (o incremento típico
+        // a 2 kHz) o primeiro termo omitido é menor que 1e-16
+        c = 1.0 - angle2 / 8.0 * (1.0 - angle2 / 48.0);
+        s = 0.5 - angle2 / 48.0 * (1.0 - angle2 / 80.0);
+    } else {
+        double angle = std::sqrt(angle2);
+        c = std::cos(0.5 * angle);
+        s = std::sin(0.5 * angle) / angle;
+    }
+    return Quaternion{c, s * phi[0], s * phi[1], s * phi[2]};
+}
+
+/**
+ * @brief Rotation vector (rad) of a unit quaternion, with angle in [0, pi].
+ */
+inline Vec3 rotationVectorFromQuaternion(const Quaternion& q) {
+    Quaternion p = q.w < 0.0 ? Quaternion{-q.w, -q.x, -q.y, -q.z} : q;
+    double s = std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
+    double scale = s < 1e-12 ? 2.0 / p.w : 2.0 * std::atan2(s, p.w) / s;
+    return vec3(scale * p.x, scale * p.y, scale * p.z);
+}
+
+/**
+ * @brief Direction cosine matrix C_b^e of q_b^e (v_e = C * v_b).
+ */
+inline Mat3 dcmFromQuaternion(const Quaternion& q) {
+    double ww = q.w * q.w, xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    double xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    double wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+    return Mat3{{ww + xx - yy - zz, 2.0 * (xy - wz), 2.0 * (xz + wy),
+                 2.0 * (xy + wz), ww - xx + yy - zz, 2.0 * (yz - wx),
+                 2.0 * (xz - wy), 2.0 * (yz + wx), ww - xx - yy + zz}};
+}
+
+/**
+ * @brief Quaternion of an orthonormal direction cosine matrix (Shepperd's method).
+ */
+inline Quaternion quaternionFromDcm(const Mat3& c) {
+    double trace = c(0, 0) + c(1, 1) + c(2, 2);
+    Quaternion q;
+    // Usa o maior dos quatro termos da diagonal para evitar cancelamento
+    if (trace >= c(0, 0) && trace >= c(1, 1) && trace >= c(2, 2)) {
+        double s = 2.0 * std::sqrt(1.0 + trace);
+        q = Quaternion{0.25 * s, (c(2, 1) - c(1, 2)) / s, (c(0, 2) - c(2, 0)) / s, (c(1, 0) - c(0, 1)) / s};
+    } else if (c(0, 0) >= c(1, 1) && c(0, 0) >= c(2, 2)) {
+        double s = 2.0 * std::sqrt(1.0 + c(0, 0) - c(1, 1) - c(2, 2));
+        q = Quaternion{(c(2, 1) - c(1, 2)) / s, 0.25 * s, (c(0, 1) + c(1, 0)) / s, (c(0, 2) + c(2, 0)) / s};
+    } else if (c(1, 1) >= c(2, 2)) {
+        double s = 2.0 * std::sqrt(1.0 - c(0, 0) + c(1, 1) - c(2, 2));
+        q = Quaternion{(c(0, 2) - c(2, 0)) / s, (c(0, 1) + c(1, 0)) / s, 0.25 * s, (c(1, 2) + c(2, 1)) / s};
+    } else {
+        double s = 2.0 * std::sqrt(1.0 - c(0, 0) - c(1, 1) + c(2, 2));
+        q = Quaternion{(c(1, 0) - c(0, 1)) / s, (c(0, 2) + c(2, 0)) / s, (c(1, 2) + c(2, 1)) / s, 0.25 * s};
+    }
+    return normalize(q);
+}
+
+/**
+ * @brief Rotates v by q (rotate(q_b^e, v_b) = v_e).
+ */
+inline Vec3 rotate(const Quaternion& q, const Vec3& v) {
+    // v + 2 w (u x v) + 2 u x (u x v), com u a parte vetorial
+    Vec3 u = vec3(q.x, q.y, q.z);
+    Vec3 t = 2.0 * cross(u, v);
+    return v + q.w * t + cross(u, t);
+}
+
+#endif // QUATERNION_HPP
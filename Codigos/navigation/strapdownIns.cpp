@@ -0,0 +1,124 @@
+#include "strapdownIns.hpp"
+#include <cmath>
+#include <algorithm>
+#include "earthModel.hpp"
+
+StrapdownIns::StrapdownIns(const InsState& initial, const StrapdownOptions& options)
+    : state_(initial), options_(options) {}
+
+void StrapdownIns::step(double dt, const Vec3& deltaAngle, const Vec3& deltaVelocity) {
+    Vec3 rotation = deltaAngle;
+    Vec3 velocityBody = deltaVelocity;
+    if (options_.sculling) {
+        // Rotação do corpo durante o intervalo
+        velocityBody += 0.5 * cross(deltaAngle, deltaVelocity);
+    }
+    if (hasPrevious_) {
+        if (options_.coning) {
+            rotation += (1.0 / 12.0) * cross(previousAngle_, deltaAngle);
+        }
+        if (options_.sculling) {
+            velocityBody += (1.0 / 12.0) * (cross(previousAngle_, deltaVelocity) + cross(previousVelocity_, deltaAngle));
+        }
+    }
+    previousAngle_ = deltaAngle;
+    previousVelocity_ = deltaVelocity;
+    hasPrevious_ = true;
+
+    // Incremento de velocidade em ECEF, com a atitude do início do intervalo
+    Vec3 velocityEcef = rotate(state_.attitude, velocityBody);
+    Vec3 acceleration{};
+    if (options_.gravity) {
+        acceleration = gravityEcef(state_.position);
+    }
+    const Vec3& v = state_.velocity;
+    if (options_.earthRotation) {
+        // Atitude média em relação a ECEF (a Terra gira wie * dt durante o intervalo) e Coriolis
+        double halfAngle = 0.5 * earthRotationRate * dt;
+        velocityEcef += vec3(halfAngle * velocityEcef[1], -halfAngle * velocityEcef[0], 0.0);
+        acceleration += vec3(2.0 * earthRotationRate * v[1], -2.0 * earthRotationRate * v[0], 0.0);
+    }
+    Vec3 velocity = v + velocityEcef + dt * acceleration;
+    state_.position += (0.5 * dt) * (v + velocity);
+    state_.velocity = velocity;
+
+    Quaternion attitude = state_.attitude * quaternionFromRotationVector(rotation);
+    if (options_.earthRotation) {
+        if (dt != earthDt_) {
+            earthDt_ = dt;
+            earthRotation_ = quaternionFromRotationVector(vec3(0.0, 0.0, -earthRotationRate * dt));
+        }
+        attitude = earthRotation_ * attitude;
+    }
+    state_.attitude = normalize(attitude);
+    state_.time += dt;
+}
+
+size_t StrapdownIns::propagate(const ImuData& imuData, size_t first, size_t last) {
+    last = std::min(last, imuData.timeStamp.size());
+    const double* time = imuData.timeStamp.data();
+    const double* gx = imuData.gx.data();
+    const double* gy = imuData.gy.data();
+    const double* gz = imuData.gz.data();
+    const double* accx = imuData.accx.data();
+    const double* accy = imuData.accy.data();
+    const double* accz = imuData.accz.data();
+
+    size_t count = 0;
+    for (size_t i = first; i < last; ++i) {
+        double dt = time[i] - state_.time;
+        if (!(dt > 0.0)) {
+            continue;
+        }
+        if (dt > options_.maxInterval) {
+            // Falha nos dados: os incrementos anteriores não são contíguos a este
+            hasPrevious_ = false;
+        }
+        Vec3 rate = vec3(gx[i], gy[i], gz[i]) * degreesToRadians - gyroBias_;
+        Vec3 force = vec3(accx[i], accy[i], accz[i]) * standardGravity - accelBias_;
+        step(dt, rate * dt, force * dt);
+        state_.time = time[i]; // Sem acumular o erro de arredondamento da soma dos dt
+        ++count;
+    }
+    return count;
+}
+
+namespace {
+
+// C_b^n de ângulos de Euler (Z-Y-X) em graus
+Mat3 nedFromBodyRotation(double roll, double pitch, double yaw) {
+    double sr = std::sin(roll * degreesToRadians), cr = std::cos(roll * degreesToRadians);
+    double sp = std::sin(pitch * degreesToRadians), cp = std::cos(pitch * degreesToRadians);
+    double sy = std::sin(yaw * degreesToRadians), cy = std::cos(yaw * degreesToRadians);
+    return Mat3{{cp * cy, sr * sp * cy - cr * sy, cr * sp * cy + sr * sy,
+                 cp * sy, sr * sp * sy + cr * cy, cr * sp * sy - sr * cy,
+                 -sp, sr * cp, cr * cp}};
+}
+
+} // namespace
+
+InsState insStateFromNed(double time, double lat, double lon, double alt, double roll, double pitch, double yaw,
+                         const Vec3& velocityNed) {
+    Mat3 ecefFromNed = ecefFromNedRotation(lat, lon);
+    InsState state;
+    state.time = time;
+    state.position = ecefFromLla(lat, lon, alt);
+    state.velocity = ecefFromNed * velocityNed;
+    state.attitude = quaternionFromDcm(ecefFromNed * nedFromBodyRotation(roll, pitch, yaw));
+    return state;
+}
+
+Vec3 nedVelocity(const InsState& state) {
+    double lat, lon, alt;
+    llaFromEcefPoint(state.position[0], state.position[1], state.position[2], lat, lon, alt);
+    return transpose(ecefFromNedRotation(lat, lon)) * state.velocity;
+}
+
+void nedPose(const InsState& state, double& lat, double& lon, double& alt, double& roll, double& pitch,
+             double& yaw) {
+    llaFromEcefPoint(state.position[0], state.position[1], state.position[2], lat, lon, alt);
+    Mat3 c = transpose(ecefFromNedRotation(lat, lon)) * dcmFromQuaternion(state.attitude);
+    roll = std::atan2(c(2, 1), c(2, 2)) / degreesToRadians;
+    pitch = -std::asin(std::max(-1.0, std::min(1.0, c(2, 0)))) / degreesToRadians;
+    yaw = std::atan2(c(1, 0), c(0, 0)) / degreesToRadians;
+}
@@ -0,0 +1,147 @@
+#ifndef STRAPDOWN_INS_HPP
+#define STRAPDOWN_INS_HPP
+
+#include <cstddef>
+#include "fixedMatrix.hpp"
+#include "quaternion.hpp"
+#include "imuData.hpp"
+
+/**
+ * @brief Navigation state of the strapdown mechanization, resolved in ECEF.
+ *
+ * The body frame is the frame of the IMU axes (the ImuData columns).
+ */
+struct InsState {
+    double time = 0.0; ///< Time of the state, on the IMU clock (s)
+    Vec3 position{}; ///< ECEF position (m)
+    Vec3 velocity{}; ///< ECEF velocity relative to the Earth (m/s)
+    Quaternion attitude; ///< Attitude q_b^e, from the body frame to ECEF
+};
+
+/**
+ * @brief Options of the strapdown mechanization.
+ */
+struct StrapdownOptions {
+    bool coning = true; ///< Two-sample coning compensation of the attitude update
+    bool sculling = true; ///< Rotation and two-sample sculling compensation of the velocity update
+    bool earthRotation = true; ///< Rotation of the ECEF frame and Coriolis acceleration
+    bool gravity = true; ///< J2 gravity model (false for tests in a gravity-free frame)
+    double maxInterval = 0.1; ///< Longer intervals between samples (gaps) reset the coning/sculling history (s)
+};
+
+/**
+ * @brief Strapdown INS mechanization in ECEF over IMU increments.
+ *
+ * Each interval between two IMU samples is integrated from the angle and
+ * velocity increments of the interval (rate times interval). The attitude is
+ * updated with the rotation vector of the body plus the two-sample coning
+ * correction (1/12) dtheta_prev x dtheta, and with the rotation of the Earth;
+ * the velocity with the body-frame increment plus the rotation correction
+ * (1/2) dtheta x dv and the two-sample sculling correction, and with gravity
+ * and the Coriolis acceleration; the position with the trapezoidal rule.
+ *
+ * The state lives on the stack and the update uses only fixed-size math, so a
+ * batch of samples is processed without any heap allocation. The propagator is
+ * cheap to copy, e.g. to run Monte Carlo trials from a common state.
+ */
+class StrapdownIns {
+public:
+    explicit StrapdownIns(const InsState& initial = InsState(), const StrapdownOptions& options = StrapdownOptions());
+
+    /**
+     * @brief Propagates the state over the samples [first, last) of the IMU data.
+     *
+     * The rates are taken as the mean rates (deg/s and g, as loaded) over the
+     * interval that ends at their timestamp, minus the biases set with
+     * setBiases. Samples not later than the time of the state are skipped, so
+     * overlapping batches can be passed.
+     *
+     * @param imuData The IMU data.
+     * @param first The first sample.
+     * @param last One past the last sample (clamped to the number of samples).
+     * @return size_t The number of samples integrated.
+     */
+    size_t propagate(const ImuData& imuData, size_t first, size_t last);
+
+    /**
+     * @brief Propagates the state over all the samples of the IMU data.
+     */
+    size_t propagate(const ImuData& imuData) { return propagate(imuData, 0, imuData.timeStamp.size()); }
+
+    /**
+     * @brief Propagates the state over one interval.
+     *
+     * @param dt The length of the interval (s, positive).
+     * @param deltaAngle The body angle increment over the interval (rad).
+     * @param deltaVelocity The body velocity increment (integrated specific force) over the interval (m/s).
+     */
+    void step(double dt, const Vec3& deltaAngle, const Vec3& deltaVelocity);
+
+    const InsState& state() const { return state_; }
+
+    /**
+     * @brief Replaces the state (e.g. after a filter correction), keeping the coning/sculling history.
+     */
+    void setState(const InsState& state) { state_ = state; }
+
+    /**
+     * @brief Forgets the previous increments, so the next interval is not coning/sculling compensated.
+     */
+    void resetHistory() { hasPrevious_ = false; }
+
+    /**
+     * @brief Sets the sensor biases removed from the samples by propagate.
+     *
+     * @param gyroBias The gyroscope bias (rad/s).
+     * @param accelBias The accelerometer bias (m/s^2).
+     */
+    void setBiases(const Vec3& gyroBias, const Vec3& accelBias) {
+        gyroBias_ = gyroBias;
+        accelBias_ = accelBias;
+    }
+
+    const Vec3& gyroBias() const { return gyroBias_; }
+    const Vec3& accelBias() const { return accelBias_; }
+
+    const StrapdownOptions& options() const { return options_; }
+
+private:
+    InsState state_;
+    StrapdownOptions options_;
+    Vec3 previousAngle_{};
+    Vec3 previousVelocity_{};
+    bool hasPrevious_ = false;
+    Vec3 gyroBias_{};
+    Vec3 accelBias_{};
+    double earthDt_ = 0.0; // Intervalo do último quaternion de rotação da Terra
+    Quaternion earthRotation_;
+};
+
+/**
+ * @brief Builds a state from geodetic coordinates, Euler angles and a NED velocity.
+ *
+ * @param time The time of the state (s).
+ * @param lat The latitude in degrees.
+ * @param lon The longitude in degrees.
+ * @param alt The altitude in meters.
+ * @param roll The roll of the body relative to North-East-Down, in degrees.
+ * @param pitch The pitch in degrees.
+ * @param yaw The yaw (heading from North) in degrees.
+ * @param velocityNed The velocity in the North-East-Down frame (m/s).
+ * @return InsState The state.
+ */
+InsState insStateFromNed(double time, double lat, double lon, double alt, double roll, double pitch, double yaw,
+                         const Vec3& velocityNed = Vec3{});
+
+/**
+ * @brief Gets the velocity of a state in the local North-East-Down frame (m/s).
+ */
+Vec3 nedVelocity(const InsState& state);
+
+/**
+ * @brief Gets the geodetic position and the Euler angles (roll, pitch, yaw relative to NED) of a state, in degrees.
+ */
+void nedPose(const InsState& state, double& lat, double& lon, double& alt, double& roll, double& pitch,
+             double& yaw);
+
+#endif // STRAPDOWN_INS_HPP
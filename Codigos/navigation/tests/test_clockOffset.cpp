@@ -0,0 +1,118 @@
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include "clockOffset.hpp"
+#include "strapdownIns.hpp"
+#include "earthModel.hpp"
+
+namespace {
+
+const double imuRate = 1000.0;
+const size_t samplesPerEpoch = 200; // GNSS a 5 Hz
+
+// Voo simulado como em test_gnssInsSmoother; o relógio do IMU é t + offset + drift (t - reference)
+struct Flight {
+    ImuData imu;
+    GnssData gnss;
+};
+
+Flight simulateFlight(double duration, double offset, double drift, double reference) {
+    std::mt19937_64 rng(11);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    const double gyroNoise = 5e-5, accelNoise = 5e-4;
+    const Vec3 accelBias = vec3(0.02, -0.03, 0.05);
+
+    Flight flight;
+    StrapdownIns truth(insStateFromNed(0.0, -15.8, -47.9, 1100.0, 1.0, -2.0, 40.0, vec3(2.0, 1.0, 0.0)));
+    size_t numSamples = static_cast<size_t>(duration * imuRate);
+    double dt = 1.0 / imuRate;
+    for (size_t i = 1; i <= numSamples; ++i) {
+        double t = i * dt;
+        const InsState& s = truth.state();
+        Mat3 bodyFromEcef = transpose(dcmFromQuaternion(s.attitude));
+        Vec3 rate = vec3(0.05 * std::sin(0.7 * t), 0.04 * std::cos(0.5 * t), 0.1 * std::sin(0.3 * t));
+        // Manobras e turbulência sem período comum, para um único pico de correlação
+        Vec3 accel = vec3(1.5 * std::sin(0.4 * t) + 0.8 * std::sin(0.013 * t * t),
+                          1.0 * std::cos(0.25 * t) + 1.5 * std::sin(1.7 * t + 3.0 * std::sin(0.11 * t)),
+                          0.3 * std::sin(0.9 * t) + 1.5 * std::cos(2.3 * t + 2.0 * std::cos(0.07 * t)));
+        Vec3 force = bodyFromEcef * (-1.0 * gravityEcef(s.position)) + accel;
+        truth.step(dt, rate * dt, force * dt);
+
+        Vec3 measuredForce = force + accelBias + (accelNoise / std::sqrt(dt)) * vec3(normal(rng), normal(rng), normal(rng));
+        Vec3 measuredRate = rate + (gyroNoise / std::sqrt(dt)) * vec3(normal(rng), normal(rng), normal(rng));
+        flight.imu.timeStamp.push_back(t + offset + drift * (t - reference));
+        flight.imu.gx.push_back(measuredRate[0] / degreesToRadians);
+        flight.imu.gy.push_back(measuredRate[1] / degreesToRadians);
+        flight.imu.gz.push_back(measuredRate[2] / degreesToRadians);
+        flight.imu.accx.push_back(measuredForce[0] / standardGravity);
+        flight.imu.accy.push_back(measuredForce[1] / standardGravity);
+        flight.imu.accz.push_back(measuredForce[2] / standardGravity);
+
+        // Uma queda do GNSS entre 200 e 215 s
+        if (i % samplesPerEpoch == 0 && (t < 200.0 || t > 215.0)) {
+            flight.gnss.time.push_back(t);
+            flight.gnss.x.push_back(s.position[0] + 0.02 * normal(rng));
+            flight.gnss.y.push_back(s.position[1] + 0.02 * normal(rng));
+            flight.gnss.z.push_back(s.position[2] + 0.02 * normal(rng));
+            flight.gnss.fix.push_back(1);
+        }
+    }
+    return flight;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    const double offset = 1234.5678, reference = 300.0;
+
+    // Deslocamento fixo, sem nenhuma estimativa inicial
+    Flight flight = simulateFlight(600.0, offset, 0.0, reference);
+    auto start = std::chrono::steady_clock::now();
+    ClockOffsetEstimate estimate = estimateClockOffset(flight.imu, flight.gnss);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double error = estimate.offsetAt(reference) - offset;
+    std::cout << "Offset " << estimate.offset << " s (coarse " << estimate.coarseOffset << " s), error "
+              << error * 1e3 << " ms, correlation " << estimate.correlation << ", in " << seconds << " s"
+              << std::endl;
+    if (!(std::abs(error) < 2e-3) || std::abs(estimate.coarseOffset - offset) > 0.2) {
+        std::cerr << "Clock offset is wrong." << std::endl;
+        ok = false;
+    }
+
+    // Deriva de 20 ppm em vinte minutos, com pedaços de dois minutos
+    const double drift = 20e-6;
+    Flight drifting = simulateFlight(1200.0, offset, drift, reference);
+    ClockOffsetOptions options;
+    options.estimateDrift = true;
+    start = std::chrono::steady_clock::now();
+    ClockOffsetEstimate driftEstimate = estimateClockOffset(drifting.imu, drifting.gnss, options);
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double offsetError = driftEstimate.offsetAt(reference) - offset;
+    double driftError = driftEstimate.drift - drift;
+    std::cout << "With drift: offset error " << offsetError * 1e3 << " ms, drift " << driftEstimate.drift * 1e6
+              << " ppm from " << driftEstimate.windowTimes.size() << " pieces, in " << seconds << " s" << std::endl;
+    if (!(std::abs(offsetError) < 2e-3) || !(std::abs(driftError) < 5e-6)) {
+        std::cerr << "Clock drift is wrong." << std::endl;
+        ok = false;
+    }
+
+    // Nenhum atraso cobre a sobreposição exigida
+    Flight shortFlight = simulateFlight(60.0, 0.0, 0.0, 0.0);
+    ClockOffsetOptions strict;
+    strict.minOverlap = 2.0;
+    try {
+        estimateClockOffset(shortFlight.imu, shortFlight.gnss, strict);
+        std::cerr << "Estimate without enough overlap accepted." << std::endl;
+        ok = false;
+    } catch (const std::runtime_error&) {
+    }
+
+    if (!ok) {
+        return 1;
+    }
+    std::cout << "Clock offset test passed." << std::endl;
+    return 0;
+}
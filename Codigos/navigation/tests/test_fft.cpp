@@ -0,0 +1,95 @@
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "fft.hpp"
+
+int main() {
+    bool ok = true;
+    std::mt19937_64 rng(3);
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    // Comparação com a DFT direta e volta pela inversa
+    for (size_t n : {1, 2, 8, 64, 256}) {
+        std::vector<std::complex<double>> data(n);
+        for (std::complex<double>& value : data) {
+            value = std::complex<double>(normal(rng), normal(rng));
+        }
+        std::vector<std::complex<double>> transformed = data;
+        fft(transformed);
+        double error = 0.0;
+        for (size_t k = 0; k < n; ++k) {
+            std::complex<double> sum;
+            for (size_t i = 0; i < n; ++i) {
+                double angle = -2.0 * M_PI * static_cast<double>(k * i % n) / static_cast<double>(n);
+                sum += data[i] * std::complex<double>(std::cos(angle), std::sin(angle));
+            }
+            error = std::max(error, std::abs(transformed[k] - sum));
+        }
+        fft(transformed, true);
+        double roundTrip = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            roundTrip = std::max(roundTrip, std::abs(transformed[i] - data[i]));
+        }
+        if (error > 1e-10 || roundTrip > 1e-12) {
+            std::cerr << "FFT of length " << n << " is wrong: DFT error " << error << ", round trip " << roundTrip
+                      << std::endl;
+            ok = false;
+        }
+    }
+
+    try {
+        std::vector<std::complex<double>> odd(12);
+        fft(odd);
+        std::cerr << "Length that is not a power of two accepted." << std::endl;
+        ok = false;
+    } catch (const std::invalid_argument&) {
+    }
+
+    // Correlação com tamanhos diferentes contra a soma direta
+    std::vector<double> x(37), y(23);
+    for (double& v : x) {
+        v = normal(rng);
+    }
+    for (double& v : y) {
+        v = normal(rng);
+    }
+    std::vector<double> c = crossCorrelation(x, y);
+    double correlationError = c.size() == x.size() + y.size() - 1 ? 0.0 : 1.0;
+    for (long lag = -static_cast<long>(y.size() - 1); lag < static_cast<long>(x.size()) && correlationError < 1.0;
+         ++lag) {
+        double sum = 0.0;
+        for (long n = 0; n < static_cast<long>(y.size()); ++n) {
+            if (n + lag >= 0 && n + lag < static_cast<long>(x.size())) {
+                sum += x[n + lag] * y[n];
+            }
+        }
+        correlationError = std::max(correlationError, std::abs(c[lag + y.size() - 1] - sum));
+    }
+    std::cout << "Cross-correlation error " << correlationError << std::endl;
+    if (correlationError > 1e-12) {
+        std::cerr << "Cross-correlation is wrong." << std::endl;
+        ok = false;
+    }
+
+    // Um milhão de amostras contra cem mil
+    std::vector<double> longX(1000000), longY(100000);
+    for (double& v : longX) {
+        v = normal(rng);
+    }
+    for (double& v : longY) {
+        v = normal(rng);
+    }
+    auto start = std::chrono::steady_clock::now();
+    std::vector<double> longC = crossCorrelation(longX, longY);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Cross-correlation of 1e6 by 1e5 samples in " << seconds << " s" << std::endl;
+
+    if (!ok) {
+        return 1;
+    }
+    std::cout << "FFT test passed." << std::endl;
+    return 0;
+}
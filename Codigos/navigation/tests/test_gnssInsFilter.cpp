@@ -0,0 +1,161 @@
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include "gnssInsFilter.hpp"
+#include "earthModel.hpp"
+
+namespace {
+
+const double imuRate = 2000.0;
+const size_t samplesPerEpoch = 400; // GNSS a 5 Hz
+const double timeOffset = 1000.0; // Relógio do IMU menos GPST
+
+struct Flight {
+    ImuData imu; // Com vieses e ruído
+    GnssData gnss; // Com ruído, fix e float alternados
+    std::vector<InsState> truth; // Estado verdadeiro em cada época
+    InsState initial;
+};
+
+// Voo simulado: a verdade é a própria mecanização alimentada com as medidas perfeitas
+Flight simulateFlight(double duration, const Vec3& gyroBias, const Vec3& accelBias) {
+    std::mt19937_64 rng(11);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    const double gyroNoise = 5e-5, accelNoise = 5e-4; // por raiz de segundo
+
+    Flight flight;
+    flight.initial = insStateFromNed(timeOffset, -15.8, -47.9, 1100.0, 1.0, -2.0, 40.0, vec3(2.0, 1.0, 0.0));
+    StrapdownIns truth(flight.initial);
+    size_t numSamples = static_cast<size_t>(duration * imuRate);
+    double dt = 1.0 / imuRate;
+    for (size_t i = 1; i <= numSamples; ++i) {
+        double t = i * dt;
+        const InsState& s = truth.state();
+        Mat3 bodyFromEcef = transpose(dcmFromQuaternion(s.attitude));
+        // Manobras suaves: giros e acelerações senoidais sobre o voo pairado
+        Vec3 rate = vec3(0.05 * std::sin(0.7 * t), 0.04 * std::cos(0.5 * t), 0.1 * std::sin(0.3 * t));
+        Vec3 accel = vec3(1.5 * std::sin(0.4 * t), 1.0 * std::cos(0.25 * t), 0.3 * std::sin(0.9 * t));
+        Vec3 force = bodyFromEcef * (-1.0 * gravityEcef(s.position)) + accel;
+        truth.step(dt, rate * dt, force * dt);
+
+        Vec3 measuredRate = rate + gyroBias + (gyroNoise / std::sqrt(dt)) * vec3(normal(rng), normal(rng), normal(rng));
+        Vec3 measuredForce = force + accelBias + (accelNoise / std::sqrt(dt)) * vec3(normal(rng), normal(rng), normal(rng));
+        flight.imu.timeStamp.push_back(timeOffset + t);
+        flight.imu.gx.push_back(measuredRate[0] / degreesToRadians);
+        flight.imu.gy.push_back(measuredRate[1] / degreesToRadians);
+        flight.imu.gz.push_back(measuredRate[2] / degreesToRadians);
+        flight.imu.accx.push_back(measuredForce[0] / standardGravity);
+        flight.imu.accy.push_back(measuredForce[1] / standardGravity);
+        flight.imu.accz.push_back(measuredForce[2] / standardGravity);
+
+        if (i % samplesPerEpoch == 0) {
+            size_t epoch = i / samplesPerEpoch;
+            int fix = (epoch / 50) % 3 == 2 ? 2 : 1; // 10 s de float a cada 30 s
+            double sigma = fix == 1 ? 0.02 : 0.3;
+            flight.truth.push_back(truth.state());
+            flight.gnss.time.push_back(t);
+            flight.gnss.x.push_back(truth.state().position[0] + sigma * normal(rng));
+            flight.gnss.y.push_back(truth.state().position[1] + sigma * normal(rng));
+            flight.gnss.z.push_back(truth.state().position[2] + sigma * normal(rng));
+            flight.gnss.fix.push_back(fix);
+        }
+    }
+    return flight;
+}
+
+double attitudeError(const Quaternion& a, const Quaternion& b) {
+    return norm(rotationVectorFromQuaternion(conjugate(a) * b));
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    const Vec3 gyroBias = vec3(2e-4, -1e-4, 3e-4); // rad/s (~40-60 deg/h)
+    const Vec3 accelBias = vec3(0.02, -0.03, 0.05); // m/s^2
+    const double duration = 600.0;
+    Flight flight = simulateFlight(duration, gyroBias, accelBias);
+
+    // O filtro parte com erros de posição, velocidade e atitude
+    InsState initial = flight.initial;
+    initial.position += vec3(0.5, -0.3, 0.4);
+    initial.velocity += vec3(0.05, 0.02, -0.03);
+    initial.attitude = normalize(quaternionFromRotationVector(vec3(0.005, -0.004, 0.01)) * initial.attitude);
+
+    GnssInsOptions options;
+    options.timeOffset = timeOffset;
+    options.gyroNoise = 5e-5;
+    options.accelNoise = 5e-4;
+    options.innovationGate = 16.27; // 99.9% com 3 graus de liberdade
+
+    // Um salto grosseiro em uma época com fix deve ser rejeitado
+    size_t outlier = 1201;
+    flight.gnss.x[outlier] += 5.0;
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<GnssInsEpoch> epochs = runGnssIns(flight.imu, flight.gnss, initial, options);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << getLogStream(epochs);
+    std::cout << "Filtered " << duration << " s of flight in " << seconds << " s (" << seconds * 3600.0 / duration
+              << " s per hour)" << std::endl;
+    // Limite folgado (o alvo é bem menos de 1 s por hora): pega regressões no laço de predição a 2 kHz
+    const double maxSecondsPerHour = 5.0;
+    if (seconds * 3600.0 / duration > maxSecondsPerHour) {
+        std::cerr << "Filter slower than " << maxSecondsPerHour << " s per hour of flight." << std::endl;
+        ok = false;
+    }
+
+    if (epochs.size() != flight.truth.size()) {
+        std::cerr << "Wrong number of epochs: " << epochs.size() << std::endl;
+        return 1;
+    }
+    if (epochs[outlier].update.accepted) {
+        std::cerr << "Outlier accepted." << std::endl;
+        ok = false;
+    }
+
+    // Erros no último minuto, separando fix e float
+    double fixError = 0.0, floatError = 0.0, attitude = 0.0, fixSigma = 0.0, floatSigma = 0.0;
+    size_t numFix = 0, numFloat = 0;
+    for (size_t k = epochs.size() - 300; k < epochs.size(); ++k) {
+        const InsState& truth = flight.truth[k];
+        double error = norm(epochs[k].state.position - truth.position);
+        if (epochs[k].fix == 1) {
+            fixError = std::max(fixError, error);
+            fixSigma += norm(epochs[k].positionSigma);
+            ++numFix;
+        } else {
+            floatError = std::max(floatError, error);
+            floatSigma += norm(epochs[k].positionSigma);
+            ++numFloat;
+        }
+        attitude = std::max(attitude, attitudeError(epochs[k].state.attitude, truth.attitude));
+    }
+    fixSigma /= numFix;
+    floatSigma /= numFloat;
+    const GnssInsEpoch& last = epochs.back();
+    double gyroBiasError = norm(last.gyroBias - gyroBias);
+    double accelBiasError = norm(last.accelBias - accelBias);
+    std::cout << "Max position error: fix " << fixError << " m, float " << floatError << " m; sigma fix " << fixSigma
+              << " m, float " << floatSigma << " m; attitude " << attitude / degreesToRadians << " deg" << std::endl;
+    std::cout << "Bias errors: gyro " << gyroBiasError << " rad/s, accel " << accelBiasError << " m/s^2" << std::endl;
+    if (fixError > 0.05 || floatError > 0.5 || attitude > 0.05 * degreesToRadians) {
+        std::cerr << "Filter did not converge." << std::endl;
+        ok = false;
+    }
+    if (!(floatSigma > 2.0 * fixSigma)) {
+        std::cerr << "Float epochs not weighted less than fixed ones." << std::endl;
+        ok = false;
+    }
+    if (gyroBiasError > 0.2 * norm(gyroBias) || accelBiasError > 0.2 * norm(accelBias)) {
+        std::cerr << "Biases not estimated." << std::endl;
+        ok = false;
+    }
+
+    if (!ok) {
+        return 1;
+    }
+    std::cout << "GNSS/INS filter test passed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,197 @@
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include "gnssInsSmoother.hpp"
+#include "earthModel.hpp"
+
+namespace {
+
+const double imuRate = 2000.0;
+const size_t samplesPerEpoch = 400; // GNSS a 5 Hz
+
+struct Flight {
+    ImuData imu;
+    GnssData gnss;
+    std::vector<Vec3> truth; // Posição verdadeira em cada amostra do IMU
+    InsState initial;
+};
+
+// Voo simulado como em test_gnssInsFilter, com uma queda do GNSS de outageStart a outageEnd
+Flight simulateFlight(double duration, double outageStart, double outageEnd) {
+    std::mt19937_64 rng(5);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    const double gyroNoise = 5e-5, accelNoise = 5e-4;
+    const Vec3 gyroBias = vec3(2e-4, -1e-4, 3e-4), accelBias = vec3(0.02, -0.03, 0.05);
+
+    Flight flight;
+    flight.initial = insStateFromNed(0.0, -15.8, -47.9, 1100.0, 1.0, -2.0, 40.0, vec3(2.0, 1.0, 0.0));
+    StrapdownIns truth(flight.initial);
+    size_t numSamples = static_cast<size_t>(duration * imuRate);
+    double dt = 1.0 / imuRate;
+    for (size_t i = 1; i <= numSamples; ++i) {
+        double t = i * dt;
+        const InsState& s = truth.state();
+        Mat3 bodyFromEcef = transpose(dcmFromQuaternion(s.attitude));
+        Vec3 rate = vec3(0.05 * std::sin(0.7 * t), 0.04 * std::cos(0.5 * t), 0.1 * std::sin(0.3 * t));
+        Vec3 accel = vec3(1.5 * std::sin(0.4 * t), 1.0 * std::cos(0.25 * t), 0.3 * std::sin(0.9 * t));
+        Vec3 force = bodyFromEcef * (-1.0 * gravityEcef(s.position)) + accel;
+        truth.step(dt, rate * dt, force * dt);
+
+        Vec3 measuredRate = rate + gyroBias + (gyroNoise / std::sqrt(dt)) * vec3(normal(rng), normal(rng), normal(rng));
+        Vec3 measuredForce = force + accelBias + (accelNoise / std::sqrt(dt)) * vec3(normal(rng), normal(rng), normal(rng));
+        flight.imu.timeStamp.push_back(t);
+        flight.imu.gx.push_back(measuredRate[0] / degreesToRadians);
+        flight.imu.gy.push_back(measuredRate[1] / degreesToRadians);
+        flight.imu.gz.push_back(measuredRate[2] / degreesToRadians);
+        flight.imu.accx.push_back(measuredForce[0] / standardGravity);
+        flight.imu.accy.push_back(measuredForce[1] / standardGravity);
+        flight.imu.accz.push_back(measuredForce[2] / standardGravity);
+
+        flight.truth.push_back(truth.state().position);
+        if (i % samplesPerEpoch == 0 && (t < outageStart || t > outageEnd)) {
+            int fix = (i / samplesPerEpoch / 50) % 3 == 2 ? 2 : 1;
+            double sigma = fix == 1 ? 0.02 : 0.3;
+            flight.gnss.time.push_back(t);
+            flight.gnss.x.push_back(truth.state().position[0] + sigma * normal(rng));
+            flight.gnss.y.push_back(truth.state().position[1] + sigma * normal(rng));
+            flight.gnss.z.push_back(truth.state().position[2] + sigma * normal(rng));
+            flight.gnss.fix.push_back(fix);
+        }
+    }
+    return flight;
+}
+
+// Posição verdadeira no instante de uma amostra do IMU
+const Vec3& truthAt(const Flight& flight, double t) {
+    return flight.truth[static_cast<size_t>(std::lround(t * imuRate)) - 1];
+}
+
+bool sameStates(const std::vector<SmoothedState>& a, const std::vector<SmoothedState>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (std::memcmp(&a[i].state, &b[i].state, sizeof(InsState)) != 0 ||
+            std::memcmp(&a[i].positionSigma, &b[i].positionSigma, sizeof(Vec3)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    const double duration = 180.0, outageStart = 80.0, outageEnd = 100.0;
+    Flight flight = simulateFlight(duration, outageStart, outageEnd);
+
+    GnssInsOptions options;
+    options.gyroNoise = 5e-5;
+    options.accelNoise = 5e-4;
+    SmootherOptions smootherOptions;
+    smootherOptions.numThreads = 2;
+
+    auto start = std::chrono::steady_clock::now();
+    SmoothedTrajectory trajectory;
+    try {
+        trajectory = smoothGnssIns(flight.imu, flight.gnss, flight.initial, options, smootherOptions);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Smoothed " << duration << " s of flight in " << seconds << " s: " << trajectory.states.size()
+              << " states, " << trajectory.numCheckpoints << " checkpoints (" << trajectory.checkpointBytes / 1024
+              << " KB), peak segments " << trajectory.peakSegmentBytes / 1024 << " KB" << std::endl;
+
+    // Mesmos epochs que o filtro sozinho
+    std::vector<GnssInsEpoch> filtered = runGnssIns(flight.imu, flight.gnss, flight.initial, options);
+    if (filtered.size() != trajectory.epochs.size() ||
+        std::memcmp(&filtered.back().state, &trajectory.epochs.back().state, sizeof(InsState)) != 0) {
+        std::cerr << "Forward pass differs from runGnssIns." << std::endl;
+        ok = false;
+    }
+    if (std::memcmp(&trajectory.states.back().state, &filtered.back().state, sizeof(InsState)) != 0) {
+        std::cerr << "Last smoothed state is not the last filtered one." << std::endl;
+        ok = false;
+    }
+
+    // Na queda do GNSS o filtro deriva; o suavizador usa as épocas depois dela
+    double filterOutage = 0.0, smoothOutage = 0.0, smoothMax = 0.0;
+    // Erro do filtro: a predição pura no fim da queda, vista pela inovação da primeira época depois dela
+    for (const GnssInsEpoch& e : filtered) {
+        if (e.time > outageEnd) {
+            filterOutage = norm(e.update.innovation);
+            break;
+        }
+    }
+    for (const SmoothedState& s : trajectory.states) {
+        double t = s.state.time;
+        if (t < 5.0) {
+            continue;
+        }
+        double error = norm(s.state.position - truthAt(flight, t));
+        if (t > outageStart && t < outageEnd) {
+            smoothOutage = std::max(smoothOutage, error);
+        } else {
+            smoothMax = std::max(smoothMax, error);
+        }
+    }
+    std::cout << "Outage of " << outageEnd - outageStart << " s: filter error " << filterOutage
+              << " m at its end, smoother max error " << smoothOutage << " m; elsewhere " << smoothMax << " m"
+              << std::endl;
+    if (!(smoothOutage < 0.2 * filterOutage) || smoothMax > 0.1) {
+        std::cerr << "Smoother did not improve the outage." << std::endl;
+        ok = false;
+    }
+
+    // Nas épocas, a incerteza suavizada não passa da filtrada
+    size_t node = 0, compared = 0;
+    for (const GnssInsEpoch& e : filtered) {
+        while (node < trajectory.states.size() && trajectory.states[node].state.time < e.state.time) {
+            ++node;
+        }
+        if (node < trajectory.states.size() && trajectory.states[node].state.time == e.state.time) {
+            ++compared;
+            if (norm(trajectory.states[node].positionSigma) > norm(e.positionSigma) * (1.0 + 1e-9)) {
+                std::cerr << "Smoothed sigma above filtered at " << e.time << std::endl;
+                ok = false;
+                break;
+            }
+        }
+    }
+    if (compared != filtered.size()) {
+        std::cerr << "Epochs without a smoothed node: " << filtered.size() - compared << std::endl;
+        ok = false;
+    }
+
+    // O resultado não depende dos checkpoints, dos lotes nem das threads
+    SmootherOptions other;
+    other.checkpointEvery = 1;
+    other.segmentsPerBatch = 3;
+    other.numThreads = 1;
+    SmoothedTrajectory dense = smoothGnssIns(flight.imu, flight.gnss, flight.initial, options, other);
+    other.checkpointEvery = 23;
+    other.segmentsPerBatch = 0;
+    other.numThreads = 3;
+    SmoothedTrajectory sparse = smoothGnssIns(flight.imu, flight.gnss, flight.initial, options, other);
+    if (!sameStates(dense.states, trajectory.states) || !sameStates(sparse.states, trajectory.states)) {
+        std::cerr << "Result depends on the checkpoints." << std::endl;
+        ok = false;
+    }
+    std::cout << "Checkpoints every 1/5/23 epochs: " << dense.checkpointBytes / 1024 << "/"
+              << trajectory.checkpointBytes / 1024 << "/" << sparse.checkpointBytes / 1024 << " KB" << std::endl;
+    if (!(sparse.checkpointBytes < trajectory.checkpointBytes && trajectory.checkpointBytes < dense.checkpointBytes)) {
+        std::cerr << "Checkpoint memory does not shrink." << std::endl;
+        ok = false;
+    }
+
+    if (!ok) {
+        return 1;
+    }
+    std::cout << "GNSS/INS smoother test passed." << std::endl;
+    return 0;
+}
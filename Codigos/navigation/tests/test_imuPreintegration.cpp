@@ -0,0 +1,222 @@
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include "imuPreintegration.hpp"
+#include "strapdownIns.hpp"
+#include "earthModel.hpp"
+
+namespace {
+
+const double imuRate = 200.0;
+
+// Movimento suave qualquer; as amostras em graus/s e g, como carregadas
+ImuData simulateImu(double duration, double rate) {
+    ImuData imu;
+    size_t numSamples = static_cast<size_t>(duration * rate);
+    for (size_t i = 1; i <= numSamples; ++i) {
+        double t = i / rate;
+        Vec3 omega = vec3(0.5 * std::sin(1.3 * t), 0.4 * std::cos(0.7 * t), 0.8 * std::sin(0.3 * t));
+        Vec3 force = vec3(2.0 * std::sin(0.9 * t), 1.0 + std::cos(0.4 * t), -9.8 + 0.5 * std::sin(2.1 * t));
+        imu.timeStamp.push_back(t);
+        imu.gx.push_back(omega[0] / degreesToRadians);
+        imu.gy.push_back(omega[1] / degreesToRadians);
+        imu.gz.push_back(omega[2] / degreesToRadians);
+        imu.accx.push_back(force[0] / standardGravity);
+        imu.accy.push_back(force[1] / standardGravity);
+        imu.accz.push_back(force[2] / standardGravity);
+    }
+    return imu;
+}
+
+double rotationDifference(const Quaternion& a, const Quaternion& b) {
+    return norm(rotationVectorFromQuaternion(conjugate(a) * b));
+}
+
+bool sameResult(const PreintegratedImu& a, const PreintegratedImu& b) {
+    return a.qw == b.qw && a.qx == b.qx && a.qy == b.qy && a.qz == b.qz && a.dvx == b.dvx && a.dvy == b.dvy &&
+           a.dvz == b.dvz && a.dpx == b.dpx && a.dpy == b.dpy && a.dpz == b.dpz && a.covariance == b.covariance &&
+           a.positionGyro == b.positionGyro && a.complete == b.complete && a.numSamples == b.numSamples;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    ImuData imu = simulateImu(60.0, imuRate);
+    PreintegrationOptions options;
+    options.numThreads = 1;
+
+    // Com épocas nas amostras, é a mecanização sem gravidade, rotação da Terra, cone e sculling
+    std::vector<double> epochs;
+    for (size_t k = 1; k < 60; ++k) {
+        epochs.push_back(k * 1.0);
+    }
+    PreintegratedImu pre = preintegrateImu(imu, epochs, options);
+    StrapdownOptions plain;
+    plain.coning = plain.sculling = plain.earthRotation = plain.gravity = false;
+    InsState initial;
+    initial.time = epochs[0];
+    initial.velocity = vec3(3.0, -1.0, 0.5);
+    initial.attitude = quaternionFromRotationVector(vec3(0.3, -0.2, 1.0));
+    StrapdownIns ins(initial, plain);
+    double maxRotation = 0.0, maxVelocity = 0.0, maxPosition = 0.0;
+    for (size_t i = 0; i < pre.size(); ++i) {
+        InsState a = ins.state();
+        ins.propagate(imu, 0, static_cast<size_t>(std::lround(epochs[i + 1] * imuRate)));
+        InsState b = ins.state();
+        Mat3 bodyFromWorld = transpose(dcmFromQuaternion(a.attitude));
+        double dt = b.time - a.time;
+        maxRotation = std::max(maxRotation, rotationDifference(conjugate(a.attitude) * b.attitude, pre.deltaRotation(i)));
+        maxVelocity = std::max(maxVelocity, norm(bodyFromWorld * (b.velocity - a.velocity) - pre.deltaVelocity(i)));
+        maxPosition = std::max(maxPosition, norm(bodyFromWorld * (b.position - a.position - a.velocity * dt) -
+                                                 pre.deltaPosition(i)));
+        if (!pre.complete[i] || pre.numSamples[i] != 200 || std::fabs(pre.deltaTime[i] - dt) > 1e-12) {
+            std::cerr << "Interval " << i << " bookkeeping is wrong." << std::endl;
+            ok = false;
+            break;
+        }
+    }
+    std::cout << "Against the mechanization: rotation " << maxRotation << " rad, velocity " << maxVelocity
+              << " m/s, position " << maxPosition << " m" << std::endl;
+    if (maxRotation > 1e-12 || maxVelocity > 1e-10 || maxPosition > 1e-10) {
+        std::cerr << "Preintegration differs from the mechanization." << std::endl;
+        ok = false;
+    }
+
+    // Dois intervalos adjacentes compõem o intervalo inteiro; divididos no meio de uma amostra, a menos da
+    // discretização desse passo
+    for (double split : {10.5, 10.5037}) {
+        PreintegratedImu parts = preintegrateImu(imu, {10.0012, split, 11.2001}, options);
+        PreintegratedImu whole = preintegrateImu(imu, {10.0012, 11.2001}, options);
+        Mat3 r1 = dcmFromQuaternion(parts.deltaRotation(0));
+        Quaternion composedRotation = parts.deltaRotation(0) * parts.deltaRotation(1);
+        Vec3 composedVelocity = parts.deltaVelocity(0) + r1 * parts.deltaVelocity(1);
+        Vec3 composedPosition = parts.deltaPosition(0) + parts.deltaVelocity(0) * parts.deltaTime[1] +
+                                r1 * parts.deltaPosition(1);
+        double rotationError = rotationDifference(composedRotation, whole.deltaRotation(0));
+        double error = norm(composedVelocity - whole.deltaVelocity(0)) + norm(composedPosition - whole.deltaPosition(0));
+        bool onSample = split == 10.5;
+        std::cout << "Composition split at " << split << " s: rotation " << rotationError << " rad, velocity and position "
+                  << error << std::endl;
+        if (rotationError > 1e-14 || error > (onSample ? 1e-13 : 1e-4) ||
+            parts.numSamples[0] + parts.numSamples[1] != whole.numSamples[0] + (onSample ? 0 : 1)) {
+            std::cerr << "Split intervals do not compose." << std::endl;
+            ok = false;
+        }
+    }
+
+    // Correção de primeira ordem dos vieses contra a integração refeita: o erro cai com o quadrado do desvio
+    double biasChange = 0.0, biasError[2] = {0.0, 0.0};
+    for (int scale = 0; scale < 2; ++scale) {
+        PreintegrationOptions shifted = options;
+        Vec3 dbg = vec3(2e-3, -1e-3, 1.5e-3) * (scale ? 0.1 : 1.0), dba = vec3(0.05, -0.02, 0.03) * (scale ? 0.1 : 1.0);
+        shifted.gyroBias = options.gyroBias + dbg;
+        shifted.accelBias = options.accelBias + dba;
+        PreintegratedImu exact = preintegrateImu(imu, epochs, shifted);
+        for (size_t i = 0; i < pre.size(); ++i) {
+            Quaternion rotation = pre.deltaRotation(i) *
+                                  quaternionFromRotationVector(pre.jacobian(pre.rotationGyro, i) * dbg);
+            Vec3 velocity = pre.deltaVelocity(i) + pre.jacobian(pre.velocityAccel, i) * dba +
+                            pre.jacobian(pre.velocityGyro, i) * dbg;
+            Vec3 position = pre.deltaPosition(i) + pre.jacobian(pre.positionAccel, i) * dba +
+                            pre.jacobian(pre.positionGyro, i) * dbg;
+            if (scale == 0) {
+                biasChange = std::max(biasChange, norm(exact.deltaPosition(i) - pre.deltaPosition(i)));
+            }
+            biasError[scale] = std::max({biasError[scale], rotationDifference(rotation, exact.deltaRotation(i)),
+                                         norm(velocity - exact.deltaVelocity(i)),
+                                         norm(position - exact.deltaPosition(i))});
+        }
+    }
+    std::cout << "Bias correction: change " << biasChange << ", first-order error " << biasError[0] << ", "
+              << biasError[1] << " at a tenth of the change" << std::endl;
+    if (!(biasError[0] < 0.01 * biasChange) || !(biasError[1] < 0.02 * biasError[0])) {
+        std::cerr << "Bias Jacobians are wrong." << std::endl;
+        ok = false;
+    }
+
+    // Covariância contra Monte Carlo com ruído branco nas amostras
+    std::mt19937_64 rng(3);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    const size_t trials = 500;
+    const std::vector<double> interval = {20.0, 21.0};
+    PreintegratedImu nominal = preintegrateImu(imu, interval, options);
+    Matrix<9, 9> sampleCovariance{};
+    for (size_t trial = 0; trial < trials; ++trial) {
+        ImuData noisy = imu;
+        double gyroSigma = options.gyroNoise * std::sqrt(imuRate) / degreesToRadians;
+        double accelSigma = options.accelNoise * std::sqrt(imuRate) / standardGravity;
+        for (size_t s = 3990; s < 4210; ++s) {
+            noisy.gx[s] += gyroSigma * normal(rng);
+            noisy.gy[s] += gyroSigma * normal(rng);
+            noisy.gz[s] += gyroSigma * normal(rng);
+            noisy.accx[s] += accelSigma * normal(rng);
+            noisy.accy[s] += accelSigma * normal(rng);
+            noisy.accz[s] += accelSigma * normal(rng);
+        }
+        PreintegratedImu p = preintegrateImu(noisy, interval, options);
+        Matrix<9, 1> error;
+        setBlock(error, 0, 0, rotationVectorFromQuaternion(conjugate(nominal.deltaRotation(0)) * p.deltaRotation(0)));
+        setBlock(error, 3, 0, p.deltaVelocity(0) - nominal.deltaVelocity(0));
+        setBlock(error, 6, 0, p.deltaPosition(0) - nominal.deltaPosition(0));
+        sampleCovariance += error * transpose(error) * (1.0 / trials);
+    }
+    Matrix<9, 9> predicted = nominal.covarianceOf(0);
+    double worstRatio = 1.0;
+    for (size_t i = 0; i < 9; ++i) {
+        double ratio = sampleCovariance(i, i) / predicted(i, i);
+        if (std::fabs(ratio - 1.0) > std::fabs(worstRatio - 1.0)) {
+            worstRatio = ratio;
+        }
+    }
+    std::cout << "Monte Carlo variance over predicted, worst axis: " << worstRatio << std::endl;
+    if (std::fabs(worstRatio - 1.0) > 0.2) {
+        std::cerr << "Covariance does not match Monte Carlo." << std::endl;
+        ok = false;
+    }
+
+    // Intervalos fora dos dados ou com lacuna ficam incompletos
+    ImuData gappy = imu;
+    for (std::vector<double>* c : {&gappy.timeStamp, &gappy.gx, &gappy.gy, &gappy.gz, &gappy.accx, &gappy.accy,
+                                   &gappy.accz}) {
+        c->erase(c->begin() + 6000, c->begin() + 6100); // 30,0 a 30,5 s
+    }
+    PreintegratedImu flagged = preintegrateImu(gappy, {0.0, 1.0, 29.0, 31.0, 59.0, 61.0}, options);
+    if (flagged.complete != std::vector<unsigned char>{0, 1, 0, 1, 0}) {
+        std::cerr << "Incomplete intervals not flagged." << std::endl;
+        ok = false;
+    }
+    try {
+        preintegrateImu(imu, {1.0, 1.0}, options);
+        std::cerr << "Repeated epochs accepted." << std::endl;
+        ok = false;
+    } catch (const std::invalid_argument&) {
+    }
+
+    // Dez minutos a 2 kHz com GNSS a 5 Hz; o resultado não depende das threads
+    ImuData flight = simulateImu(600.0, 2000.0);
+    GnssData gnss;
+    for (size_t k = 0; k <= 5 * 600; ++k) {
+        gnss.time.push_back(k * 0.2 - 1000.0);
+    }
+    PreintegrationOptions threaded = options;
+    threaded.timeOffset = 1000.0;
+    auto start = std::chrono::steady_clock::now();
+    PreintegratedImu serial = preintegrateImu(flight, gnss, threaded);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Preintegrated " << flight.timeStamp.size() << " samples into " << serial.size() << " intervals in "
+              << seconds << " s (" << flight.timeStamp.size() / seconds / 1e6 << " M samples/s)" << std::endl;
+    threaded.numThreads = 3;
+    PreintegratedImu parallel = preintegrateImu(flight, gnss, threaded);
+    if (!sameResult(serial, parallel) || serial.numSamples[1] != 400 || !serial.complete[1] || serial.complete[0]) {
+        std::cerr << "Threaded preintegration differs." << std::endl;
+        ok = false;
+    }
+
+    if (!ok) {
+        return 1;
+    }
+    std::cout << "IMU preintegration test passed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,162 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include "strapdownIns.hpp"
+#include "earthModel.hpp"
+
+namespace {
+
+const double rate = 2000.0;
+
+// IMU parado: mede -g e a rotação da Terra nos eixos do corpo
+ImuData staticImu(const InsState& state, size_t numSamples) {
+    Mat3 bodyFromEcef = transpose(dcmFromQuaternion(state.attitude));
+    Vec3 force = bodyFromEcef * (-1.0 / standardGravity * gravityEcef(state.position));
+    Vec3 omega = bodyFromEcef * vec3(0.0, 0.0, earthRotationRate / degreesToRadians);
+    ImuData imu;
+    for (size_t i = 0; i < numSamples; ++i) {
+        imu.timeStamp.push_back(state.time + (i + 1) / rate);
+        imu.accx.push_back(force[0]);
+        imu.accy.push_back(force[1]);
+        imu.accz.push_back(force[2]);
+        imu.gx.push_back(omega[0]);
+        imu.gy.push_back(omega[1]);
+        imu.gz.push_back(omega[2]);
+    }
+    return imu;
+}
+
+// Movimento de cone: o eixo x do corpo precessiona a um ângulo halfAngle com frequência omega
+Quaternion coningAttitude(double t, double halfAngle, double omega) {
+    Quaternion precession = quaternionFromRotationVector(vec3(0.0, 0.0, omega * t));
+    return precession * quaternionFromRotationVector(vec3(halfAngle, 0.0, 0.0)) * conjugate(precession);
+}
+
+Vec3 bodyRate(double t, double halfAngle, double omega) {
+    const double h = 1e-6;
+    Quaternion q0 = coningAttitude(t - h, halfAngle, omega);
+    Quaternion q1 = coningAttitude(t + h, halfAngle, omega);
+    Quaternion q = coningAttitude(t, halfAngle, omega);
+    Quaternion dq{(q1.w - q0.w) / (2 * h), (q1.x - q0.x) / (2 * h), (q1.y - q0.y) / (2 * h), (q1.z - q0.z) / (2 * h)};
+    Quaternion w = conjugate(q) * dq;
+    return vec3(2.0 * w.x, 2.0 * w.y, 2.0 * w.z);
+}
+
+double attitudeError(const Quaternion& a, const Quaternion& b) {
+    return norm(rotationVectorFromQuaternion(conjugate(a) * b));
+}
+
+struct ConingErrors {
+    double attitude, velocity, position;
+};
+
+// Cone com aceleração constante em um referencial inercial sem gravidade; incrementos por Simpson
+ConingErrors runConing(bool compensate) {
+    const double halfAngle = 0.1, omega = 2.0 * M_PI * 2.0, sampleRate = 100.0, duration = 10.0;
+    const Vec3 acceleration = vec3(1.0, -2.0, 3.0);
+    StrapdownOptions options;
+    options.coning = compensate;
+    options.sculling = compensate;
+    options.earthRotation = false;
+    options.gravity = false;
+    InsState initial;
+    initial.attitude = coningAttitude(0.0, halfAngle, omega);
+    StrapdownIns ins(initial, options);
+
+    const int subSteps = 32;
+    size_t numSamples = static_cast<size_t>(duration * sampleRate);
+    for (size_t k = 0; k < numSamples; ++k) {
+        double t0 = k / sampleRate, dt = 1.0 / sampleRate, h = dt / subSteps;
+        Vec3 angle{}, velocity{};
+        for (int j = 0; j <= subSteps; ++j) {
+            double t = t0 + j * h;
+            double weight = (j == 0 || j == subSteps) ? 1.0 : (j % 2 ? 4.0 : 2.0);
+            angle += (weight * h / 3.0) * bodyRate(t, halfAngle, omega);
+            velocity += (weight * h / 3.0) * rotate(conjugate(coningAttitude(t, halfAngle, omega)), acceleration);
+        }
+        ins.step(dt, angle, velocity);
+    }
+    const InsState& s = ins.state();
+    ConingErrors errors;
+    errors.attitude = attitudeError(s.attitude, coningAttitude(duration, halfAngle, omega));
+    errors.velocity = norm(s.velocity - duration * acceleration);
+    errors.position = norm(s.position - (0.5 * duration * duration) * acceleration);
+    return errors;
+}
+
+bool sameState(const InsState& a, const InsState& b) {
+    return a.time == b.time && std::memcmp(&a.position, &b.position, sizeof(Vec3)) == 0 &&
+           std::memcmp(&a.velocity, &b.velocity, sizeof(Vec3)) == 0 &&
+           std::memcmp(&a.attitude, &b.attitude, sizeof(Quaternion)) == 0;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+
+    // Conversões de ida e volta
+    InsState initial = insStateFromNed(100.0, -15.8, -47.9, 1100.0, 10.0, -20.0, 135.0, vec3(3.0, -4.0, 0.5));
+    double lat, lon, alt, roll, pitch, yaw;
+    nedPose(initial, lat, lon, alt, roll, pitch, yaw);
+    Vec3 velocityNed = nedVelocity(initial);
+    if (std::abs(lat + 15.8) > 1e-9 || std::abs(lon + 47.9) > 1e-9 || std::abs(alt - 1100.0) > 1e-6 ||
+        std::abs(roll - 10.0) > 1e-9 || std::abs(pitch + 20.0) > 1e-9 || std::abs(yaw - 135.0) > 1e-9 ||
+        norm(velocityNed - vec3(3.0, -4.0, 0.5)) > 1e-9) {
+        std::cerr << "NED round trip failed." << std::endl;
+        ok = false;
+    }
+
+    // IMU parado por 10 minutos: a navegação não deve sair do lugar
+    InsState rest = insStateFromNed(100.0, -15.8, -47.9, 1100.0, 2.0, -3.0, 30.0);
+    ImuData imu = staticImu(rest, static_cast<size_t>(600 * rate));
+    StrapdownIns ins(rest);
+    size_t count = ins.propagate(imu);
+    double positionDrift = norm(ins.state().position - rest.position);
+    double velocityDrift = norm(ins.state().velocity);
+    double attitudeDrift = attitudeError(ins.state().attitude, rest.attitude);
+    std::cout << "Static 600 s: position " << positionDrift << " m, velocity " << velocityDrift << " m/s, attitude "
+              << attitudeDrift << " rad" << std::endl;
+    if (count != imu.timeStamp.size() || positionDrift > 0.01 || velocityDrift > 1e-4 || attitudeDrift > 1e-9) {
+        std::cerr << "Static IMU drifted." << std::endl;
+        ok = false;
+    }
+
+    // Lotes sobrepostos dão exatamente o mesmo estado
+    StrapdownIns batched(rest);
+    size_t total = 0;
+    for (size_t first = 0; first < imu.timeStamp.size(); first += 5000) {
+        total += batched.propagate(imu, first >= 100 ? first - 100 : 0, first + 5000);
+    }
+    if (total != count || !sameState(batched.state(), ins.state())) {
+        std::cerr << "Batched propagation differs." << std::endl;
+        ok = false;
+    }
+
+    // Cone e sculling: a compensação reduz os erros de integração
+    ConingErrors plain = runConing(false);
+    ConingErrors compensated = runConing(true);
+    std::cout << "Coning at 100 Hz, 10 s: attitude " << plain.attitude << " -> " << compensated.attitude
+              << " rad, velocity " << plain.velocity << " -> " << compensated.velocity << " m/s, position "
+              << plain.position << " -> " << compensated.position << " m" << std::endl;
+    if (compensated.attitude > 0.05 * plain.attitude || compensated.velocity > 0.05 * plain.velocity ||
+        compensated.attitude > 1e-5 || compensated.velocity > 1e-3) {
+        std::cerr << "Coning/sculling compensation not effective." << std::endl;
+        ok = false;
+    }
+
+    // Vazão
+    StrapdownIns timed(rest);
+    auto start = std::chrono::steady_clock::now();
+    size_t timedCount = timed.propagate(imu);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Propagated " << timedCount << " samples at " << timedCount / seconds / 1e6 << " M samples/s"
+              << std::endl;
+
+    if (!ok) {
+        return 1;
+    }
+    std::cout << "Strapdown INS test passed." << std::endl;
+    return 0;
+}